@@ -0,0 +1,59 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_PATH
+
+# Heap allocation counts per ALLOC_SCOPE in the trackers, checked against
+# budgets and reported every update_interval. Loaded through AUTO_LOAD;
+# unless enabled, malloc is left alone and every scope compiles to nothing.
+
+AUTO_LOAD = ["web_server_base"]
+
+alloc_audit_ns = cg.esphome_ns.namespace("alloc_audit")
+AllocAudit = alloc_audit_ns.class_("AllocAudit", cg.PollingComponent)
+
+CONF_ENABLED = "enabled"
+CONF_BUDGETS = "budgets"
+
+# Most allocations one run of each scope may make, once warmed up:
+# - draw_schedule, draw_match: a steady frame allocates nothing.
+# - ws_message: a schedule update. The JSON document and message text, plus
+#   the route id, name and headsign of each trip when longer than 15
+#   characters (the std::string inline capacity), for a 64-trip window and a
+#   16-trip view.
+# - push_message: a score event; the JSON document and the team names.
+# - fetch_match_data: starting a fetch; request URLs, headers and the thread.
+# The fetch thread itself ("fetch") is reported without a budget.
+DEFAULT_BUDGETS = {
+    "draw_schedule": 0,
+    "draw_match": 0,
+    "ws_message": 256,
+    "push_message": 32,
+    "fetch_match_data": 64,
+}
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(AllocAudit),
+        cv.Optional(CONF_ENABLED, default=False): cv.boolean,
+        cv.Optional(CONF_PATH, default="/allocations.json"): cv.string,
+        # Overrides and additions to DEFAULT_BUDGETS, by scope name
+        cv.Optional(CONF_BUDGETS, default={}): cv.Schema({cv.string_strict: cv.uint32_t}),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    if not config[CONF_ENABLED]:
+        return
+
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_path(config[CONF_PATH]))
+    for scope, max_allocations in {**DEFAULT_BUDGETS, **config[CONF_BUDGETS]}.items():
+        cg.add(var.add_budget(scope, max_allocations))
+
+    for function in ("malloc", "calloc", "realloc"):
+        cg.add_build_flag(f"-Wl,--wrap={function}")
+
+    cg.add_define("USE_ALLOC_AUDIT")
@@ -0,0 +1,230 @@
+#include "alloc_audit.h"
+
+#ifdef USE_ALLOC_AUDIT
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/components/web_server_base/web_server_base.h"
+
+namespace esphome {
+namespace alloc_audit {
+
+static const char *TAG = "alloc_audit";
+
+AllocAudit *global_alloc_audit = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+// The innermost scope of each task
+static thread_local AllocScope *current_scope = nullptr;
+
+AllocScope::AllocScope(const char *name) : name_(name), parent_(current_scope) { current_scope = this; }
+
+AllocScope::~AllocScope() {
+  current_scope = this->parent_;
+  if (this->parent_ != nullptr) {
+    this->parent_->allocations_ += this->allocations_;
+    this->parent_->bytes_ += this->bytes_;
+  }
+
+  AllocAudit *audit = global_alloc_audit;
+  if (audit != nullptr) {
+    audit->record(this->name_, this->allocations_, this->bytes_);
+  }
+}
+
+void count_allocation(size_t size) {
+  AllocScope *scope = current_scope;
+  if (scope != nullptr) {
+    scope->count(size);
+  }
+}
+
+static void update_max(std::atomic<uint32_t> &max, uint32_t value) {
+  uint32_t current = max.load(std::memory_order_relaxed);
+  while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+AllocAudit::AllocAudit() { global_alloc_audit = this; }
+
+void AllocAudit::setup() {
+  if (web_server_base::global_web_server_base == nullptr) {
+    return;
+  }
+  auto server = web_server_base::global_web_server_base->get_server();
+  if (server == nullptr) {
+    return;
+  }
+
+  // GET <path>
+  class Handler : public AsyncWebHandler {
+   public:
+    explicit Handler(AllocAudit *audit) : audit_(audit) {}
+    bool canHandle(AsyncWebServerRequest *request) const override { return request->url() == audit_->path_; }
+    void handleRequest(AsyncWebServerRequest *request) override {
+      auto *res = request->beginResponse(200, "application/json", audit_->to_json());
+      request->send(res);
+    }
+    AllocAudit *audit_;
+  };
+  server->addHandler(new Handler(this));  // NOLINT
+}
+
+void AllocAudit::dump_config() {
+  ESP_LOGCONFIG(TAG, "Allocation Audit:");
+  ESP_LOGCONFIG(TAG, "  Path: %s", this->path_.c_str());
+  uint8_t count = this->scope_count_.load();
+  for (uint8_t i = 0; i < count; i++) {
+    const Scope &scope = this->scopes_[i];
+    if (scope.budget != NO_BUDGET) {
+      ESP_LOGCONFIG(TAG, "  Budget for %s: %" PRIu32 " allocations", scope.name, scope.budget);
+    }
+  }
+  LOG_UPDATE_INTERVAL(this);
+}
+
+void AllocAudit::add_budget(const char *scope, uint32_t max_allocations) {
+  std::lock_guard<std::mutex> lock(this->scopes_mutex_);
+  uint8_t count = this->scope_count_.load();
+  if (count == MAX_SCOPES) {
+    return;
+  }
+  Scope &entry = this->scopes_[count];
+  entry.name = scope;
+  entry.budget = max_allocations;
+  this->scope_count_.store(count + 1);
+}
+
+AllocAudit::Scope *AllocAudit::find_(const char *name) {
+  uint8_t count = this->scope_count_.load(std::memory_order_acquire);
+  for (uint8_t i = 0; i < count; i++) {
+    if (this->scopes_[i].name == name || strcmp(this->scopes_[i].name, name) == 0) {
+      return &this->scopes_[i];
+    }
+  }
+
+  // A scope without a budget, ending for the first time
+  std::lock_guard<std::mutex> lock(this->scopes_mutex_);
+  count = this->scope_count_.load(std::memory_order_relaxed);
+  for (uint8_t i = 0; i < count; i++) {
+    if (strcmp(this->scopes_[i].name, name) == 0) {
+      return &this->scopes_[i];
+    }
+  }
+  if (count == MAX_SCOPES) {
+    return nullptr;
+  }
+  Scope &scope = this->scopes_[count];
+  scope.name = name;
+  scope.budget = NO_BUDGET;
+  this->scope_count_.store(count + 1, std::memory_order_release);
+  return &scope;
+}
+
+void AllocAudit::record(const char *scope, uint32_t allocations, uint32_t bytes) {
+  Scope *entry = this->find_(scope);
+  if (entry == nullptr) {
+    return;
+  }
+
+  uint32_t run = entry->runs.fetch_add(1, std::memory_order_relaxed) + 1;
+  entry->allocations.fetch_add(allocations, std::memory_order_relaxed);
+  entry->bytes.fetch_add(bytes, std::memory_order_relaxed);
+  update_max(entry->max_allocations, allocations);
+
+  entry->window_runs.fetch_add(1, std::memory_order_relaxed);
+  entry->window_allocations.fetch_add(allocations, std::memory_order_relaxed);
+  update_max(entry->window_max, allocations);
+
+  if (run > WARMUP_RUNS && allocations > entry->budget) {
+    entry->over_budget.fetch_add(1, std::memory_order_relaxed);
+    entry->window_over_budget.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void AllocAudit::update() {
+  bool over_budget = false;
+  uint8_t count = this->scope_count_.load();
+  for (uint8_t i = 0; i < count; i++) {
+    Scope &scope = this->scopes_[i];
+    uint32_t runs = scope.window_runs.exchange(0);
+    uint32_t allocations = scope.window_allocations.exchange(0);
+    uint32_t max = scope.window_max.exchange(0);
+    uint32_t over = scope.window_over_budget.exchange(0);
+    if (runs == 0) {
+      continue;
+    }
+
+    ESP_LOGD(TAG, "%s: %" PRIu32 " runs, %.1f allocations per run (max %" PRIu32 ")", scope.name, runs,
+             (float) allocations / runs, max);
+    if (over > 0) {
+      ESP_LOGW(TAG, "%s went over its budget of %" PRIu32 " allocations in %" PRIu32 " of %" PRIu32 " runs",
+               scope.name, scope.budget, over, runs);
+      over_budget = true;
+    }
+  }
+
+  if (over_budget) {
+    this->status_set_warning();
+  } else {
+    this->status_clear_warning();
+  }
+}
+
+std::string AllocAudit::to_json() {
+  std::string out;
+  uint8_t count = this->scope_count_.load();
+  out.reserve(64 + count * 160);
+
+  char line[192];
+  snprintf(line, sizeof(line), "{\"uptime\":%" PRIu32 ",\"warmupRuns\":%" PRIu32 ",\"scopes\":[", millis(),
+           WARMUP_RUNS);
+  out += line;
+  for (uint8_t i = 0; i < count; i++) {
+    const Scope &scope = this->scopes_[i];
+    char budget[12] = "null";
+    if (scope.budget != NO_BUDGET) {
+      snprintf(budget, sizeof(budget), "%" PRIu32, scope.budget);
+    }
+    snprintf(line, sizeof(line),
+             "%s\n{\"name\":\"%s\",\"budget\":%s,\"runs\":%" PRIu32 ",\"allocations\":%" PRIu32 ",\"bytes\":%" PRIu32
+             ",\"max\":%" PRIu32 ",\"overBudget\":%" PRIu32 "}",
+             i > 0 ? "," : "", scope.name, budget, scope.runs.load(), scope.allocations.load(), scope.bytes.load(),
+             scope.max_allocations.load(), scope.over_budget.load());
+    out += line;
+  }
+  out += "\n]}\n";
+  return out;
+}
+
+}  // namespace alloc_audit
+}  // namespace esphome
+
+// The linker sends every malloc, calloc and realloc through these
+// (-Wl,--wrap=...); operator new and std::string allocate through malloc.
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  esphome::alloc_audit::count_allocation(size);
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  esphome::alloc_audit::count_allocation(count * size);
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  esphome::alloc_audit::count_allocation(size);
+  return __real_realloc(ptr, size);
+}
+}
+
+#endif  // USE_ALLOC_AUDIT
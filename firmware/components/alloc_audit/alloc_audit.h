@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "esphome/core/component.h"
+
+#include "alloc_scope.h"
+
+namespace esphome {
+namespace alloc_audit {
+
+// Counts heap allocations per ALLOC_SCOPE, checks each run of a scope against
+// its budget, and reports the counts every update_interval, in the log and as
+// JSON from the web server. Fragmentation builds up over weeks, so a frame
+// that starts allocating should show up on the first report, not the first
+// crash.
+class AllocAudit : public PollingComponent {
+  public:
+    static constexpr uint32_t NO_BUDGET = UINT32_MAX;
+    static constexpr size_t MAX_SCOPES = 16;
+    // Runs of a scope before its budget applies, since the first frames
+    // allocate buffers that are kept from then on
+    static constexpr uint32_t WARMUP_RUNS = 3;
+
+    AllocAudit();
+
+    void setup() override;
+    void update() override;
+    void dump_config() override;
+
+    float get_setup_priority() const override { return setup_priority::WIFI - 1.0f; }
+
+    void set_path(const std::string &path) { path_ = path; }
+    // Most allocations one run of scope may make; scope must be a string literal
+    void add_budget(const char *scope, uint32_t max_allocations);
+
+    // Called as a scope ends, from whichever task ran it
+    void record(const char *scope, uint32_t allocations, uint32_t bytes);
+    std::string to_json();
+
+  protected:
+    struct Scope {
+      const char *name;
+      uint32_t budget;
+      std::atomic<uint32_t> runs{0};
+      std::atomic<uint32_t> allocations{0};
+      std::atomic<uint32_t> bytes{0};
+      std::atomic<uint32_t> max_allocations{0};
+      std::atomic<uint32_t> over_budget{0};
+      // Since the last report
+      std::atomic<uint32_t> window_runs{0};
+      std::atomic<uint32_t> window_allocations{0};
+      std::atomic<uint32_t> window_max{0};
+      std::atomic<uint32_t> window_over_budget{0};
+    };
+
+    Scope *find_(const char *name);
+
+    std::string path_ = "/allocations.json";
+
+    Scope scopes_[MAX_SCOPES];
+    std::atomic<uint8_t> scope_count_{0};
+    std::mutex scopes_mutex_;  // Only taken the first time a scope ends
+};
+
+extern AllocAudit *global_alloc_audit;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace alloc_audit
+}  // namespace esphome
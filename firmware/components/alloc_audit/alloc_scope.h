@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+
+// Allocation scopes for the alloc_audit component. Without `enabled: true` in
+// its config they expand to nothing, so they can stay in hot paths.
+//
+// Every malloc, calloc, realloc and operator new the current task makes
+// between a scope's start and the closing brace is counted against it, and
+// checked against the scope's budget when it ends. Nested scopes count
+// towards their parents too, so a scope inside a budgeted one narrows down
+// where its allocations come from.
+//
+// Names must be string literals: only the pointer is kept.
+//
+//   ALLOC_SCOPE("draw_schedule");
+
+namespace esphome {
+namespace alloc_audit {
+
+#ifdef USE_ALLOC_AUDIT
+class AllocScope {
+  public:
+    explicit AllocScope(const char *name);
+    ~AllocScope();
+
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+    void count(size_t size) {
+      this->allocations_++;
+      this->bytes_ += size;
+    }
+
+  protected:
+    const char *name_;
+    AllocScope *parent_;
+    uint32_t allocations_ = 0;
+    uint32_t bytes_ = 0;
+};
+
+// Counts an allocation against the current task's scope. The malloc family is
+// counted by the linker wraps; allocators that go to heap_caps_malloc()
+// directly (memory_placement) call this themselves.
+void count_allocation(size_t size);
+#endif
+
+}  // namespace alloc_audit
+}  // namespace esphome
+
+#ifdef USE_ALLOC_AUDIT
+#define ALLOC_CONCAT_(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_(a, b)
+#define ALLOC_SCOPE(name) ::esphome::alloc_audit::AllocScope ALLOC_CONCAT(alloc_scope_, __LINE__)(name)
+#else
+#define ALLOC_SCOPE(name) \
+  do { \
+  } while (0)
+#endif
@@ -0,0 +1,54 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_TIMEOUT
+
+# Network policy shared by the trackers: readiness, retry backoff, one TLS
+# handshake at a time, kept-alive HTTP connections, resumed TLS sessions and
+# the clock set from the servers' until the time source syncs, host names
+# resolved ahead of their connections and a timeline of the boot.
+# Loaded through AUTO_LOAD, so every option is optional.
+
+DEPENDENCIES = ["network", "time"]
+# transit_tracker loads this without an http_request: block of its own; the
+# pool only borrows http_request's HttpContainer types
+AUTO_LOAD = ["http_request", "watchdog", "web_server_base"]
+
+connection_manager_ns = cg.esphome_ns.namespace("connection_manager")
+ConnectionManager = connection_manager_ns.class_("ConnectionManager", cg.Component)
+
+CONF_CONNECTION_MANAGER_ID = "connection_manager_id"
+CONF_INITIAL_RETRY_INTERVAL = "initial_retry_interval"
+CONF_MAX_RETRY_INTERVAL = "max_retry_interval"
+CONF_KEEP_ALIVE = "keep_alive"
+CONF_MAX_CONNECTIONS = "max_connections"
+CONF_PERSIST_SESSIONS = "persist_sessions"
+CONF_BOOT_PATH = "boot_path"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ConnectionManager),
+        cv.Optional(CONF_INITIAL_RETRY_INTERVAL, default="5s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_RETRY_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_KEEP_ALIVE, default="60s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_CONNECTIONS, default=2): cv.int_range(min=1, max=4),
+        cv.Optional(CONF_TIMEOUT, default="10s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_PERSIST_SESSIONS, default=False): cv.boolean,
+        # The boot timeline as JSON, on the web server
+        cv.Optional(CONF_BOOT_PATH, default="/boot.json"): cv.string,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_initial_retry_interval(config[CONF_INITIAL_RETRY_INTERVAL]))
+    cg.add(var.set_max_retry_interval(config[CONF_MAX_RETRY_INTERVAL]))
+    cg.add(var.set_keep_alive(config[CONF_KEEP_ALIVE]))
+    cg.add(var.set_max_connections(config[CONF_MAX_CONNECTIONS]))
+    cg.add(var.set_request_timeout(config[CONF_TIMEOUT]))
+    cg.add(var.set_persist_sessions(config[CONF_PERSIST_SESSIONS]))
+    cg.add(var.set_boot_path(config[CONF_BOOT_PATH]))
+
+    cg.add_library("HTTPClient", None)
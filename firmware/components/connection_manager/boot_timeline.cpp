@@ -0,0 +1,96 @@
+#include "boot_timeline.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace connection_manager {
+
+static const char *TAG = "connection_manager.boot";
+
+const char *BootTimeline::stage_name(BootStage stage) {
+  switch (stage) {
+    case BOOT_WIFI_ASSOCIATED:
+      return "wifi";
+    case BOOT_DHCP:
+      return "dhcp";
+    case BOOT_DNS:
+      return "dns";
+    case BOOT_NETWORK_READY:
+      return "network_ready";
+    case BOOT_SERVER_CLOCK:
+      return "server_clock";
+    case BOOT_SNTP:
+      return "sntp";
+    case BOOT_CONNECTED:
+      return "connected";
+    case BOOT_SUBSCRIBED:
+      return "subscribed";
+    case BOOT_FIRST_DATA:
+      return "first_data";
+    case BOOT_FIRST_CONTENT:
+      return "first_content";
+    default:
+      return "unknown";
+  }
+}
+
+bool BootTimeline::mark(BootStage stage) {
+  if (this->has(stage)) {
+    return false;
+  }
+  // Never 0, which means unset
+  uint32_t expected = 0;
+  if (!this->at_[stage].compare_exchange_strong(expected, std::max<uint32_t>(millis(), 1))) {
+    return false;
+  }
+  ESP_LOGD(TAG, "Boot stage %s at %ums", stage_name(stage), (unsigned) this->get(stage));
+  if (stage == BOOT_FIRST_CONTENT) {
+    this->log();
+  }
+  return true;
+}
+
+std::string BootTimeline::to_json() const {
+  std::string out;
+  out.reserve(256);
+  char field[48];
+  snprintf(field, sizeof(field), "{\"uptime\":%" PRIu32 ",\"stages\":{", millis());
+  out += field;
+  for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+    auto stage = static_cast<BootStage>(i);
+    uint32_t at = this->get(stage);
+    if (at == 0) {
+      snprintf(field, sizeof(field), "%s\"%s\":null", i == 0 ? "" : ",", stage_name(stage));
+    } else {
+      snprintf(field, sizeof(field), "%s\"%s\":%" PRIu32, i == 0 ? "" : ",", stage_name(stage), at);
+    }
+    out += field;
+  }
+  out += "}}";
+  return out;
+}
+
+void BootTimeline::log() const {
+  char line[256];
+  size_t length = 0;
+  for (int i = 0; i < BOOT_STAGE_COUNT && length < sizeof(line); i++) {
+    auto stage = static_cast<BootStage>(i);
+    if (this->has(stage)) {
+      length += snprintf(line + length, sizeof(line) - length, "%s%s %ums", length == 0 ? "" : ", ",
+                         stage_name(stage), (unsigned) this->get(stage));
+    }
+  }
+  ESP_LOGI(TAG, "Boot: %s", length == 0 ? "no stages yet" : line);
+  if (this->has(BOOT_DHCP) && this->has(BOOT_FIRST_CONTENT)) {
+    ESP_LOGI(TAG, "First content %ums after the network came up",
+             (unsigned) (this->get(BOOT_FIRST_CONTENT) - this->get(BOOT_DHCP)));
+  }
+}
+
+}  // namespace connection_manager
+}  // namespace esphome
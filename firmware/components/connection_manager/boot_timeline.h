@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace connection_manager {
+
+// The steps between power-on and the first real content on the panel, in the
+// order they usually happen. Stages that don't apply to a device (no push
+// channel, a clock SNTP set first) stay unset.
+enum BootStage : uint8_t {
+  BOOT_WIFI_ASSOCIATED,  // Associated with the access point
+  BOOT_DHCP,             // Got an address
+  BOOT_DNS,              // The servers' host names resolved ahead of their connections
+  BOOT_NETWORK_READY,    // Connections may be attempted (see ConnectionManager::is_network_ready())
+  BOOT_SERVER_CLOCK,     // The clock set from a server's, see ServerClock
+  BOOT_SNTP,             // The time source synced
+  BOOT_CONNECTED,        // First server connection up, TLS handshake included
+  BOOT_SUBSCRIBED,       // Schedule subscription sent
+  BOOT_FIRST_DATA,       // First schedule message or fixture response parsed
+  BOOT_FIRST_CONTENT,    // First departures or match drawn
+  BOOT_STAGE_COUNT,
+};
+
+// millis() at the first time each boot stage was reached. Safe from any
+// task; marking a stage again is a single atomic load, so it can sit in a
+// draw path. The first content logs the whole timeline.
+class BootTimeline {
+  public:
+    static const char *stage_name(BootStage stage);
+
+    // Records the stage unless it was already; true if this was the first time
+    bool mark(BootStage stage);
+    bool has(BootStage stage) const { return this->at_[stage].load(std::memory_order_relaxed) != 0; }
+    // millis() when the stage was reached, 0 if it hasn't been
+    uint32_t get(BootStage stage) const { return this->at_[stage].load(std::memory_order_relaxed); }
+
+    // {"uptime":..,"stages":{"wifi":812,..,"first_content":null}}, in ms since boot
+    std::string to_json() const;
+    void log() const;
+
+  protected:
+    std::atomic<uint32_t> at_[BOOT_STAGE_COUNT]{};
+};
+
+}  // namespace connection_manager
+}  // namespace esphome
@@ -0,0 +1,501 @@
+#include "connection_manager.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <lwip/netdb.h>
+
+#ifdef USE_ESP32
+#include <esp_pthread.h>
+#include <esp_wifi.h>
+#endif
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/components/network/util.h"
+#include "esphome/components/watchdog/watchdog.h"
+#include "esphome/components/web_server_base/web_server_base.h"
+
+namespace esphome {
+namespace connection_manager {
+
+static const char *TAG = "connection_manager";
+
+uint32_t Backoff::next_delay() {
+  this->attempts_++;
+  uint32_t delay = this->initial_interval_;
+  for (int i = 1; i < this->attempts_ && delay < this->max_interval_; i++) {
+    delay *= 2;
+  }
+  delay = std::min(delay, this->max_interval_);
+  // Up to a quarter off
+  return delay - random_uint32() % (delay / 4 + 1);
+}
+
+int PooledResponse::read(uint8_t *buf, size_t max_len) {
+  WiFiClient *stream = this->http_->getStreamPtr();
+  if (stream == nullptr) {
+    return -1;
+  }
+  if (this->content_length != SIZE_MAX) {
+    max_len = std::min(max_len, this->content_length - this->received_);
+    if (max_len == 0) {
+      return -1;
+    }
+  }
+
+  int available = stream->available();
+  if (available <= 0) {
+    // Nothing yet; the caller decides how long to wait
+    return stream->connected() ? 0 : -1;
+  }
+  int read_len = stream->readBytes(buf, std::min<size_t>(max_len, available));
+  if (read_len > 0) {
+    this->received_ += read_len;
+  }
+  return read_len;
+}
+
+void PooledResponse::end() {
+  if (this->manager_ == nullptr) {
+    return;
+  }
+
+  // The next request can only follow a response that was read to its end
+  WiFiClient *stream = this->http_->getStreamPtr();
+  bool complete = this->content_length == SIZE_MAX ? stream == nullptr || stream->available() == 0
+                                                   : this->received_ == this->content_length;
+  // With reuse on, this leaves the socket open unless the server asked to close it
+  this->http_->end();
+  this->manager_->release_(this->slot_, complete);
+  this->manager_ = nullptr;
+}
+
+void ConnectionManager::setup() {
+  this->pool_.resize(this->max_connections_);
+  this->tls_sessions_.restore();
+  this->server_clock_.setup(&this->boot_timeline_);
+}
+
+void ConnectionManager::loop() {
+#ifdef USE_ESP32
+  if (!this->boot_timeline_.has(BOOT_WIFI_ASSOCIATED)) {
+    wifi_ap_record_t ap;
+    if (esp_wifi_sta_get_ap_info(&ap) == ESP_OK) {
+      this->boot_timeline_.mark(BOOT_WIFI_ASSOCIATED);
+    }
+  }
+#endif
+
+  if (!network::is_connected()) {
+    if (this->connected_since_ != 0) {
+      ESP_LOGD(TAG, "Network down");
+      this->connected_since_ = 0;
+      this->dns_ready_ = false;
+    }
+  } else if (this->connected_since_ == 0) {
+    this->connected_since_ = std::max<uint32_t>(millis(), 1);
+    // Association and address in the same pass, or no way to tell them apart
+    this->boot_timeline_.mark(BOOT_WIFI_ASSOCIATED);
+    this->boot_timeline_.mark(BOOT_DHCP);
+    // The names are resolved again, once a lookup still under way has handed them back
+    std::lock_guard<std::mutex> lock(this->prefetch_mutex_);
+    this->prefetch_pending_ = true;
+  }
+
+  // Lookups block, so they run on a thread of their own while SNTP, the
+  // display and everything else carry on
+  if (this->prefetch_complete_) {
+    this->prefetch_thread_.join();
+    this->prefetch_complete_ = false;
+  }
+  if (this->connected_since_ != 0 && !this->prefetch_thread_.joinable()) {
+    std::vector<std::string> hosts;
+    {
+      std::lock_guard<std::mutex> lock(this->prefetch_mutex_);
+      if (this->prefetch_pending_) {
+        // The thread hands the names back when it is done
+        hosts.swap(this->prefetch_hosts_);
+        this->prefetch_pending_ = false;
+      }
+    }
+    if (!hosts.empty()) {
+#ifdef USE_ESP32
+      esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+      cfg.thread_name = "dns_prefetch";
+      cfg.stack_size = PREFETCH_STACK_SIZE;
+      esp_pthread_set_cfg(&cfg);
+#endif
+      this->prefetch_thread_ = std::thread(&ConnectionManager::prefetch_task_, this, std::move(hosts));
+    }
+  }
+
+  bool ready = this->is_network_ready();
+  if (ready != this->network_ready_) {
+    this->network_ready_ = ready;
+    if (ready) {
+      this->boot_timeline_.mark(BOOT_NETWORK_READY);
+      if (!this->boot_handler_registered_) {
+        // The web server is only up once wifi is
+        this->register_boot_handler_();
+      }
+      this->network_ready_callback_.call();
+    }
+  }
+
+#ifdef USE_SENSOR
+  // Handshakes happen on other threads; their times are published from here
+  auto full = this->tls_sessions_.get_full_stats();
+  if (this->full_handshake_time_sensor_ != nullptr && full.count != this->published_full_handshakes_) {
+    this->published_full_handshakes_ = full.count;
+    this->full_handshake_time_sensor_->publish_state(full.average_ms());
+  }
+  auto resumed = this->tls_sessions_.get_resumed_stats();
+  if (this->resumed_handshake_time_sensor_ != nullptr && resumed.count != this->published_resumed_handshakes_) {
+    this->published_resumed_handshakes_ = resumed.count;
+    this->resumed_handshake_time_sensor_->publish_state(resumed.average_ms());
+  }
+#endif
+
+  // Idle connections hold on to their TLS buffers, so they only stay open for
+  // keep_alive. A fetch thread holding the pool is left alone until next time.
+  std::unique_lock<std::mutex> lock(this->pool_mutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return;
+  }
+  uint32_t now = millis();
+  for (auto &connection : this->pool_) {
+    if (connection.client == nullptr || connection.in_use) {
+      continue;
+    }
+    if (this->connected_since_ == 0 || now - connection.last_used > this->keep_alive_ ||
+        !connection.client->connected()) {
+      ESP_LOGV(TAG, "Closing idle connection to %s", connection.host.c_str());
+      close_(connection);
+    }
+  }
+}
+
+void ConnectionManager::dump_config() {
+  ESP_LOGCONFIG(TAG, "Connection Manager:");
+  ESP_LOGCONFIG(TAG, "  Retry interval: %us, backing off to %us", this->initial_retry_interval_ / 1000,
+                this->max_retry_interval_ / 1000);
+  ESP_LOGCONFIG(TAG, "  Keep-alive: %us, up to %u connections", this->keep_alive_ / 1000,
+                (unsigned) this->max_connections_);
+  ESP_LOGCONFIG(TAG, "  Request timeout: %ums", this->request_timeout_);
+  ESP_LOGCONFIG(TAG, "  TLS sessions: %u cached%s", (unsigned) this->tls_sessions_.size(),
+                this->tls_sessions_.get_persist() ? ", kept across reboots" : "");
+  auto full = this->tls_sessions_.get_full_stats();
+  auto resumed = this->tls_sessions_.get_resumed_stats();
+  ESP_LOGCONFIG(TAG, "  Full handshakes: %u, %ums on average, %ums at most", (unsigned) full.count,
+                (unsigned) full.average_ms(), (unsigned) full.max_ms);
+  ESP_LOGCONFIG(TAG, "  Resumed handshakes: %u, %ums on average, %ums at most", (unsigned) resumed.count,
+                (unsigned) resumed.average_ms(), (unsigned) resumed.max_ms);
+  {
+    std::lock_guard<std::mutex> lock(this->prefetch_mutex_);
+    ESP_LOGCONFIG(TAG, "  Prefetched hosts: %u", (unsigned) this->prefetch_hosts_.size());
+  }
+  ESP_LOGCONFIG(TAG, "  Boot timeline: %s", this->boot_path_.c_str());
+  this->boot_timeline_.log();
+  ESP_LOGCONFIG(TAG, "  Clock: %s, set from servers %u times",
+                this->server_clock_.is_synced()        ? "synced"
+                : this->server_clock_.is_provisional() ? "provisional"
+                                                       : "not set",
+                (unsigned) this->server_clock_.get_adjustments());
+#ifdef USE_SENSOR
+  LOG_SENSOR("  ", "Full Handshake Time", this->full_handshake_time_sensor_);
+  LOG_SENSOR("  ", "Resumed Handshake Time", this->resumed_handshake_time_sensor_);
+#endif
+}
+
+bool ConnectionManager::is_network_ready() const {
+  uint32_t since = this->connected_since_;
+  return since != 0 && network::is_connected() && (this->dns_ready_ || millis() - since >= NETWORK_SETTLE_TIME);
+}
+
+void ConnectionManager::prefetch(const std::string &url) {
+  Endpoint endpoint;
+  if (!parse_url(url, endpoint)) {
+    return;
+  }
+  // Addresses need no lookup, and resolving one proves nothing about DNS
+  if (std::all_of(endpoint.host.begin(), endpoint.host.end(), [](char c) { return isdigit(c) || c == '.'; })) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->prefetch_mutex_);
+  if (std::find(this->prefetch_hosts_.begin(), this->prefetch_hosts_.end(), endpoint.host) !=
+      this->prefetch_hosts_.end()) {
+    return;
+  }
+  this->prefetch_hosts_.push_back(endpoint.host);
+  this->prefetch_pending_ = true;
+}
+
+void ConnectionManager::prefetch_task_(std::vector<std::string> hosts) {
+  // The answers land in lwIP's DNS cache, where the connections find them
+  bool resolved = false;
+  for (const auto &host : hosts) {
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *address = nullptr;
+    uint32_t started = millis();
+    if (lwip_getaddrinfo(host.c_str(), nullptr, &hints, &address) == 0 && address != nullptr) {
+      ESP_LOGD(TAG, "Resolved %s in %ums", host.c_str(), (unsigned) (millis() - started));
+      resolved = true;
+    } else {
+      ESP_LOGW(TAG, "Could not resolve %s", host.c_str());
+    }
+    if (address != nullptr) {
+      lwip_freeaddrinfo(address);
+    }
+  }
+
+  {
+    // Back for the next time the network comes up; names added meanwhile are already pending
+    std::lock_guard<std::mutex> lock(this->prefetch_mutex_);
+    for (auto &host : hosts) {
+      if (std::find(this->prefetch_hosts_.begin(), this->prefetch_hosts_.end(), host) ==
+          this->prefetch_hosts_.end()) {
+        this->prefetch_hosts_.push_back(std::move(host));
+      }
+    }
+  }
+
+  if (resolved) {
+    this->dns_ready_ = true;
+    this->boot_timeline_.mark(BOOT_DNS);
+  }
+  // Hands the thread back to loop() to be joined
+  this->prefetch_complete_ = true;
+}
+
+void ConnectionManager::register_boot_handler_() {
+  if (web_server_base::global_web_server_base == nullptr) {
+    return;
+  }
+  auto server = web_server_base::global_web_server_base->get_server();
+  if (server == nullptr) {
+    return;
+  }
+
+  class Handler : public AsyncWebHandler {
+   public:
+    explicit Handler(ConnectionManager *manager) : manager_(manager) {}
+    bool canHandle(AsyncWebServerRequest *request) const override { return request->url() == manager_->boot_path_; }
+    void handleRequest(AsyncWebServerRequest *request) override {
+      auto *res = request->beginResponse(200, "application/json", manager_->boot_timeline_.to_json());
+      request->send(res);
+    }
+    ConnectionManager *manager_;
+  };
+  server->addHandler(new Handler(this));  // NOLINT
+  this->boot_handler_registered_ = true;
+}
+
+bool ConnectionManager::parse_url(const std::string &url, Endpoint &out) {
+  // scheme://host[:port][/path]
+  static const struct {
+    const char *prefix;
+    bool secure;
+    uint16_t port;
+  } SCHEMES[] = {{"http://", false, 80}, {"https://", true, 443}, {"ws://", false, 80}, {"wss://", true, 443}};
+
+  size_t host_start = std::string::npos;
+  for (const auto &scheme : SCHEMES) {
+    if (url.rfind(scheme.prefix, 0) == 0) {
+      host_start = strlen(scheme.prefix);
+      out.secure = scheme.secure;
+      out.port = scheme.port;
+      break;
+    }
+  }
+  if (host_start == std::string::npos) {
+    return false;
+  }
+
+  size_t host_end = url.find_first_of(":/?", host_start);
+  out.host = url.substr(host_start, host_end - host_start);
+  if (host_end != std::string::npos && url[host_end] == ':') {
+    out.port = atoi(url.c_str() + host_end + 1);
+  }
+  size_t path_start = url.find_first_of("/?", host_start);
+  out.path = path_start == std::string::npos ? "/" : url.substr(path_start);
+  if (out.path[0] == '?') {
+    out.path.insert(0, "/");
+  }
+  return !out.host.empty();
+}
+
+std::shared_ptr<http_request::HttpContainer> ConnectionManager::get(const std::string &url,
+                                                                    const std::list<http_request::Header> &headers,
+                                                                    const std::set<std::string> &collect_headers) {
+  Endpoint endpoint;
+  if (!parse_url(url, endpoint) || url.rfind("http", 0) != 0) {
+    ESP_LOGE(TAG, "Unsupported URL: %s", url.c_str());
+    return nullptr;
+  }
+  const std::string &host = endpoint.host;
+
+  if (!this->is_network_ready()) {
+    ESP_LOGW(TAG, "Network not ready, not requesting %s", url.c_str());
+    return nullptr;
+  }
+
+  size_t slot = this->checkout_(host, endpoint.port, endpoint.secure);
+  if (slot == SIZE_MAX) {
+    ESP_LOGW(TAG, "All %u connections are in use", (unsigned) this->pool_.size());
+    return nullptr;
+  }
+  Connection &connection = this->pool_[slot];
+
+  // Waiting for the handshake slot and the handshake itself can take a while
+  watchdog::WatchdogManager wdm(20000);
+
+  // Every response's Date header is a reading of the server's clock
+  static const char *const DATE = "date";
+  std::vector<const char *> header_keys{DATE};
+  for (const auto &name : collect_headers) {
+    header_keys.push_back(name.c_str());
+  }
+
+  HTTPClient &http = *connection.http;
+
+  // A kept-alive connection the server has since closed fails on first use;
+  // it is then opened afresh, once
+  for (int attempt = 0; attempt < 2; attempt++) {
+    bool reused = connection.client->connected();
+    if (!reused && !this->open_(connection)) {
+      break;
+    }
+
+    if (!http.begin(*connection.client, url.c_str())) {
+      ESP_LOGW(TAG, "Could not start request to %s", url.c_str());
+      break;
+    }
+    for (const auto &header : headers) {
+      http.addHeader(header.name.c_str(), header.value.c_str());
+    }
+    http.collectHeaders(header_keys.data(), header_keys.size());
+
+    int status = http.GET();
+    if (status < 0) {
+      http.end();
+      connection.client->stop();
+      if (reused) {
+        ESP_LOGD(TAG, "Kept-alive connection to %s was closed, reconnecting", host.c_str());
+        continue;
+      }
+      ESP_LOGW(TAG, "Request to %s failed: %s", host.c_str(), HTTPClient::errorToString(status).c_str());
+      break;
+    }
+
+    if (reused) {
+      this->reuses_++;
+    }
+    auto response = std::make_shared<PooledResponse>();
+    response->manager_ = this;
+    response->slot_ = slot;
+    response->http_ = &http;
+    response->status_code = status;
+    int size = http.getSize();
+    response->content_length = size < 0 ? SIZE_MAX : size;
+    if (!this->server_clock_.is_synced()) {
+      this->server_clock_.offer_http_date(http.header(DATE).c_str(), "an HTTP Date header");
+    }
+    for (const auto &name : collect_headers) {
+      String value = http.header(name.c_str());
+      if (value.length() > 0) {
+        response->response_headers_[name].push_back(value.c_str());
+      }
+    }
+    return response;
+  }
+
+  this->release_(slot, false);
+  return nullptr;
+}
+
+size_t ConnectionManager::checkout_(const std::string &host, uint16_t port, bool secure) {
+  std::lock_guard<std::mutex> lock(this->pool_mutex_);
+
+  size_t candidate = SIZE_MAX;
+  for (size_t i = 0; i < this->pool_.size(); i++) {
+    Connection &connection = this->pool_[i];
+    if (connection.in_use) {
+      continue;
+    }
+    if (connection.client != nullptr && connection.host == host && connection.port == port &&
+        connection.secure == secure && connection.client->connected()) {
+      connection.in_use = true;
+      return i;
+    }
+    if (candidate == SIZE_MAX || (this->pool_[candidate].client != nullptr &&
+                                  (connection.client == nullptr ||
+                                   connection.last_used < this->pool_[candidate].last_used))) {
+      candidate = i;
+    }
+  }
+  if (candidate == SIZE_MAX) {
+    return SIZE_MAX;
+  }
+
+  Connection &connection = this->pool_[candidate];
+  close_(connection);
+  if (secure) {
+    auto *client = new TlsClient();  // NOLINT
+    client->set_session_cache(&this->tls_sessions_);
+    connection.client.reset(client);
+  } else {
+    connection.client.reset(new WiFiClient());  // NOLINT
+  }
+  connection.http.reset(new HTTPClient());  // NOLINT
+  connection.http->setReuse(true);
+  connection.http->setTimeout(this->request_timeout_);
+  connection.host = host;
+  connection.port = port;
+  connection.secure = secure;
+  connection.in_use = true;
+  return candidate;
+}
+
+void ConnectionManager::release_(size_t slot, bool reusable) {
+  std::lock_guard<std::mutex> lock(this->pool_mutex_);
+  Connection &connection = this->pool_[slot];
+  if (!reusable || this->keep_alive_ == 0) {
+    connection.client->stop();
+  }
+  connection.in_use = false;
+  connection.last_used = millis();
+}
+
+void ConnectionManager::close_(Connection &connection) {
+  connection.http.reset();
+  if (connection.client != nullptr) {
+    connection.client->stop();
+    connection.client.reset();
+  }
+}
+
+bool ConnectionManager::open_(Connection &connection) {
+  auto handshake = this->acquire_handshake();
+
+  uint32_t started = millis();
+  if (!connection.client->connect(connection.host.c_str(), connection.port, this->request_timeout_)) {
+    ESP_LOGW(TAG, "Could not connect to %s:%u", connection.host.c_str(), connection.port);
+    return false;
+  }
+  this->handshakes_++;
+  this->boot_timeline_.mark(BOOT_CONNECTED);
+  ESP_LOGD(TAG, "Connected to %s:%u in %ums (%u connections, %u requests on kept-alive connections)",
+           connection.host.c_str(), connection.port, (unsigned) (millis() - started),
+           (unsigned) this->handshakes_, (unsigned) this->reuses_);
+  return true;
+}
+
+}  // namespace connection_manager
+}  // namespace esphome
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <HTTPClient.h>
+#include <WiFiClient.h>
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/http_request/http_request.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+#include "boot_timeline.h"
+#include "server_clock.h"
+#include "tls_client.h"
+#include "tls_session_cache.h"
+
+namespace esphome {
+namespace connection_manager {
+
+// Retry delays for one connection: doubling from the initial interval up to
+// the maximum, with jitter so clients that failed together don't retry together
+class Backoff {
+  public:
+    Backoff() = default;
+    Backoff(uint32_t initial_interval, uint32_t max_interval)
+        : initial_interval_(initial_interval), max_interval_(max_interval) {}
+
+    // Counts a failed attempt and returns the delay before the next one
+    uint32_t next_delay();
+    void reset() { this->attempts_ = 0; }
+    int get_attempts() const { return this->attempts_; }
+
+  protected:
+    uint32_t initial_interval_ = 5000;
+    uint32_t max_interval_ = 60000;
+    int attempts_ = 0;
+};
+
+class ConnectionManager;
+
+// A response read off a pooled connection; end() hands the connection back
+class PooledResponse : public http_request::HttpContainer {
+  public:
+    ~PooledResponse() override { this->end(); }
+
+    int read(uint8_t *buf, size_t max_len) override;
+    void end() override;
+
+  protected:
+    friend class ConnectionManager;
+
+    ConnectionManager *manager_ = nullptr;
+    size_t slot_ = 0;
+    HTTPClient *http_ = nullptr;
+    size_t received_ = 0;
+};
+
+// The trackers' network policy in one place:
+//  - whether the network is up long enough to be worth a connection attempt
+//  - how long to back off after a failed one
+//  - TLS handshakes one at a time, since each peaks at tens of KB of heap
+//  - HTTP connections kept alive between requests, so a poll doesn't pay for
+//    a handshake every time
+//  - TLS sessions cached per host, so the handshakes that remain are
+//    abbreviated ones
+//  - the clock set from the servers' until SNTP syncs it
+//  - the servers' host names resolved as soon as there is an address
+//  - a timeline of the boot, up to the first content drawn
+class ConnectionManager : public Component {
+  public:
+    // Where a URL points
+    struct Endpoint {
+      bool secure = false;
+      std::string host;
+      uint16_t port = 0;
+      std::string path;
+    };
+    // http://, https://, ws:// and wss:// URLs, with the scheme's default port
+    // unless the URL gives one; false for anything else
+    static bool parse_url(const std::string &url, Endpoint &out);
+
+    void setup() override;
+    void loop() override;
+    void dump_config() override;
+
+    // Before wifi, whose setup waits for a connection: meanwhile loop() runs
+    // and sees association and DHCP as they happen
+    float get_setup_priority() const override { return setup_priority::WIFI + 1.0f; }
+
+    void set_initial_retry_interval(uint32_t interval) { initial_retry_interval_ = interval; }
+    void set_max_retry_interval(uint32_t interval) { max_retry_interval_ = interval; }
+    // How long an idle connection is kept open; 0 closes each after its request
+    void set_keep_alive(uint32_t keep_alive) { keep_alive_ = keep_alive; }
+    void set_max_connections(size_t max_connections) { max_connections_ = max_connections; }
+    void set_request_timeout(uint32_t timeout) { request_timeout_ = timeout; }
+    // Keep TLS sessions in RTC memory, so the first handshakes after a reboot resume too
+    void set_persist_sessions(bool persist) { tls_sessions_.set_persist(persist); }
+    // Where the boot timeline is served
+    void set_boot_path(const std::string &path) { boot_path_ = path; }
+    // The time source whose sync ends the servers' say over the clock
+    void set_time(time::RealTimeClock *time) { server_clock_.set_time(time); }
+#ifdef USE_SENSOR
+    void set_full_handshake_time_sensor(sensor::Sensor *sensor) { full_handshake_time_sensor_ = sensor; }
+    void set_resumed_handshake_time_sensor(sensor::Sensor *sensor) { resumed_handshake_time_sensor_ = sensor; }
+#endif
+
+    // Connected, and either a host name resolved or long enough has passed
+    // that addresses, routes and DNS are up
+    bool is_network_ready() const;
+    // Called from loop() each time is_network_ready() becomes true, so clients
+    // connect right away instead of at their next retry
+    void add_on_network_ready_callback(std::function<void()> &&callback) {
+      this->network_ready_callback_.add(std::move(callback));
+    }
+    // Resolve the URL's host as soon as the network is up, in the background,
+    // so its first connection finds it in the DNS cache
+    void prefetch(const std::string &url);
+    // A retry policy for one client; every client shares the same intervals
+    Backoff make_backoff() const { return Backoff(this->initial_retry_interval_, this->max_retry_interval_); }
+
+    // Held for the duration of a TLS handshake. Background threads wait for
+    // it; loop() callers must not block, so they try and come back after
+    // HANDSHAKE_RETRY_INTERVAL if another handshake is under way.
+    std::unique_lock<std::mutex> acquire_handshake() { return std::unique_lock<std::mutex>(this->handshake_mutex_); }
+    std::unique_lock<std::mutex> try_acquire_handshake() {
+      return std::unique_lock<std::mutex>(this->handshake_mutex_, std::try_to_lock);
+    }
+
+    // For TLS clients outside the pool, such as the WebSocket connections
+    TlsSessionCache *get_tls_sessions() { return &this->tls_sessions_; }
+    // For clients that read the servers' time themselves, such as "sentAt" in WebSocket messages
+    ServerClock *get_server_clock() { return &this->server_clock_; }
+    // For the clients' own boot stages: subscription, first data, first content
+    BootTimeline *get_boot_timeline() { return &this->boot_timeline_; }
+
+    // GET over a kept-alive connection to the URL's host, opened if there is
+    // none. Blocks until the response headers are in, so call it from a
+    // background thread. nullptr if the request could not be sent. The
+    // response's Date header goes to the server clock.
+    std::shared_ptr<http_request::HttpContainer> get(const std::string &url,
+                                                     const std::list<http_request::Header> &headers,
+                                                     const std::set<std::string> &collect_headers);
+
+    static constexpr uint32_t HANDSHAKE_RETRY_INTERVAL = 500;
+
+  protected:
+    friend class PooledResponse;
+
+    struct Connection {
+      std::string host;
+      uint16_t port = 0;
+      bool secure = false;
+      bool in_use = false;
+      uint32_t last_used = 0;
+      std::unique_ptr<WiFiClient> client;
+      // Lives as long as the socket: HTTPClient closes its client when destroyed
+      std::unique_ptr<HTTPClient> http;
+    };
+
+    // Reserves an idle connection to host:port, or else a slot for a new one
+    // (an empty slot, or the least recently used idle connection). SIZE_MAX if
+    // every connection is in use.
+    size_t checkout_(const std::string &host, uint16_t port, bool secure);
+    void release_(size_t slot, bool reusable);
+    bool open_(Connection &connection);
+    static void close_(Connection &connection);
+    void prefetch_task_(std::vector<std::string> hosts);
+    // GET <boot_path>
+    void register_boot_handler_();
+
+    uint32_t initial_retry_interval_ = 5000;
+    uint32_t max_retry_interval_ = 60000;
+    uint32_t keep_alive_ = 60000;
+    size_t max_connections_ = 2;
+    uint32_t request_timeout_ = 10000;
+
+    std::atomic<uint32_t> connected_since_{0};  // millis() when the network came up, 0 while it is down
+    std::mutex handshake_mutex_;
+    std::mutex pool_mutex_;
+    std::vector<Connection> pool_;  // Sized once in setup(), so slots stay put
+    std::atomic<uint32_t> handshakes_{0};
+    std::atomic<uint32_t> reuses_{0};
+    TlsSessionCache tls_sessions_;
+    ServerClock server_clock_;
+    BootTimeline boot_timeline_;
+    std::string boot_path_{"/boot.json"};
+    bool boot_handler_registered_ = false;
+
+    CallbackManager<void()> network_ready_callback_;
+    bool network_ready_ = false;  // As last seen by loop()
+
+    std::mutex prefetch_mutex_;
+    // Empty while the prefetch thread has them, until it hands them back
+    std::vector<std::string> prefetch_hosts_;
+    bool prefetch_pending_ = false;  // Hosts to resolve once the network is up
+    std::thread prefetch_thread_;
+    std::atomic<bool> prefetch_complete_{false};
+    // A host resolved since the network came up, so DNS and routes work
+    std::atomic<bool> dns_ready_{false};
+
+#ifdef USE_SENSOR
+    sensor::Sensor *full_handshake_time_sensor_{nullptr};
+    sensor::Sensor *resumed_handshake_time_sensor_{nullptr};
+    uint32_t published_full_handshakes_ = 0;
+    uint32_t published_resumed_handshakes_ = 0;
+#endif
+
+    // Time for DHCP, routes and DNS after the link comes up, unless a host
+    // name resolving shows sooner that they are
+    static constexpr uint32_t NETWORK_SETTLE_TIME = 1000;
+    static constexpr uint32_t PREFETCH_STACK_SIZE = 4096;
+};
+
+}  // namespace connection_manager
+}  // namespace esphome
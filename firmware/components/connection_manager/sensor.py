@@ -0,0 +1,45 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    DEVICE_CLASS_DURATION,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+)
+
+from . import CONF_CONNECTION_MANAGER_ID, ConnectionManager
+
+DEPENDENCIES = ["connection_manager"]
+
+CONF_FULL_HANDSHAKE_TIME = "full_handshake_time"
+CONF_RESUMED_HANDSHAKE_TIME = "resumed_handshake_time"
+
+# Average TLS handshake time so far, with and without a resumed session
+_HANDSHAKE_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    device_class=DEVICE_CLASS_DURATION,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_CONNECTION_MANAGER_ID): cv.use_id(ConnectionManager),
+        cv.Optional(CONF_FULL_HANDSHAKE_TIME): _HANDSHAKE_SCHEMA,
+        cv.Optional(CONF_RESUMED_HANDSHAKE_TIME): _HANDSHAKE_SCHEMA,
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_CONNECTION_MANAGER_ID])
+
+    if full_handshake_time := config.get(CONF_FULL_HANDSHAKE_TIME):
+        sens = await sensor.new_sensor(full_handshake_time)
+        cg.add(parent.set_full_handshake_time_sensor(sens))
+
+    if resumed_handshake_time := config.get(CONF_RESUMED_HANDSHAKE_TIME):
+        sens = await sensor.new_sensor(resumed_handshake_time)
+        cg.add(parent.set_resumed_handshake_time_sensor(sens))
@@ -0,0 +1,109 @@
+#include "server_clock.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/time.h>
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace connection_manager {
+
+static const char *TAG = "connection_manager.clock";
+
+void ServerClock::setup(BootTimeline *timeline) {
+  this->timeline_ = timeline;
+  if (this->time_ == nullptr) {
+    return;
+  }
+  this->time_->add_on_time_sync_callback([this]() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    if (this->provisional_ && !this->synced_) {
+      ESP_LOGI(TAG, "Time source synced, no longer following the servers' clocks");
+    }
+    this->synced_ = true;
+    this->timeline_->mark(BOOT_SNTP);
+  });
+}
+
+bool ServerClock::offer(int64_t server_ms, uint32_t one_way_ms, const char *source) {
+  if (this->synced_ || server_ms <= 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (this->synced_) {
+    return false;
+  }
+
+  int64_t now_ms = server_ms + one_way_ms;
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  int64_t local_ms = static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+  int64_t offset = now_ms - local_ms;
+  if (offset > -TOLERANCE_MS && offset < TOLERANCE_MS) {
+    return false;
+  }
+
+  tv.tv_sec = static_cast<time_t>(now_ms / 1000);
+  tv.tv_usec = static_cast<suseconds_t>((now_ms % 1000) * 1000);
+  if (settimeofday(&tv, nullptr) != 0) {
+    ESP_LOGW(TAG, "Could not set the clock from %s", source);
+    return false;
+  }
+  this->adjustments_++;
+  this->provisional_ = true;
+  if (this->timeline_ != nullptr) {
+    this->timeline_->mark(BOOT_SERVER_CLOCK);
+  }
+  // A clock that was never set reads 1970, so its offset says nothing
+  if (local_ms >= VALID_AFTER_MS) {
+    ESP_LOGI(TAG, "Clock moved %lldms by %s, until the time source syncs", static_cast<long long>(offset), source);
+  } else {
+    ESP_LOGI(TAG, "Clock set from %s, until the time source syncs", source);
+  }
+  return true;
+}
+
+void ServerClock::offer_http_date(const char *date, const char *source) {
+  time_t seconds;
+  if (this->synced_ || !parse_http_date(date, seconds)) {
+    return;
+  }
+  // The date is truncated to the second; halfway through it is as close as it gets
+  this->offer(static_cast<int64_t>(seconds) * 1000 + 500, 0, source);
+}
+
+bool ServerClock::parse_http_date(const char *date, time_t &out) {
+  static const char MONTHS[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+  // "Sun, 06 Nov 1994 08:49:37 GMT"
+  const char *comma = strchr(date, ',');
+  if (comma == nullptr) {
+    return false;
+  }
+  char month_name[4];
+  int day, year, hour, minute, second;
+  if (sscanf(comma + 1, " %d %3s %d %d:%d:%d", &day, month_name, &year, &hour, &minute, &second) != 6) {
+    return false;
+  }
+  const char *found = strlen(month_name) == 3 ? strstr(MONTHS, month_name) : nullptr;
+  if (found == nullptr || (found - MONTHS) % 3 != 0 || day < 1 || day > 31 || year < 1970 || hour > 23 ||
+      minute > 59 || second > 60) {
+    return false;
+  }
+  int month = (found - MONTHS) / 3 + 1;
+
+  // Days since the epoch of a proleptic Gregorian date, counting years from March
+  int y = year - (month <= 2 ? 1 : 0);
+  int era = y / 400;
+  int year_of_era = y - era * 400;
+  int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  int64_t days = static_cast<int64_t>(era) * 146097 + day_of_era - 719468;
+
+  out = static_cast<time_t>(days * 86400 + hour * 3600 + minute * 60 + second);
+  return true;
+}
+
+}  // namespace connection_manager
+}  // namespace esphome
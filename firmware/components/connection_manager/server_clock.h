@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+
+#include "esphome/components/time/real_time_clock.h"
+
+#include "boot_timeline.h"
+
+namespace esphome {
+namespace connection_manager {
+
+// The system clock, set from the servers' clocks until a time source (SNTP)
+// syncs it. Every schedule message and HTTP response carries the server's
+// time, and the first arrives well before SNTP answers on a slow or filtered
+// network, so departures can be drawn without waiting for it. Once the time
+// source syncs, the clock is its alone.
+class ServerClock {
+  public:
+    // Readings closer than this to the clock don't move it
+    static constexpr int64_t TOLERANCE_MS = 2000;
+    // Where ESPTime::is_valid() starts, 2019-01-01
+    static constexpr int64_t VALID_AFTER_MS = 1546300800000LL;
+
+    void set_time(time::RealTimeClock *time) { this->time_ = time; }
+    // Records when the clock was first set and when the time source synced
+    void setup(BootTimeline *timeline);
+
+    // A server's clock, in epoch ms, as it was one_way_ms ago. Sets the clock
+    // if no time source has synced it and it is off by more than TOLERANCE_MS;
+    // true if it did. Safe from any task.
+    bool offer(int64_t server_ms, uint32_t one_way_ms, const char *source);
+    // An HTTP Date header ("Sun, 06 Nov 1994 08:49:37 GMT")
+    void offer_http_date(const char *date, const char *source);
+
+    // The clock reads a server's time and no time source has synced it yet
+    bool is_provisional() const { return this->provisional_ && !this->synced_; }
+    bool is_synced() const { return this->synced_; }
+    uint32_t get_adjustments() const { return this->adjustments_; }
+
+    // RFC 7231 IMF-fixdate to epoch seconds; false if the date isn't one
+    static bool parse_http_date(const char *date, time_t &out);
+
+  protected:
+    time::RealTimeClock *time_{nullptr};
+    BootTimeline *timeline_{nullptr};
+    // Held across the check of synced_ and settimeofday(), and by the time
+    // source's sync callback, so a server's time never lands after SNTP's
+    std::mutex mutex_;
+    std::atomic<bool> synced_{false};
+    std::atomic<bool> provisional_{false};
+    std::atomic<uint32_t> adjustments_{0};
+};
+
+}  // namespace connection_manager
+}  // namespace esphome
@@ -0,0 +1,319 @@
+#include "tls_client.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <esp_random.h>
+#include <lwip/netdb.h>
+#include <lwip/sockets.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace connection_manager {
+
+static const char *TAG = "connection_manager.tls";
+
+static constexpr uint32_t IO_TIMEOUT = 5000;
+
+struct TlsClient::Context {
+  mbedtls_ssl_context ssl;
+  mbedtls_ssl_config config;
+  // Of the master secret the handshake derived; equal to the cached one if it resumed
+  uint32_t master_fingerprint = 0;
+
+  Context() {
+    mbedtls_ssl_init(&this->ssl);
+    mbedtls_ssl_config_init(&this->config);
+  }
+  ~Context() {
+    mbedtls_ssl_free(&this->ssl);
+    mbedtls_ssl_config_free(&this->config);
+  }
+};
+
+// The hardware RNG, instead of an entropy pool and a DRBG per connection
+static int fill_random(void *, unsigned char *buf, size_t len) {
+  esp_fill_random(buf, len);
+  return 0;
+}
+
+static void export_keys(void *fingerprint, mbedtls_ssl_key_export_type type, const unsigned char *secret,
+                        size_t secret_len, const unsigned char *, const unsigned char *, mbedtls_tls_prf_types) {
+  if (type == MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET) {
+    *static_cast<uint32_t *>(fingerprint) = TlsSessionCache::fingerprint(secret, secret_len);
+  }
+}
+
+TlsClient::TlsClient() = default;
+TlsClient::~TlsClient() { this->stop(); }
+
+int TlsClient::connect(IPAddress ip, uint16_t port) { return this->connect(ip, port, this->handshake_timeout_); }
+
+int TlsClient::connect(IPAddress ip, uint16_t port, int32_t timeout) {
+  return this->connect(ip.toString().c_str(), port, timeout);
+}
+
+int TlsClient::connect(const char *host, uint16_t port) {
+  return this->connect(host, port, this->handshake_timeout_);
+}
+
+int TlsClient::connect(const char *host, uint16_t port, int32_t timeout) {
+  this->stop();
+  if (!this->open_socket_(host, port, timeout) || !this->handshake_(host, port, timeout)) {
+    this->stop();
+    return 0;
+  }
+  this->open_ = true;
+  return 1;
+}
+
+bool TlsClient::open_socket_(const char *host, uint16_t port, uint32_t timeout) {
+  struct addrinfo hints = {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *address = nullptr;
+  char service[6];
+  snprintf(service, sizeof(service), "%u", port);
+  if (lwip_getaddrinfo(host, service, &hints, &address) != 0 || address == nullptr) {
+    ESP_LOGW(TAG, "Could not resolve %s", host);
+    return false;
+  }
+
+  this->fd_ = lwip_socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+  if (this->fd_ < 0) {
+    lwip_freeaddrinfo(address);
+    ESP_LOGW(TAG, "Could not create a socket: %d", errno);
+    return false;
+  }
+
+  // Non-blocking from here on, so every wait below has a timeout
+  lwip_fcntl(this->fd_, F_SETFL, lwip_fcntl(this->fd_, F_GETFL, 0) | O_NONBLOCK);
+  int result = lwip_connect(this->fd_, address->ai_addr, address->ai_addrlen);
+  lwip_freeaddrinfo(address);
+  if (result != 0 && errno != EINPROGRESS) {
+    ESP_LOGW(TAG, "Could not connect to %s:%u: %d", host, port, errno);
+    return false;
+  }
+  if (result != 0) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (!this->wait_(true, timeout) || lwip_getsockopt(this->fd_, SOL_SOCKET, SO_ERROR, &error, &length) != 0 ||
+        error != 0) {
+      ESP_LOGW(TAG, "Could not connect to %s:%u: %d", host, port, error);
+      return false;
+    }
+  }
+
+  int nodelay = 1;
+  lwip_setsockopt(this->fd_, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+  return true;
+}
+
+bool TlsClient::handshake_(const char *host, uint16_t port, uint32_t timeout) {
+  this->context_.reset(new Context());  // NOLINT
+  Context &context = *this->context_;
+
+  int result = mbedtls_ssl_config_defaults(&context.config, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                           MBEDTLS_SSL_PRESET_DEFAULT);
+  if (result != 0) {
+    ESP_LOGW(TAG, "Could not configure TLS: -0x%04x", -result);
+    return false;
+  }
+  mbedtls_ssl_conf_authmode(&context.config, MBEDTLS_SSL_VERIFY_NONE);
+  mbedtls_ssl_conf_rng(&context.config, fill_random, nullptr);
+  mbedtls_ssl_conf_max_tls_version(&context.config, MBEDTLS_SSL_VERSION_TLS1_2);
+  mbedtls_ssl_conf_session_tickets(&context.config, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+
+  result = mbedtls_ssl_setup(&context.ssl, &context.config);
+  if (result != 0) {
+    ESP_LOGW(TAG, "Could not set up TLS: -0x%04x", -result);
+    return false;
+  }
+  mbedtls_ssl_set_hostname(&context.ssl, host);
+  mbedtls_ssl_set_bio(&context.ssl, this, send_, recv_, nullptr);
+  mbedtls_ssl_set_export_keys_cb(&context.ssl, export_keys, &context.master_fingerprint);
+
+  std::string key = std::string(host) + ":" + std::to_string(port);
+  std::vector<uint8_t> saved;
+  uint32_t saved_fingerprint = 0;
+  bool offered = false;
+  if (this->sessions_ != nullptr && this->sessions_->find(key, saved, saved_fingerprint)) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    offered = mbedtls_ssl_session_load(&session, saved.data(), saved.size()) == 0 &&
+              mbedtls_ssl_set_session(&context.ssl, &session) == 0;
+    mbedtls_ssl_session_free(&session);
+    if (!offered) {
+      // From another mbedtls build, most likely
+      this->sessions_->forget(key);
+    }
+  }
+
+  uint32_t started = millis();
+  while ((result = mbedtls_ssl_handshake(&context.ssl)) != 0) {
+    uint32_t elapsed = millis() - started;
+    if ((result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) || elapsed >= timeout ||
+        !this->wait_(result == MBEDTLS_ERR_SSL_WANT_WRITE, timeout - elapsed)) {
+      ESP_LOGW(TAG, "TLS handshake with %s failed: -0x%04x", key.c_str(), -result);
+      if (offered) {
+        // Some servers choke on a stale session; the retry starts afresh
+        this->sessions_->forget(key);
+      }
+      return false;
+    }
+  }
+  this->handshake_time_ = millis() - started;
+  this->resumed_ = offered && context.master_fingerprint == saved_fingerprint;
+
+  if (this->sessions_ != nullptr) {
+    this->sessions_->record_handshake(this->resumed_, this->handshake_time_);
+
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    size_t size = 0;
+    if (mbedtls_ssl_get_session(&context.ssl, &session) == 0) {
+      mbedtls_ssl_session_save(&session, nullptr, 0, &size);
+      std::vector<uint8_t> data(size);
+      if (size > 0 && mbedtls_ssl_session_save(&session, data.data(), data.size(), &size) == 0) {
+        this->sessions_->store(key, std::move(data), context.master_fingerprint);
+      }
+    }
+    mbedtls_ssl_session_free(&session);
+  }
+
+  ESP_LOGD(TAG, "TLS handshake with %s took %ums (%s)", key.c_str(), (unsigned) this->handshake_time_,
+           this->resumed_ ? "resumed" : (offered ? "full, session not resumed" : "full"));
+  return true;
+}
+
+bool TlsClient::wait_(bool write, uint32_t timeout) {
+  fd_set fds;
+  FD_ZERO(&fds);
+  FD_SET(this->fd_, &fds);
+  struct timeval tv;
+  tv.tv_sec = timeout / 1000;
+  tv.tv_usec = (timeout % 1000) * 1000;
+  return lwip_select(this->fd_ + 1, write ? nullptr : &fds, write ? &fds : nullptr, nullptr, &tv) > 0;
+}
+
+int TlsClient::send_(void *self, const unsigned char *buf, size_t len) {
+  int sent = lwip_send(static_cast<TlsClient *>(self)->fd_, buf, len, 0);
+  if (sent < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_NET_SEND_FAILED;
+  }
+  return sent;
+}
+
+int TlsClient::recv_(void *self, unsigned char *buf, size_t len) {
+  int received = lwip_recv(static_cast<TlsClient *>(self)->fd_, buf, len, 0);
+  if (received < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_NET_RECV_FAILED;
+  }
+  if (received == 0) {
+    return MBEDTLS_ERR_NET_CONN_RESET;
+  }
+  return received;
+}
+
+size_t TlsClient::write(uint8_t data) { return this->write(&data, 1); }
+
+size_t TlsClient::write(const uint8_t *buf, size_t size) {
+  if (!this->open_) {
+    return 0;
+  }
+  size_t written = 0;
+  uint32_t started = millis();
+  while (written < size) {
+    int result = mbedtls_ssl_write(&this->context_->ssl, buf + written, size - written);
+    if (result > 0) {
+      written += result;
+      continue;
+    }
+    uint32_t elapsed = millis() - started;
+    if ((result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) || elapsed >= IO_TIMEOUT ||
+        !this->wait_(result == MBEDTLS_ERR_SSL_WANT_WRITE, IO_TIMEOUT - elapsed)) {
+      ESP_LOGV(TAG, "TLS write failed: -0x%04x", -result);
+      this->open_ = false;
+      break;
+    }
+  }
+  return written;
+}
+
+int TlsClient::available() {
+  if (this->context_ == nullptr) {
+    return 0;
+  }
+  int buffered = this->peeked_ >= 0 ? 1 : 0;
+  if (this->open_) {
+    // Reads in whatever record has arrived without consuming it
+    int result = mbedtls_ssl_read(&this->context_->ssl, nullptr, 0);
+    if (result < 0 && result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      this->open_ = false;
+    }
+  }
+  return buffered + mbedtls_ssl_get_bytes_avail(&this->context_->ssl);
+}
+
+int TlsClient::read() {
+  uint8_t data;
+  return this->read(&data, 1) == 1 ? data : -1;
+}
+
+int TlsClient::read(uint8_t *buf, size_t size) {
+  if (this->context_ == nullptr || size == 0) {
+    return -1;
+  }
+  size_t offset = 0;
+  if (this->peeked_ >= 0) {
+    buf[offset++] = this->peeked_;
+    this->peeked_ = -1;
+    if (size == 1) {
+      return 1;
+    }
+  }
+  // -1 when nothing has arrived yet, as WiFiClientSecure does
+  int result = mbedtls_ssl_read(&this->context_->ssl, buf + offset, size - offset);
+  if (result > 0) {
+    return offset + result;
+  }
+  if (result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) {
+    // 0 is the peer's close_notify
+    this->open_ = false;
+  }
+  return offset > 0 ? (int) offset : -1;
+}
+
+int TlsClient::peek() {
+  if (this->peeked_ < 0) {
+    this->peeked_ = this->read();
+  }
+  return this->peeked_;
+}
+
+void TlsClient::stop() {
+  if (this->context_ != nullptr && this->open_) {
+    mbedtls_ssl_close_notify(&this->context_->ssl);
+  }
+  this->context_.reset();
+  if (this->fd_ >= 0) {
+    lwip_close(this->fd_);
+    this->fd_ = -1;
+  }
+  this->open_ = false;
+  this->peeked_ = -1;
+}
+
+uint8_t TlsClient::connected() {
+  // Still "connected" while there is data left to read, as with WiFiClient
+  return this->fd_ >= 0 && (this->open_ || this->available() > 0);
+}
+
+}  // namespace connection_manager
+}  // namespace esphome
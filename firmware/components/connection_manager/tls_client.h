@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <WiFiClient.h>
+
+#include "tls_session_cache.h"
+
+namespace esphome {
+namespace connection_manager {
+
+// A TLS client that resumes sessions. WiFiClientSecure sets up and completes
+// its handshake in one call, so there is nowhere to hand it a saved session;
+// this one drives mbedtls itself, and offers the session cached for the host
+// before the handshake and caches the new one after it.
+//
+// Like WiFiClientSecure with setInsecure(), it does not verify certificates.
+// TLS 1.2 only: that is where sessions are complete once the handshake is.
+class TlsClient : public WiFiClient {
+  public:
+    TlsClient();
+    TlsClient(const TlsClient &) = delete;
+    TlsClient &operator=(const TlsClient &) = delete;
+    ~TlsClient() override;
+
+    void set_session_cache(TlsSessionCache *sessions) { this->sessions_ = sessions; }
+    void set_handshake_timeout(uint32_t timeout) { this->handshake_timeout_ = timeout; }
+
+    int connect(IPAddress ip, uint16_t port) override;
+    int connect(IPAddress ip, uint16_t port, int32_t timeout) override;
+    int connect(const char *host, uint16_t port) override;
+    int connect(const char *host, uint16_t port, int32_t timeout) override;
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t *buf, size_t size) override;
+    int available() override;
+    int read() override;
+    int read(uint8_t *buf, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+
+    // Of the last handshake: whether it resumed a cached session, and how long it took
+    bool was_resumed() const { return this->resumed_; }
+    uint32_t get_handshake_time() const { return this->handshake_time_; }
+
+  protected:
+    struct Context;
+
+    bool open_socket_(const char *host, uint16_t port, uint32_t timeout);
+    bool handshake_(const char *host, uint16_t port, uint32_t timeout);
+    // Waits for the socket to become readable or writable; false on timeout
+    bool wait_(bool write, uint32_t timeout);
+
+    static int send_(void *self, const unsigned char *buf, size_t len);
+    static int recv_(void *self, unsigned char *buf, size_t len);
+
+    TlsSessionCache *sessions_ = nullptr;
+    uint32_t handshake_timeout_ = 10000;
+    int fd_ = -1;
+    bool open_ = false;  // Until the peer closes or a read or write fails
+    int peeked_ = -1;
+    bool resumed_ = false;
+    uint32_t handshake_time_ = 0;
+    std::unique_ptr<Context> context_;
+};
+
+}  // namespace connection_manager
+}  // namespace esphome
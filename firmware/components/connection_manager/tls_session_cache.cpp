@@ -0,0 +1,194 @@
+#include "tls_session_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <esp_attr.h>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace connection_manager {
+
+static const char *TAG = "connection_manager.tls";
+
+// Persisted sessions: a header, then per session (most recently used first)
+// the host's length and name, the master fingerprint, the session's length and
+// the session. Sessions that don't fit are only kept in RAM.
+static constexpr uint32_t RTC_MAGIC = 0x31535452;  // "RTS1"
+static constexpr size_t RTC_SIZE = 3072;
+
+struct RtcHeader {
+  uint32_t magic;
+  uint32_t size;
+  uint32_t checksum;
+};
+
+static RTC_NOINIT_ATTR uint8_t rtc_sessions[RTC_SIZE];
+
+uint32_t TlsSessionCache::fingerprint(const uint8_t *data, size_t size) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ data[i]) * 16777619u;
+  }
+  return hash;
+}
+
+void TlsSessionCache::restore() {
+  if (!this->persist_) {
+    return;
+  }
+
+  RtcHeader header;
+  memcpy(&header, rtc_sessions, sizeof(header));
+  const uint8_t *data = rtc_sessions + sizeof(header);
+  if (header.magic != RTC_MAGIC || header.size > RTC_SIZE - sizeof(header) ||
+      header.checksum != fingerprint(data, header.size)) {
+    // Power-on contents, or an older layout
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  size_t offset = 0;
+  while (offset < header.size && this->entries_.size() < MAX_ENTRIES) {
+    Entry entry;
+    uint8_t host_size = data[offset++];
+    uint16_t session_size;
+    if (offset + host_size + sizeof(uint32_t) + sizeof(session_size) > header.size) {
+      break;
+    }
+    entry.host.assign(reinterpret_cast<const char *>(data + offset), host_size);
+    offset += host_size;
+    memcpy(&entry.master_fingerprint, data + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    memcpy(&session_size, data + offset, sizeof(session_size));
+    offset += sizeof(session_size);
+    if (offset + session_size > header.size) {
+      break;
+    }
+    entry.session.assign(data + offset, data + offset + session_size);
+    offset += session_size;
+    this->entries_.push_back(std::move(entry));
+  }
+
+  ESP_LOGD(TAG, "Restored %u TLS session(s) from RTC memory", (unsigned) this->entries_.size());
+}
+
+bool TlsSessionCache::find(const std::string &host, std::vector<uint8_t> &session, uint32_t &master_fingerprint) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  Entry *entry = this->find_(host);
+  if (entry == nullptr) {
+    return false;
+  }
+  session = entry->session;
+  master_fingerprint = entry->master_fingerprint;
+  return true;
+}
+
+void TlsSessionCache::store(const std::string &host, std::vector<uint8_t> session, uint32_t master_fingerprint) {
+  if (session.empty() || session.size() > MAX_SESSION_SIZE) {
+    ESP_LOGV(TAG, "Not caching a %u byte session for %s", (unsigned) session.size(), host.c_str());
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  Entry *entry = this->find_(host);
+  if (entry == nullptr) {
+    if (this->entries_.size() < MAX_ENTRIES) {
+      this->entries_.emplace_back();
+      entry = &this->entries_.back();
+    } else {
+      entry = &*std::min_element(this->entries_.begin(), this->entries_.end(),
+                                 [](const Entry &a, const Entry &b) { return a.last_used < b.last_used; });
+    }
+    entry->host = host;
+  }
+  entry->session = std::move(session);
+  entry->master_fingerprint = master_fingerprint;
+  entry->last_used = millis();
+
+  if (this->persist_) {
+    this->persist_locked_();
+  }
+}
+
+void TlsSessionCache::forget(const std::string &host) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto it = std::remove_if(this->entries_.begin(), this->entries_.end(),
+                           [&host](const Entry &entry) { return entry.host == host; });
+  if (it == this->entries_.end()) {
+    return;
+  }
+  this->entries_.erase(it, this->entries_.end());
+  if (this->persist_) {
+    this->persist_locked_();
+  }
+}
+
+void TlsSessionCache::record_handshake(bool resumed, uint32_t ms) {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  (resumed ? this->resumed_ : this->full_).add(ms);
+}
+
+TlsSessionCache::Stats TlsSessionCache::get_full_stats() const {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->full_;
+}
+
+TlsSessionCache::Stats TlsSessionCache::get_resumed_stats() const {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->resumed_;
+}
+
+size_t TlsSessionCache::size() const {
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  return this->entries_.size();
+}
+
+TlsSessionCache::Entry *TlsSessionCache::find_(const std::string &host) {
+  for (auto &entry : this->entries_) {
+    if (entry.host == host) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+void TlsSessionCache::persist_locked_() {
+  std::vector<const Entry *> order;
+  for (const auto &entry : this->entries_) {
+    order.push_back(&entry);
+  }
+  std::sort(order.begin(), order.end(), [](const Entry *a, const Entry *b) { return a->last_used > b->last_used; });
+
+  uint8_t *data = rtc_sessions + sizeof(RtcHeader);
+  size_t capacity = RTC_SIZE - sizeof(RtcHeader);
+  size_t offset = 0;
+  for (const Entry *entry : order) {
+    uint8_t host_size = std::min<size_t>(entry->host.size(), UINT8_MAX);
+    uint16_t session_size = entry->session.size();
+    size_t size = 1 + host_size + sizeof(uint32_t) + sizeof(session_size) + session_size;
+    if (offset + size > capacity) {
+      ESP_LOGV(TAG, "No room in RTC memory for the %u byte session for %s", (unsigned) session_size,
+               entry->host.c_str());
+      continue;
+    }
+    data[offset++] = host_size;
+    memcpy(data + offset, entry->host.data(), host_size);
+    offset += host_size;
+    memcpy(data + offset, &entry->master_fingerprint, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    memcpy(data + offset, &session_size, sizeof(session_size));
+    offset += sizeof(session_size);
+    memcpy(data + offset, entry->session.data(), session_size);
+    offset += session_size;
+  }
+
+  RtcHeader header{RTC_MAGIC, (uint32_t) offset, fingerprint(data, offset)};
+  memcpy(rtc_sessions, &header, sizeof(header));
+}
+
+}  // namespace connection_manager
+}  // namespace esphome
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace connection_manager {
+
+// TLS sessions per host:port, so a reconnect offers the last session (ticket
+// or session ID) and the server can skip the certificate exchange and key
+// agreement. Sessions are kept serialized, the way mbedtls saves them, with a
+// fingerprint of their master secret: a resumed handshake derives the same one,
+// which is how a resumption is told apart from a full handshake.
+class TlsSessionCache {
+  public:
+    struct Entry {
+      std::string host;  // host:port
+      std::vector<uint8_t> session;
+      uint32_t master_fingerprint = 0;
+      uint32_t last_used = 0;
+    };
+
+    // Handshake times, split by whether the session was resumed
+    struct Stats {
+      uint32_t count = 0;
+      uint32_t total_ms = 0;
+      uint32_t max_ms = 0;
+
+      void add(uint32_t ms) {
+        this->count++;
+        this->total_ms += ms;
+        if (ms > this->max_ms) {
+          this->max_ms = ms;
+        }
+      }
+      uint32_t average_ms() const { return this->count == 0 ? 0 : this->total_ms / this->count; }
+    };
+
+    static constexpr size_t MAX_ENTRIES = 4;
+    // Sessions hold the server's certificate too, so they are a few KB at most
+    static constexpr size_t MAX_SESSION_SIZE = 4096;
+
+    // Also keep sessions in RTC memory, where they survive a reboot (not a power cut)
+    void set_persist(bool persist) { this->persist_ = persist; }
+    bool get_persist() const { return this->persist_; }
+    // Reloads the sessions the last boot persisted, if any
+    void restore();
+
+    // The session to offer host, or false if there is none
+    bool find(const std::string &host, std::vector<uint8_t> &session, uint32_t &master_fingerprint);
+    void store(const std::string &host, std::vector<uint8_t> session, uint32_t master_fingerprint);
+    // The server refused or broke the session; the next handshake is a full one
+    void forget(const std::string &host);
+
+    void record_handshake(bool resumed, uint32_t ms);
+    Stats get_full_stats() const;
+    Stats get_resumed_stats() const;
+    size_t size() const;
+
+    static uint32_t fingerprint(const uint8_t *data, size_t size);
+
+  protected:
+    Entry *find_(const std::string &host);
+    void persist_locked_();
+
+    bool persist_ = false;
+    mutable std::mutex mutex_;
+    std::vector<Entry> entries_;
+    Stats full_;
+    Stats resumed_;
+};
+
+}  // namespace connection_manager
+}  // namespace esphome
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <ArduinoWebsockets.h>
+
+#include "connection_manager.h"
+
+namespace esphome {
+namespace connection_manager {
+
+// wss:// for ArduinoWebsockets over a TlsClient, so a reconnect resumes the
+// last TLS session. Header-only: only components that use ArduinoWebsockets
+// include it.
+class WebsocketTransport : public websockets::network::GenericEspTcpClient<TlsClient> {
+  public:
+    explicit WebsocketTransport(ConnectionManager *manager) {
+      this->client.set_session_cache(manager->get_tls_sessions());
+    }
+};
+
+// A client for url: for wss://, one whose connections go through a
+// WebsocketTransport. Make it before registering callbacks.
+inline websockets::WebsocketsClient make_websocket_client(ConnectionManager *manager, const std::string &url) {
+  if (url.rfind("wss://", 0) != 0) {
+    return websockets::WebsocketsClient();
+  }
+  return websockets::WebsocketsClient(std::make_shared<WebsocketTransport>(manager));
+}
+
+// Connects a client from make_websocket_client(). Given a wss:// URL,
+// ArduinoWebsockets would swap in its own WiFiClientSecure, so secure URLs are
+// passed to it as host, port and path instead.
+inline bool connect_websocket(websockets::WebsocketsClient &client, const std::string &url) {
+  ConnectionManager::Endpoint endpoint;
+  if (!ConnectionManager::parse_url(url, endpoint) || !endpoint.secure) {
+    return client.connect(url.c_str());
+  }
+  return client.connect(endpoint.host.c_str(), endpoint.port, endpoint.path.c_str());
+}
+
+}  // namespace connection_manager
+}  // namespace esphome
@@ -0,0 +1,81 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components.display import DisplayRef
+from esphome.components.frame_scheduler import FrameScheduler
+from esphome.const import CONF_ID, CONF_HEIGHT, CONF_LAMBDA, CONF_WIDTH, CONF_X, CONF_Y
+
+# Splits the panel into zones that refresh independently, e.g. departures on
+# the left and a live score on the right. A page composes them with
+# `id(compositor).compose(it);` and the frame_scheduler asks
+# `id(compositor).get_next_frame_at()` when the next zone is due.
+
+AUTO_LOAD = ["matrix_render", "memory_placement"]
+
+display_compositor_ns = cg.esphome_ns.namespace("display_compositor")
+DisplayCompositor = display_compositor_ns.class_("DisplayCompositor", cg.Component)
+Zone = display_compositor_ns.class_("Zone")
+
+CONF_ZONES = "zones"
+CONF_FRAME_SCHEDULER_ID = "frame_scheduler_id"
+CONF_NEXT_FRAME = "next_frame"
+CONF_MIN_INTERVAL = "min_interval"
+CONF_MAX_INTERVAL = "max_interval"
+
+ZONE_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(Zone),
+        cv.Optional(CONF_X, default=0): cv.int_range(min=0),
+        cv.Optional(CONF_Y, default=0): cv.int_range(min=0),
+        cv.Required(CONF_WIDTH): cv.int_range(min=1),
+        cv.Required(CONF_HEIGHT): cv.int_range(min=1),
+        cv.Required(CONF_LAMBDA): cv.lambda_,
+        # Without one, the zone is redrawn every min_interval
+        cv.Optional(CONF_NEXT_FRAME): cv.returning_lambda,
+        cv.Optional(CONF_MIN_INTERVAL, default="0ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+    }
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(DisplayCompositor),
+        cv.Required(CONF_ZONES): cv.All(cv.ensure_list(ZONE_SCHEMA), cv.Length(min=1)),
+        # Copy only the zones that changed on frames the scheduler didn't clear
+        cv.Optional(CONF_FRAME_SCHEDULER_ID): cv.use_id(FrameScheduler),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    if CONF_FRAME_SCHEDULER_ID in config:
+        scheduler = await cg.get_variable(config[CONF_FRAME_SCHEDULER_ID])
+        cg.add(var.set_frame_scheduler(scheduler))
+
+    for zone_config in config[CONF_ZONES]:
+        zone = cg.new_Pvariable(zone_config[CONF_ID])
+        cg.add(
+            zone.set_bounds(
+                zone_config[CONF_X],
+                zone_config[CONF_Y],
+                zone_config[CONF_WIDTH],
+                zone_config[CONF_HEIGHT],
+            )
+        )
+
+        draw = await cg.process_lambda(
+            zone_config[CONF_LAMBDA], [(DisplayRef, "it")], return_type=cg.void
+        )
+        cg.add(zone.set_draw(draw))
+
+        if CONF_NEXT_FRAME in zone_config:
+            next_frame = await cg.process_lambda(
+                zone_config[CONF_NEXT_FRAME], [], return_type=cg.uint32
+            )
+            cg.add(zone.set_next_frame(next_frame))
+
+        cg.add(zone.set_min_interval(zone_config[CONF_MIN_INTERVAL]))
+        cg.add(zone.set_max_interval(zone_config[CONF_MAX_INTERVAL]))
+        cg.add(var.add_zone(zone))
@@ -0,0 +1,128 @@
+#include "display_compositor.h"
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/components/memory_placement/placement.h"
+
+namespace esphome {
+namespace display_compositor {
+
+static const char *TAG = "display_compositor";
+
+bool Zone::allocate_() {
+  size_t size = (size_t) this->width_ * this->height_ * sizeof(uint16_t);
+  this->buffer_ = static_cast<uint16_t *>(memory_placement::allocate(memory_placement::CATEGORY_ZONE_BUFFER, size));
+  if (this->buffer_ == nullptr) {
+    return false;
+  }
+  this->canvas_.set_frame(this->buffer_, this->width_, this->height_, 0, this->height_);
+  this->canvas_.fill(Color(0, 0, 0));
+  return true;
+}
+
+uint32_t Zone::due_at_(uint32_t now) const {
+  uint32_t due_at;
+  if (this->redraw_requested_) {
+    due_at = now;
+  } else if (this->next_frame_) {
+    due_at = this->last_redraw_ + this->max_interval_;
+    uint32_t next_frame = this->next_frame_();
+    if (static_cast<int32_t>(next_frame - due_at) < 0) {
+      due_at = next_frame;
+    }
+  } else {
+    // Zones without a schedule redraw every min_interval
+    due_at = now;
+  }
+
+  uint32_t earliest = this->last_redraw_ + this->min_interval_;
+  if (static_cast<int32_t>(earliest - due_at) > 0) {
+    due_at = earliest;
+  }
+  return due_at;
+}
+
+void HOT Zone::redraw_(uint32_t now) {
+  // Cleared first, so a request made while drawing isn't lost
+  this->redraw_requested_ = false;
+  this->last_redraw_ = now;
+  this->redraw_count_++;
+  this->dirty_ = true;
+
+  this->canvas_.fill(Color(0, 0, 0));
+  if (this->draw_) {
+    this->draw_(this->canvas_);
+  }
+}
+
+void HOT Zone::blit_(display::Display &it) {
+  it.draw_pixels_at(this->x_, this->y_, this->width_, this->height_, reinterpret_cast<const uint8_t *>(this->buffer_),
+                    display::COLOR_ORDER_RGB, display::COLOR_BITNESS_565, false);
+  this->dirty_ = false;
+}
+
+void DisplayCompositor::setup() {
+  for (auto *zone : this->zones_) {
+    if (!zone->allocate_()) {
+      ESP_LOGE(TAG, "Could not allocate %dx%d zone buffer", zone->width_, zone->height_);
+      this->mark_failed();
+    }
+  }
+
+  this->set_interval("redraw_rate", 60000, [this]() {
+    for (size_t i = 0; i < this->zones_.size(); i++) {
+      ESP_LOGD(TAG, "Zone %u redrew %u times in the last minute", (unsigned) i, this->zones_[i]->redraw_count_);
+      this->zones_[i]->redraw_count_ = 0;
+    }
+  });
+}
+
+void DisplayCompositor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Display Compositor:");
+  for (size_t i = 0; i < this->zones_.size(); i++) {
+    const Zone *zone = this->zones_[i];
+    ESP_LOGCONFIG(TAG, "  Zone %u: %dx%d at (%d, %d), every %u-%ums", (unsigned) i, zone->width_, zone->height_,
+                  zone->x_, zone->y_, zone->min_interval_, zone->max_interval_);
+  }
+}
+
+void HOT DisplayCompositor::compose(display::Display &it) {
+  uint32_t now = millis();
+
+  for (auto *zone : this->zones_) {
+    if (zone->buffer_ != nullptr && static_cast<int32_t>(now - zone->due_at_(now)) >= 0) {
+      zone->redraw_(now);
+    }
+  }
+
+  // On a panel that kept the previous frame, zones that weren't redrawn are already there
+  bool cleared = this->frame_scheduler_ == nullptr || this->frame_scheduler_->is_frame_cleared();
+  for (auto *zone : this->zones_) {
+    if (zone->buffer_ != nullptr && (cleared || zone->dirty_)) {
+      zone->blit_(it);
+    }
+  }
+}
+
+uint32_t DisplayCompositor::get_next_frame_at() const {
+  uint32_t now = millis();
+  bool found = false;
+  uint32_t next_frame_at = now;
+
+  for (const auto *zone : this->zones_) {
+    if (zone->buffer_ == nullptr) {
+      continue;
+    }
+    uint32_t due_at = zone->due_at_(now);
+    if (!found || static_cast<int32_t>(due_at - next_frame_at) < 0) {
+      next_frame_at = due_at;
+      found = true;
+    }
+  }
+
+  return next_frame_at;
+}
+
+}  // namespace display_compositor
+}  // namespace esphome
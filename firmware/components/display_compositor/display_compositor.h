@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/components/display/display.h"
+#include "esphome/components/frame_scheduler/frame_scheduler.h"
+#include "esphome/components/matrix_render/banded_renderer.h"
+
+namespace esphome {
+namespace display_compositor {
+
+// A rectangle of the panel with its own off-screen RGB565 buffer. The draw
+// function sees a display the size of the zone, so the trackers' layout code
+// runs unchanged inside it. The zone is only redrawn when its deadline
+// passes or it is requested, and only copied to the panel when it was redrawn
+// or the panel was cleared.
+class Zone {
+  public:
+    using DrawFunc = std::function<void(display::Display &it)>;
+    // Returns the millis() instant at which the zone's output next changes
+    using NextFrameFunc = std::function<uint32_t()>;
+
+    void set_bounds(int x, int y, int width, int height) {
+      x_ = x;
+      y_ = y;
+      width_ = width;
+      height_ = height;
+    }
+    void set_draw(DrawFunc draw) { draw_ = std::move(draw); }
+    void set_next_frame(NextFrameFunc next_frame) { next_frame_ = std::move(next_frame); }
+    void set_min_interval(uint32_t min_interval) { min_interval_ = min_interval; }
+    void set_max_interval(uint32_t max_interval) { max_interval_ = max_interval; }
+
+    // Redraw at the next frame, whatever the deadline says. Safe from any task.
+    void request_redraw() { this->redraw_requested_ = true; }
+
+    int get_x() const { return x_; }
+    int get_y() const { return y_; }
+    int get_width() const { return width_; }
+    int get_height() const { return height_; }
+    uint32_t get_redraw_count() const { return redraw_count_; }
+
+  protected:
+    friend class DisplayCompositor;
+
+    bool allocate_();
+    // The millis() instant at which the zone is next redrawn
+    uint32_t due_at_(uint32_t now) const;
+    void redraw_(uint32_t now);
+    void blit_(display::Display &it);
+
+    int x_ = 0;
+    int y_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+    DrawFunc draw_;
+    NextFrameFunc next_frame_;
+    uint32_t min_interval_ = 0;
+    uint32_t max_interval_ = 1000;
+
+    uint16_t *buffer_ = nullptr;
+    matrix_render::BandCanvas canvas_;
+    bool dirty_ = true;  // Redrawn since it was last copied to the panel
+    std::atomic<bool> redraw_requested_{true};
+    uint32_t last_redraw_ = 0;
+    uint32_t redraw_count_ = 0;
+};
+
+// Splits the panel into zones that refresh independently. A page hands its
+// `it` to compose(), which redraws only the zones that are due; the
+// frame_scheduler asks get_next_frame_at() so a frame is only drawn when some
+// zone changes. With a frame_scheduler whose schedule for the page has
+// auto_clear_enabled off, the panel keeps the previous frame and only the
+// redrawn zones are copied into it; otherwise every zone is copied each frame.
+class DisplayCompositor : public Component {
+  public:
+    void setup() override;
+    void dump_config() override;
+
+    void add_zone(Zone *zone) { zones_.push_back(zone); }
+    void set_frame_scheduler(frame_scheduler::FrameScheduler *frame_scheduler) { frame_scheduler_ = frame_scheduler; }
+
+    void compose(display::Display &it);
+
+    // The millis() instant at which the earliest zone is next redrawn
+    uint32_t get_next_frame_at() const;
+
+  protected:
+    std::vector<Zone *> zones_;
+    frame_scheduler::FrameScheduler *frame_scheduler_ = nullptr;
+};
+
+}  // namespace display_compositor
+}  // namespace esphome
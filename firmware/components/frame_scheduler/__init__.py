@@ -0,0 +1,55 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components.display import Display, DisplayPage
+from esphome.const import CONF_ID, CONF_AUTO_CLEAR_ENABLED, CONF_DISPLAY_ID, CONF_PAGE_ID, CONF_PAGES
+
+frame_scheduler_ns = cg.esphome_ns.namespace("frame_scheduler")
+FrameScheduler = frame_scheduler_ns.class_("FrameScheduler", cg.Component)
+
+CONF_MIN_INTERVAL = "min_interval"
+CONF_MAX_INTERVAL = "max_interval"
+CONF_NEXT_FRAME = "next_frame"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(FrameScheduler),
+        cv.GenerateID(CONF_DISPLAY_ID): cv.use_id(Display),
+        cv.Optional(CONF_MIN_INTERVAL, default="32ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MAX_INTERVAL, default="1s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_NEXT_FRAME): cv.returning_lambda,
+        cv.Optional(CONF_PAGES, default=[]): cv.ensure_list(
+            cv.Schema(
+                {
+                    cv.Required(CONF_PAGE_ID): cv.use_id(DisplayPage),
+                    cv.Required(CONF_NEXT_FRAME): cv.returning_lambda,
+                    # False for a page that only redraws what changed, like a display_compositor
+                    cv.Optional(CONF_AUTO_CLEAR_ENABLED, default=True): cv.boolean,
+                }
+            )
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    disp = await cg.get_variable(config[CONF_DISPLAY_ID])
+    cg.add(var.set_display(disp))
+
+    cg.add(var.set_min_interval(config[CONF_MIN_INTERVAL]))
+    cg.add(var.set_max_interval(config[CONF_MAX_INTERVAL]))
+
+    if CONF_NEXT_FRAME in config:
+        next_frame = await cg.process_lambda(
+            config[CONF_NEXT_FRAME], [], return_type=cg.uint32
+        )
+        cg.add(var.set_default_next_frame(next_frame))
+
+    for page_config in config[CONF_PAGES]:
+        page = await cg.get_variable(page_config[CONF_PAGE_ID])
+        next_frame = await cg.process_lambda(
+            page_config[CONF_NEXT_FRAME], [], return_type=cg.uint32
+        )
+        cg.add(var.add_page_schedule(page, next_frame, page_config[CONF_AUTO_CLEAR_ENABLED]))
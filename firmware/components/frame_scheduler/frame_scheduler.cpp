@@ -0,0 +1,91 @@
+#include "frame_scheduler.h"
+
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace frame_scheduler {
+
+static const char *TAG = "frame_scheduler.component";
+
+void FrameScheduler::setup() {
+  if (this->display_ == nullptr) {
+    ESP_LOGE(TAG, "No display attached");
+    this->mark_failed();
+    return;
+  }
+
+  this->set_interval("frame_rate", 60000, [this]() {
+    ESP_LOGD(TAG, "Drew %u frames in the last minute", this->frame_count_);
+    this->frame_count_ = 0;
+  });
+}
+
+void FrameScheduler::loop() {
+  uint32_t now = millis();
+  uint32_t since_last_frame = now - this->last_frame_;
+
+  if (this->display_->get_active_page() != this->last_page_) {
+    this->frame_requested_ = true;
+  }
+
+  if (since_last_frame < this->min_interval_) {
+    return;
+  }
+
+  bool due = this->frame_requested_ ||
+             since_last_frame >= this->max_interval_ ||
+             static_cast<int32_t>(now - this->next_frame_at_(now)) >= 0;
+
+  if (due) {
+    this->draw_frame_(now);
+  }
+}
+
+void FrameScheduler::dump_config() {
+  ESP_LOGCONFIG(TAG, "Frame Scheduler:");
+  ESP_LOGCONFIG(TAG, "  Min interval: %ums", this->min_interval_);
+  ESP_LOGCONFIG(TAG, "  Max interval: %ums", this->max_interval_);
+  ESP_LOGCONFIG(TAG, "  Scheduled pages: %u", this->page_schedules_.size());
+}
+
+const PageSchedule *FrameScheduler::schedule_for_(const display::DisplayPage *page) const {
+  for (const auto &schedule : this->page_schedules_) {
+    if (schedule.page == page) {
+      return &schedule;
+    }
+  }
+  return nullptr;
+}
+
+uint32_t FrameScheduler::next_frame_at_(uint32_t now) const {
+  const PageSchedule *schedule = this->schedule_for_(this->display_->get_active_page());
+  if (schedule != nullptr) {
+    return schedule->next_frame();
+  }
+
+  if (this->default_next_frame_) {
+    return this->default_next_frame_();
+  }
+
+  // Pages without a schedule keep the old fixed-rate behavior
+  return now;
+}
+
+void HOT FrameScheduler::draw_frame_(uint32_t now) {
+  const display::DisplayPage *page = this->display_->get_active_page();
+  const PageSchedule *schedule = this->schedule_for_(page);
+  // Only a page that drew the previous frame itself can build on it
+  this->frame_cleared_ = schedule == nullptr || schedule->auto_clear || page != this->last_page_;
+  this->display_->set_auto_clear(this->frame_cleared_);
+
+  this->last_page_ = page;
+  this->frame_requested_ = false;
+  this->last_frame_ = now;
+  this->frame_count_++;
+
+  this->display_->update();
+}
+
+}  // namespace frame_scheduler
+}  // namespace esphome
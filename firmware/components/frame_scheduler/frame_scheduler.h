@@ -0,0 +1,73 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/components/display/display.h"
+
+namespace esphome {
+namespace frame_scheduler {
+
+// Returns the millis() instant at which the rendered output next changes.
+using NextFrameFunc = std::function<uint32_t()>;
+
+struct PageSchedule {
+  const display::DisplayPage *page;
+  NextFrameFunc next_frame;
+  // False for a page that draws over its own previous frame
+  bool auto_clear;
+};
+
+// Drives a display whose `update_interval` is `never`, redrawing only when the
+// active page reports that its output changes. Frames are never closer than
+// `min_interval` and never further apart than `max_interval`, so state that
+// isn't tracked by a deadline (network status, errors) still shows up.
+//
+// A page scheduled without auto_clear is drawn over its previous frame, so it
+// only needs to redraw what changed. Its first frame after a page switch is
+// still cleared.
+class FrameScheduler : public Component {
+  public:
+    void setup() override;
+    void loop() override;
+    void dump_config() override;
+
+    // Run after the trackers so a deadline they move in loop() is seen this iteration
+    float get_setup_priority() const override { return setup_priority::LATE; }
+
+    void request_frame() { this->frame_requested_ = true; }
+
+    void set_display(display::Display *display) { display_ = display; }
+    void set_min_interval(uint32_t min_interval) { min_interval_ = min_interval; }
+    void set_max_interval(uint32_t max_interval) { max_interval_ = max_interval; }
+    void set_default_next_frame(NextFrameFunc next_frame) { default_next_frame_ = std::move(next_frame); }
+    void add_page_schedule(const display::DisplayPage *page, NextFrameFunc next_frame, bool auto_clear = true) {
+      page_schedules_.push_back(PageSchedule{page, std::move(next_frame), auto_clear});
+    }
+
+    uint32_t get_frame_count() const { return frame_count_; }
+    // Whether the frame being drawn started from a cleared display
+    bool is_frame_cleared() const { return frame_cleared_; }
+
+  protected:
+    const PageSchedule *schedule_for_(const display::DisplayPage *page) const;
+    uint32_t next_frame_at_(uint32_t now) const;
+    void draw_frame_(uint32_t now);
+
+    display::Display *display_ = nullptr;
+    uint32_t min_interval_ = 32;
+    uint32_t max_interval_ = 1000;
+
+    NextFrameFunc default_next_frame_;
+    std::vector<PageSchedule> page_schedules_;
+
+    const display::DisplayPage *last_page_ = nullptr;
+    uint32_t last_frame_ = 0;
+    uint32_t frame_count_ = 0;
+    bool frame_requested_ = true;
+    bool frame_cleared_ = true;
+};
+
+}  // namespace frame_scheduler
+}  // namespace esphome
@@ -0,0 +1,60 @@
+import re
+from pathlib import Path
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_SPEED
+
+# A strip of logos from the built-in logo atlas (matrix_render/logo_atlas.h),
+# named as in the atlas, scrolling horizontally across the display. The strip
+# is rendered once at setup; pages draw it with `id(marquee).draw(it);` and the
+# frame_scheduler asks `id(marquee).get_next_frame_at()` when it next moves.
+
+AUTO_LOAD = ["matrix_render", "memory_placement"]
+
+logo_marquee_ns = cg.esphome_ns.namespace("logo_marquee")
+LogoMarquee = logo_marquee_ns.class_("LogoMarquee", cg.Component)
+
+CONF_LOGOS = "logos"
+CONF_GAP = "gap"
+CONF_SUBPIXEL_STEPS = "subpixel_steps"
+
+LOGO_ATLAS_PATH = Path(__file__).resolve().parent.parent / "matrix_render" / "logo_atlas.h"
+
+
+def atlas_names():
+    """Names of the logos in the built-in logo atlas."""
+    return re.findall(r'^\s*\{"([^"]+)", \{', LOGO_ATLAS_PATH.read_text(), re.M)
+
+
+def validate_logo_name(value):
+    value = cv.string(value)
+    names = atlas_names()
+    if value not in names:
+        raise cv.Invalid(f"'{value}' is not in the logo atlas; choose from {', '.join(names)}")
+    return value
+
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(LogoMarquee),
+        cv.Required(CONF_LOGOS): cv.All(cv.ensure_list(validate_logo_name), cv.Length(min=1)),
+        # Pixels per second
+        cv.Optional(CONF_SPEED, default=6): cv.positive_float,
+        cv.Optional(CONF_GAP, default=2): cv.int_range(min=0, max=64),
+        # Positions per pixel; between whole pixels, neighboring columns are blended
+        cv.Optional(CONF_SUBPIXEL_STEPS, default=4): cv.int_range(min=1, max=16),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_speed(config[CONF_SPEED]))
+    cg.add(var.set_gap(config[CONF_GAP]))
+    cg.add(var.set_subpixel_steps(config[CONF_SUBPIXEL_STEPS]))
+
+    for name in config[CONF_LOGOS]:
+        cg.add(var.add_logo(name))
@@ -0,0 +1,156 @@
+#include "logo_marquee.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/components/matrix_render/logo_atlas.h"
+#include "esphome/components/matrix_render/span_buffer.h"
+#include "esphome/components/memory_placement/placement.h"
+
+namespace esphome {
+namespace logo_marquee {
+
+static const char *TAG = "logo_marquee";
+
+// Transparent pixels are stored as 0, so opaque black is nudged to the
+// darkest non-zero green
+static constexpr uint16_t TRANSPARENT = 0x0000;
+static constexpr uint16_t OPAQUE_BLACK = 0x0020;
+
+// Mix two RGB565 pixels, weight/steps of the way from a to b
+static inline uint16_t blend_rgb565(uint16_t a, uint16_t b, int weight, int steps) {
+  int inverse = steps - weight;
+  int r = (((a >> 11) & 0x1F) * inverse + ((b >> 11) & 0x1F) * weight) / steps;
+  int g = (((a >> 5) & 0x3F) * inverse + ((b >> 5) & 0x3F) * weight) / steps;
+  int bl = ((a & 0x1F) * inverse + (b & 0x1F) * weight) / steps;
+  return (r << 11) | (g << 5) | bl;
+}
+
+// Call plot(x, rgb565) for each covered pixel of a strip row scrolled to offset
+template<typename Plot>
+static inline void scan_row(const uint16_t *src, int strip_width, int offset, int fraction, int steps, int width,
+                            Plot plot) {
+  int col = offset;
+  for (int x = 0; x < width; x++) {
+    int next = col + 1 == strip_width ? 0 : col + 1;
+    uint16_t left = src[col];
+    if (fraction == 0) {
+      if (left != TRANSPARENT) {
+        plot(x, left);
+      }
+    } else {
+      uint16_t right = src[next];
+      if (left != TRANSPARENT || right != TRANSPARENT) {
+        plot(x, blend_rgb565(left, right, fraction, steps));
+      }
+    }
+    col = next;
+  }
+}
+
+void LogoMarquee::add_logo(const std::string &name) {
+  for (const auto &logo : matrix_render::LOGO_ATLAS) {
+    if (name == logo.name) {
+      this->logos_.push_back(&logo.image);
+      return;
+    }
+  }
+  ESP_LOGW(TAG, "No logo named '%s' in the atlas", name.c_str());
+}
+
+void LogoMarquee::setup() {
+  this->steps_per_second_ = std::max<uint32_t>(1, lroundf(this->speed_ * this->subpixel_steps_));
+
+  for (auto *logo : this->logos_) {
+    this->strip_width_ += logo->width + this->gap_;
+    this->strip_height_ = std::max<int>(this->strip_height_, logo->height);
+  }
+
+  size_t size = (size_t) this->strip_width_ * this->strip_height_ * sizeof(uint16_t);
+  this->strip_ = static_cast<uint16_t *>(memory_placement::allocate(memory_placement::CATEGORY_IMAGE_CACHE, size));
+  if (this->strip_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate %u bytes for the logo strip", (unsigned) size);
+    this->mark_failed();
+    return;
+  }
+  memset(this->strip_, 0, size);
+
+  // Decode every logo once, centered vertically in the strip
+  int strip_x = 0;
+  for (auto *logo : this->logos_) {
+    int top = (this->strip_height_ - logo->height) / 2;
+    const uint8_t *runs = logo->runs;
+    for (int row = 0; row < logo->height; row++) {
+      uint16_t *dest = this->strip_ + (top + row) * this->strip_width_ + strip_x;
+      runs = matrix_render::rle_decode_row(*logo, runs, [&](int col, int length, uint8_t index) {
+        if (index != matrix_render::RLE_TRANSPARENT) {
+          uint16_t rgb565 = logo->palette[index];
+          std::fill_n(dest + col, length, rgb565 == TRANSPARENT ? OPAQUE_BLACK : rgb565);
+        }
+      });
+    }
+    strip_x += logo->width + this->gap_;
+  }
+}
+
+void LogoMarquee::dump_config() {
+  ESP_LOGCONFIG(TAG, "Logo Marquee:");
+  ESP_LOGCONFIG(TAG, "  Logos: %u", (unsigned) this->logos_.size());
+  ESP_LOGCONFIG(TAG, "  Strip: %dx%d", this->strip_width_, this->strip_height_);
+  ESP_LOGCONFIG(TAG, "  Speed: %.1f px/s in %d sub-pixel steps", this->speed_, this->subpixel_steps_);
+}
+
+void HOT LogoMarquee::draw(display::Display &it) {
+  if (this->strip_ == nullptr) {
+    return;
+  }
+
+  const int steps = this->subpixel_steps_;
+  uint64_t position = this->position_(millis());
+  int offset = (position / steps) % this->strip_width_;
+  int fraction = position % steps;
+
+  int width = std::min(it.get_width(), matrix_render::MAX_SPAN_WIDTH);
+  int y = (it.get_height() - this->strip_height_) / 2;
+
+  if (matrix_render::copies_rows(&it)) {
+    this->draw_spans_(it, y, width, offset, fraction);
+    return;
+  }
+
+  for (int row = 0; row < this->strip_height_; row++) {
+    const uint16_t *src = this->strip_ + row * this->strip_width_;
+    scan_row(src, this->strip_width_, offset, fraction, steps, width, [&](int x, uint16_t rgb565) {
+      it.draw_pixel_at(x, y + row, matrix_render::SpanBuffer::to_color(rgb565));
+    });
+  }
+}
+
+void HOT LogoMarquee::draw_spans_(display::Display &it, int y, int width, int offset, int fraction) {
+  matrix_render::SpanBuffer span;
+  for (int row = 0; row < this->strip_height_; row++) {
+    const uint16_t *src = this->strip_ + row * this->strip_width_;
+    span.begin(0, width);
+    scan_row(src, this->strip_width_, offset, fraction, this->subpixel_steps_, width,
+             [&](int x, uint16_t rgb565) { span.set_rgb565(x, rgb565); });
+    span.flush(&it, y + row);
+  }
+}
+
+uint32_t LogoMarquee::get_next_frame_at() const {
+  uint32_t now = millis();
+  if (this->strip_ == nullptr) {
+    return now + 1000;
+  }
+
+  // Round up to the first millisecond of the next step
+  uint64_t next_step = this->position_(now) + 1;
+  return (uint32_t) ((next_step * 1000 + this->steps_per_second_ - 1) / this->steps_per_second_);
+}
+
+}  // namespace logo_marquee
+}  // namespace esphome
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/components/display/display.h"
+#include "esphome/components/matrix_render/rle_image.h"
+
+namespace esphome {
+namespace logo_marquee {
+
+// Scrolls a strip of logos from the logo atlas across the display. The strip is
+// rendered once into a ring buffer of RGB565 pixels; each frame copies the
+// visible window out of it, blending neighboring columns for positions
+// between whole pixels.
+class LogoMarquee : public Component {
+  public:
+    void setup() override;
+    void dump_config() override;
+
+    // Add the atlas logo of that name to the end of the strip
+    void add_logo(const std::string &name);
+    void set_speed(float speed) { speed_ = speed; }
+    void set_gap(int gap) { gap_ = gap; }
+    void set_subpixel_steps(int subpixel_steps) { subpixel_steps_ = subpixel_steps; }
+
+    // Draw the strip across the full width, centered vertically
+    void draw(display::Display &it);
+
+    // The millis() instant at which the strip next moves
+    uint32_t get_next_frame_at() const;
+
+  protected:
+    // Scroll position in sub-pixel steps
+    uint64_t position_(uint32_t now) const { return (uint64_t) now * this->steps_per_second_ / 1000; }
+    // The span path for displays that copy rows, kept out of draw() so its
+    // SpanBuffer is only on the stack when used
+    void __attribute__((noinline)) draw_spans_(display::Display &it, int y, int width, int offset, int fraction);
+
+    std::vector<const matrix_render::RleImage *> logos_;
+    float speed_ = 6.0f;
+    int gap_ = 2;
+    int subpixel_steps_ = 4;
+    uint32_t steps_per_second_ = 24;
+
+    // strip_width_ x strip_height_ pixels, 0 where transparent
+    uint16_t *strip_ = nullptr;
+    int strip_width_ = 0;
+    int strip_height_ = 0;
+};
+
+}  // namespace logo_marquee
+}  // namespace esphome
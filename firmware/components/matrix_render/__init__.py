@@ -0,0 +1,15 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+
+# Shared rendering helpers for the tracker components. Loaded through
+# AUTO_LOAD; there is nothing to configure.
+
+AUTO_LOAD = ["memory_placement"]
+
+matrix_render_ns = cg.esphome_ns.namespace("matrix_render")
+
+CONFIG_SCHEMA = cv.Schema({})
+
+
+async def to_code(config):
+    cg.add_define("USE_MATRIX_RENDER")
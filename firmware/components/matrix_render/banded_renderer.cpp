@@ -0,0 +1,226 @@
+#include "banded_renderer.h"
+#include "span_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+
+#ifdef USE_ESP32
+#include <esp_pthread.h>
+#endif
+
+namespace esphome {
+namespace matrix_render {
+
+static const char *TAG = "matrix_render.banded";
+
+BandCanvas::BandCanvas() { register_row_copy(this); }
+
+BandCanvas::~BandCanvas() { unregister_row_copy(this); }
+
+void BandCanvas::set_frame(uint16_t *buffer, int width, int height, int y_start, int y_end) {
+  this->buffer_ = buffer;
+  this->width_ = width;
+  this->height_ = height;
+  this->y_start_ = y_start;
+  this->y_end_ = y_end;
+}
+
+bool BandCanvas::accepts_(int x, int y) const {
+  if (x < 0 || x >= this->width_ || y < this->y_start_ || y >= this->y_end_) {
+    return false;
+  }
+
+  if (this->is_clipping()) {
+    display::Rect clip = this->get_clipping();
+    return x >= clip.x && x < clip.x2() && y >= clip.y && y < clip.y2();
+  }
+
+  return true;
+}
+
+void HOT BandCanvas::draw_pixel_at(int x, int y, Color color) {
+  if (this->accepts_(x, y)) {
+    this->buffer_[y * this->width_ + x] = SpanBuffer::to_rgb565(color);
+  }
+}
+
+void HOT BandCanvas::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
+                                    display::ColorOrder order, display::ColorBitness bitness, bool big_endian,
+                                    int x_offset, int y_offset, int x_pad) {
+  if (bitness != display::COLOR_BITNESS_565 || order != display::COLOR_ORDER_RGB) {
+    display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
+                                     x_pad);
+    return;
+  }
+
+  // Rows are copied straight into the back buffer, clipped once per row
+  const int stride = x_offset + w + x_pad;
+  const uint16_t *src = reinterpret_cast<const uint16_t *>(ptr);
+  for (int row = 0; row < h; row++) {
+    int y = y_start + row;
+    int x1 = x_start, x2 = x_start + w;
+    if (y < this->y_start_ || y >= this->y_end_ || !clip_span(this, y, x1, x2)) {
+      continue;
+    }
+
+    const uint16_t *line = src + (y_offset + row) * stride + x_offset + (x1 - x_start);
+    uint16_t *dest = &this->buffer_[y * this->width_ + x1];
+    if (big_endian) {
+      for (int i = 0; i < x2 - x1; i++) {
+        dest[i] = (line[i] >> 8) | (line[i] << 8);
+      }
+    } else {
+      memcpy(dest, line, (x2 - x1) * sizeof(uint16_t));
+    }
+  }
+}
+
+void BandCanvas::fill(Color color) {
+  uint16_t rgb565 = SpanBuffer::to_rgb565(color);
+  uint16_t *start = &this->buffer_[this->y_start_ * this->width_];
+  std::fill(start, start + (this->y_end_ - this->y_start_) * this->width_, rgb565);
+}
+
+BandedRenderer::BandedRenderer(int bands) : bands_(std::max(1, bands)) {
+  for (int band = 0; band < this->bands_; band++) {
+    this->canvases_.emplace_back(new BandCanvas());
+  }
+
+  for (int band = 0; band < this->bands_ - 1; band++) {
+#ifdef USE_ESP32
+    // The main loop runs on core 1, so the first worker gets core 0 to itself
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+    cfg.thread_name = "band_render";
+    cfg.pin_to_core = band % 2 == 0 ? 0 : 1;
+    // Drawing a band holds a SpanBuffer (over 1 KB) on the stack while it blits
+    cfg.stack_size = 6144 + sizeof(SpanBuffer);
+    esp_pthread_set_cfg(&cfg);
+#endif
+    this->workers_.emplace_back(&BandedRenderer::worker_loop_, this, band);
+  }
+}
+
+BandedRenderer::~BandedRenderer() {
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->stopping_ = true;
+  }
+  this->start_cv_.notify_all();
+
+  for (auto &worker : this->workers_) {
+    worker.join();
+  }
+}
+
+bool BandedRenderer::ensure_buffer_(int width, int height, int y_start, int y_end) {
+  if (this->back_buffer_ == nullptr || width != this->width_ || height != this->height_) {
+    this->back_buffer_.reset(new (std::nothrow) uint16_t[width * height]);
+    if (this->back_buffer_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate %dx%d back buffer", width, height);
+      return false;
+    }
+
+    this->width_ = width;
+    this->height_ = height;
+  } else if (y_start == this->y_start_ && y_end == this->y_end_) {
+    return true;
+  }
+
+  this->y_start_ = y_start;
+  this->y_end_ = y_end;
+
+  for (int band = 0; band < this->bands_; band++) {
+    int band_start = y_start + (y_end - y_start) * band / this->bands_;
+    int band_end = y_start + (y_end - y_start) * (band + 1) / this->bands_;
+    this->canvases_[band]->set_frame(this->back_buffer_.get(), width, height, band_start, band_end);
+  }
+
+  return true;
+}
+
+void HOT BandedRenderer::render_band_(int band) {
+  BandCanvas &canvas = *this->canvases_[band];
+  canvas.fill(Color(0, 0, 0));
+  canvas.start_clipping(0, canvas.get_band_start(), canvas.get_width(), canvas.get_band_end());
+  (*this->draw_)(canvas);
+  canvas.end_clipping();
+}
+
+void BandedRenderer::worker_loop_(int band) {
+  uint32_t seen_generation = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex_);
+      this->start_cv_.wait(lock, [&]() { return this->stopping_ || this->generation_ != seen_generation; });
+      if (this->stopping_) {
+        return;
+      }
+      seen_generation = this->generation_;
+    }
+
+    this->render_band_(band);
+
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->pending_--;
+    }
+    this->done_cv_.notify_one();
+  }
+}
+
+void HOT BandedRenderer::render(display::Display *target, const BandFunc &draw, int y_start, int y_end) {
+  y_start = std::max(y_start, 0);
+  y_end = std::min(y_end, target->get_height());
+  if (y_start >= y_end) {
+    return;
+  }
+
+  if (!this->ensure_buffer_(target->get_width(), target->get_height(), y_start, y_end)) {
+    draw(*target);
+    return;
+  }
+
+  uint32_t started = micros();
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    this->draw_ = &draw;
+    this->pending_ = this->workers_.size();
+    this->generation_++;
+  }
+  this->start_cv_.notify_all();
+
+  this->render_band_(this->bands_ - 1);
+
+  {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->done_cv_.wait(lock, [this]() { return this->pending_ == 0; });
+    this->draw_ = nullptr;
+  }
+
+  // Flip: the finished rows go out in one blit
+  uint32_t rasterized = micros();
+  target->draw_pixels_at(0, y_start, this->width_, y_end - y_start,
+                         reinterpret_cast<const uint8_t *>(this->back_buffer_.get()), display::COLOR_ORDER_RGB,
+                         display::COLOR_BITNESS_565, false, 0, y_start, 0);
+  uint32_t flipped = micros();
+
+  this->raster_total_us_ += rasterized - started;
+  this->flip_total_us_ += flipped - rasterized;
+  if (++this->frames_ == LOG_INTERVAL) {
+    this->raster_us_ = this->raster_total_us_ / LOG_INTERVAL;
+    this->flip_us_ = this->flip_total_us_ / LOG_INTERVAL;
+    ESP_LOGD(TAG, "%dx%d rows in %d bands: %uus rasterizing, %uus flipping", this->width_,
+             this->y_end_ - this->y_start_, this->bands_, (unsigned) this->raster_us_, (unsigned) this->flip_us_);
+    this->frames_ = 0;
+    this->raster_total_us_ = 0;
+    this->flip_total_us_ = 0;
+  }
+}
+
+}  // namespace matrix_render
+}  // namespace esphome
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "esphome/components/display/display.h"
+
+namespace esphome {
+namespace matrix_render {
+
+// An off-screen RGB565 frame that only accepts pixels inside one horizontal band.
+// It reports the full frame size, so layout code runs unchanged; the band is also
+// pushed as a clipping rectangle so callers can cull rows that fall outside it.
+class BandCanvas : public display::Display {
+  public:
+    // Registered with register_row_copy(), so spans are blitted into it
+    BandCanvas();
+    BandCanvas(const BandCanvas &) = delete;
+    BandCanvas &operator=(const BandCanvas &) = delete;
+    ~BandCanvas() override;
+
+    void set_frame(uint16_t *buffer, int width, int height, int y_start, int y_end);
+
+    int get_band_start() const { return y_start_; }
+    int get_band_end() const { return y_end_; }
+
+    using display::Display::draw_pixel_at;
+    void draw_pixel_at(int x, int y, Color color) override;
+    void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                        display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override;
+    void fill(Color color) override;
+
+    display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
+    void update() override {}
+
+  protected:
+    int get_width_internal() override { return width_; }
+    int get_height_internal() override { return height_; }
+
+    bool accepts_(int x, int y) const;
+
+    uint16_t *buffer_ = nullptr;
+    int width_ = 0;
+    int height_ = 0;
+    int y_start_ = 0;
+    int y_end_ = 0;
+};
+
+// Rasterizes a frame in horizontal bands, one per worker, into a back buffer and
+// then flips the finished frame to the real display in a single blit. The calling
+// thread renders the last band itself. On the ESP32 the first worker is pinned to
+// the core that isn't running the main loop; elsewhere the workers are a plain
+// thread pool.
+//
+// Only the rows given to render() are rasterized and flipped, so whatever else
+// is on the display is left alone; within them the bands start out black and
+// overwrite what was there. The flip is one draw_pixels_at() call, which is
+// only fast if the display overrides it; the HUB75 driver doesn't, so every
+// pixel of those rows goes through draw_pixel_at() again. The time spent
+// rasterizing and flipping is logged every LOG_INTERVAL frames so the trade can
+// be checked on the device (host/band_benchmark.cpp measures it on the host).
+class BandedRenderer {
+  public:
+    using BandFunc = std::function<void(display::Display &band)>;
+
+    explicit BandedRenderer(int bands);
+    ~BandedRenderer();
+
+    static constexpr uint32_t LOG_INTERVAL = 256;
+
+    int get_bands() const { return bands_; }
+    // Averages over the last LOG_INTERVAL frames, in microseconds
+    uint32_t get_raster_us() const { return raster_us_; }
+    uint32_t get_flip_us() const { return flip_us_; }
+
+    // Draw rows y_start to y_end (exclusive) of the target in bands
+    void render(display::Display *target, const BandFunc &draw, int y_start, int y_end);
+    void render(display::Display *target, const BandFunc &draw) { this->render(target, draw, 0, target->get_height()); }
+
+  protected:
+    bool ensure_buffer_(int width, int height, int y_start, int y_end);
+    void render_band_(int band);
+    void worker_loop_(int band);
+
+    int bands_;
+    int width_ = 0;
+    int height_ = 0;
+    int y_start_ = 0;
+    int y_end_ = 0;
+    std::unique_ptr<uint16_t[]> back_buffer_;
+    std::vector<std::unique_ptr<BandCanvas>> canvases_;
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint32_t generation_ = 0;
+    int pending_ = 0;
+    bool stopping_ = false;
+    const BandFunc *draw_ = nullptr;
+
+    uint32_t frames_ = 0;
+    uint64_t raster_total_us_ = 0;
+    uint64_t flip_total_us_ = 0;
+    uint32_t raster_us_ = 0;
+    uint32_t flip_us_ = 0;
+};
+
+}  // namespace matrix_render
+}  // namespace esphome
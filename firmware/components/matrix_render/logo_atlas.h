@@ -0,0 +1,254 @@
+#pragma once
+
+// Generated by firmware/logos/build_logo_atlas.py from logos/teams_resized; do not edit.
+// 31 logos, 458 bytes of palettes, 2827 bytes of runs
+
+#include "esphome/components/matrix_render/rle_image.h"
+
+namespace esphome {
+namespace matrix_render {
+
+struct AtlasLogo {
+  const char *name;
+  RleImage image;
+};
+
+static constexpr uint16_t LOGO_ATLAS_PALETTES[] = {
+    0x0000, 0x2944, 0x62C8, 0x6AE8, 0x7306, 0x8BCA, 0x8BEA, 0xA106, 0xACAC, 0x0000, 0x0000, 0x0263,
+    0x0588, 0xFFFF, 0x0000, 0x0000, 0x01F4, 0x9492, 0xC639, 0xFFFF, 0x0000, 0x0000, 0x0439, 0xFFFF,
+    0x0000, 0x10C8, 0x7E7D, 0xF800, 0xFFFF, 0x0000, 0x31E9, 0x5391, 0x8926, 0x8DBD, 0x94D3, 0xC639,
+    0xFFFF, 0x0000, 0x0000, 0xFEE0, 0xFFFF, 0x0000, 0x2923, 0x2924, 0x2944, 0x62EB, 0x9CD2, 0xE805,
+    0xFFFF, 0x0000, 0x00A7, 0x00E8, 0x0190, 0xFA80, 0xFFDF, 0xFFFF, 0x0000, 0x00EB, 0x010C, 0x8CD6,
+    0x9517, 0xC047, 0xE75D, 0xFFDF, 0xFFFF, 0x0000, 0x10C4, 0x4963, 0xBDF7, 0xFB40, 0xFFFF, 0x0000,
+    0x20E4, 0x2945, 0x41E7, 0xB5B6, 0xCE79, 0xF5B9, 0xFFFF, 0x0000, 0x0000, 0xB48C, 0xC4ED, 0x0000,
+    0x0250, 0x09AC, 0x1149, 0x21AA, 0x2A0B, 0x3A6D, 0xDEDC, 0xED40, 0xED60, 0xFE60, 0xFFFF, 0x0000,
+    0x20E4, 0x2924, 0x9E7C, 0x9E9D, 0xA6BD, 0xA6DE, 0xBDD7, 0xE71B, 0xEF5C, 0x0000, 0xFFFF, 0x7559,
+    0x7455, 0x018D, 0x014C, 0xD903, 0xD103, 0xC903, 0xC104, 0xB104, 0xA904, 0x8105, 0x00EB, 0x0000,
+    0x18A8, 0x5AA8, 0xEF47, 0x0000, 0x0908, 0x21AA, 0xC865, 0xF7DF, 0xFFFF, 0x0000, 0x0005, 0x0025,
+    0x0866, 0x10A7, 0x29AB, 0x3A4E, 0x42D0, 0x9E9F, 0xEAC7, 0xFFFF, 0x0000, 0x194A, 0xB8E6, 0xD34E,
+    0xD3F0, 0xF7BE, 0xFE25, 0xFF7E, 0xFFFF, 0x0000, 0x6133, 0x6153, 0xF690, 0xFFFF, 0x0000, 0x00E5,
+    0x08E5, 0x0906, 0x3C7B, 0x9CAF, 0xDE74, 0xE694, 0x0000, 0x2A86, 0x5B24, 0x6B63, 0xCCA0, 0xFFFF,
+    0x0000, 0x00EC, 0x9026, 0xA026, 0xA4A5, 0xBD45, 0xF683, 0xFFFF, 0x0000, 0x00A5, 0x02B4, 0x6BCF,
+    0x9D15, 0xF4A3, 0xFFFF, 0x0000, 0x0000, 0x0021, 0x01F4, 0x10A2, 0x2104, 0x73AF, 0x7BCF, 0x9CD3,
+    0xCE59, 0xF7BE, 0xFFFF, 0x0000, 0x0194, 0x4DC9, 0x76FA, 0x7EFA, 0x0000, 0x0908, 0x1148, 0x6BD1,
+    0x6C55, 0x7CD7, 0x8C71, 0xA63D, 0xFFFF, 0x0000, 0x00A8, 0x08E9, 0xE8AB, 0xFFDF, 0xFFFF, 0x0000,
+    0x31E9, 0xA555, 0xA8A5, 0xA8C5, 0xA927, 0xFFDF, 0xFFFF, 0x0000, 0x1149, 0x2A0B, 0x8DBD, 0x9CD3,
+    0xFFFF,
+};
+
+static constexpr uint8_t LOGO_ATLAS_RUNS[] = {
+    0x30, 0x01, 0x08, 0x11, 0x08, 0x01, 0x30, 0x20, 0x41, 0x08, 0x11, 0x20, 0x10, 0x31, 0x18, 0x31,
+    0x10, 0x00, 0x41, 0x17, 0x41, 0x00, 0x21, 0x07, 0x11, 0x18, 0x11, 0x07, 0x21, 0x05, 0x08, 0x01,
+    0x07, 0x01, 0x08, 0x14, 0x08, 0x01, 0x07, 0x01, 0x08, 0x06, 0x11, 0x08, 0x07, 0x01, 0x08, 0x14,
+    0x08, 0x01, 0x07, 0x08, 0x11, 0x11, 0x08, 0x07, 0x01, 0x08, 0x14, 0x08, 0x01, 0x07, 0x08, 0x11,
+    0x02, 0x08, 0x01, 0x07, 0x08, 0x04, 0x18, 0x04, 0x08, 0x07, 0x01, 0x08, 0x03, 0x21, 0x07, 0x08,
+    0x34, 0x08, 0x07, 0x21, 0x00, 0x21, 0x08, 0x04, 0x17, 0x04, 0x08, 0x21, 0x00, 0x10, 0x31, 0x18,
+    0x11, 0x08, 0x01, 0x10, 0x20, 0x01, 0x08, 0x51, 0x20, 0x30, 0x51, 0x30, 0x10, 0x91, 0x10, 0x10,
+    0x01, 0x04, 0x01, 0x14, 0x01, 0x04, 0x21, 0x10, 0x10, 0x21, 0x04, 0x31, 0x04, 0x01, 0x10, 0x10,
+    0x91, 0x10, 0x10, 0x31, 0x13, 0x31, 0x10, 0x10, 0x11, 0x13, 0x11, 0x13, 0x11, 0x10, 0x10, 0x01,
+    0x73, 0x01, 0x10, 0x10, 0x11, 0x13, 0x11, 0x13, 0x11, 0x10, 0x10, 0x11, 0x03, 0x01, 0x13, 0x01,
+    0x03, 0x11, 0x10, 0x10, 0x03, 0x21, 0x13, 0x02, 0x11, 0x03, 0x10, 0x10, 0x31, 0x13, 0x31, 0x10,
+    0x10, 0x93, 0x10, 0x20, 0x13, 0x01, 0x13, 0x01, 0x13, 0x20, 0x40, 0x31, 0x40, 0x30, 0x14, 0x11,
+    0x14, 0x30, 0x20, 0x01, 0x52, 0x01, 0x20, 0x10, 0x01, 0x12, 0x05, 0x22, 0x05, 0x02, 0x01, 0x10,
+    0x00, 0x01, 0x22, 0x04, 0x11, 0x04, 0x22, 0x01, 0x00, 0x04, 0x02, 0x05, 0x02, 0x51, 0x02, 0x05,
+    0x02, 0x04, 0x04, 0x12, 0x04, 0x02, 0x01, 0x04, 0x05, 0x01, 0x02, 0x04, 0x12, 0x04, 0x01, 0x12,
+    0x01, 0x02, 0x01, 0x04, 0x05, 0x01, 0x02, 0x01, 0x12, 0x01, 0x01, 0x12, 0x01, 0x05, 0x01, 0x04,
+    0x05, 0x01, 0x05, 0x01, 0x12, 0x01, 0x14, 0x01, 0x14, 0x05, 0x04, 0x15, 0x14, 0x01, 0x14, 0x04,
+    0x11, 0x02, 0x51, 0x02, 0x11, 0x04, 0x00, 0x11, 0x12, 0x04, 0x11, 0x04, 0x12, 0x11, 0x00, 0x10,
+    0x01, 0x12, 0x31, 0x12, 0x01, 0x10, 0x20, 0x01, 0x02, 0x01, 0x05, 0x03, 0x01, 0x02, 0x01, 0x20,
+    0x30, 0x14, 0x11, 0x14, 0x30, 0x30, 0x11, 0x13, 0x11, 0x30, 0x20, 0x13, 0x41, 0x03, 0x20, 0x10,
+    0x11, 0x03, 0x31, 0x03, 0x11, 0x10, 0x00, 0x03, 0x01, 0x03, 0x01, 0x32, 0x11, 0x13, 0x00, 0x31,
+    0x52, 0x31, 0x01, 0x02, 0x01, 0x72, 0x21, 0x03, 0x11, 0x02, 0x03, 0x02, 0x13, 0x02, 0x03, 0x02,
+    0x01, 0x02, 0x03, 0x03, 0x02, 0x01, 0x12, 0x33, 0x12, 0x01, 0x02, 0x03, 0x21, 0x12, 0x33, 0x12,
+    0x21, 0x31, 0x12, 0x13, 0x12, 0x31, 0x00, 0x03, 0x21, 0x32, 0x11, 0x13, 0x00, 0x10, 0x61, 0x03,
+    0x11, 0x10, 0x20, 0x03, 0x01, 0x03, 0x31, 0x03, 0x20, 0x30, 0x11, 0x13, 0x11, 0x30, 0x30, 0x51,
+    0x30, 0x20, 0x01, 0x04, 0x32, 0x04, 0x01, 0x20, 0x10, 0x04, 0x72, 0x04, 0x10, 0x00, 0x01, 0x02,
+    0x04, 0x02, 0x34, 0x02, 0x04, 0x02, 0x01, 0x00, 0x01, 0x04, 0x12, 0x04, 0x33, 0x04, 0x12, 0x04,
+    0x01, 0x01, 0x12, 0x04, 0x03, 0x34, 0x03, 0x04, 0x12, 0x01, 0x01, 0x12, 0x04, 0x03, 0x04, 0x13,
+    0x24, 0x12, 0x01, 0x01, 0x12, 0x04, 0x03, 0x04, 0x13, 0x24, 0x12, 0x01, 0x01, 0x12, 0x04, 0x03,
+    0x34, 0x03, 0x04, 0x12, 0x01, 0x01, 0x04, 0x12, 0x04, 0x33, 0x04, 0x12, 0x04, 0x01, 0x00, 0x01,
+    0x02, 0x04, 0x02, 0x34, 0x02, 0x04, 0x02, 0x01, 0x00, 0x10, 0x04, 0x72, 0x04, 0x10, 0x20, 0x01,
+    0x04, 0x32, 0x04, 0x01, 0x20, 0x30, 0x51, 0x30, 0x50, 0x16, 0x50, 0x40, 0x06, 0x14, 0x06, 0x40,
+    0x30, 0x03, 0x04, 0x13, 0x04, 0x03, 0x30, 0x20, 0x03, 0x06, 0x33, 0x06, 0x03, 0x20, 0x10, 0x06,
+    0x53, 0x07, 0x03, 0x06, 0x10, 0x10, 0x16, 0x43, 0x07, 0x16, 0x10, 0x20, 0x04, 0x53, 0x04, 0x20,
+    0x20, 0x13, 0x07, 0x05, 0x02, 0x07, 0x13, 0x20, 0x20, 0x26, 0x17, 0x04, 0x16, 0x20, 0x30, 0x03,
+    0x01, 0x06, 0x04, 0x01, 0x03, 0x30, 0x30, 0x06, 0x04, 0x11, 0x04, 0x06, 0x30, 0x40, 0x03, 0x14,
+    0x03, 0x40, 0x50, 0x13, 0x50, 0xD0, 0x20, 0x03, 0x30, 0x13, 0x30, 0xD0, 0x20, 0x71, 0x20, 0x20,
+    0x02, 0x53, 0x02, 0x20, 0x20, 0x02, 0x13, 0x11, 0x13, 0x02, 0x20, 0x20, 0x02, 0x13, 0x31, 0x02,
+    0x20, 0x30, 0x13, 0x31, 0x30, 0x30, 0x01, 0x03, 0x11, 0x03, 0x01, 0x30, 0x30, 0x01, 0x03, 0x01,
+    0x13, 0x01, 0x30, 0x30, 0x01, 0x23, 0x11, 0x30, 0x30, 0x01, 0x13, 0x01, 0x03, 0x01, 0x30, 0x30,
+    0x11, 0x12, 0x11, 0x30, 0x30, 0x02, 0x30, 0x02, 0x30, 0xD0, 0x10, 0x03, 0x77, 0x03, 0x10, 0x10,
+    0x07, 0x02, 0x07, 0x03, 0x07, 0x03, 0x17, 0x03, 0x07, 0x10, 0x03, 0x17, 0x02, 0x04, 0x03, 0x07,
+    0x03, 0x17, 0x03, 0x17, 0x03, 0x00, 0x23, 0x07, 0x33, 0x07, 0x23, 0x00, 0x00, 0x53, 0x05, 0x43,
+    0x00, 0x00, 0x13, 0x07, 0x03, 0x27, 0x13, 0x07, 0x13, 0x00, 0x00, 0x07, 0x33, 0x07, 0x43, 0x07,
+    0x00, 0x00, 0x13, 0x07, 0x53, 0x07, 0x13, 0x00, 0x10, 0x07, 0x73, 0x07, 0x10, 0x20, 0x03, 0x07,
+    0x36, 0x07, 0x03, 0x20, 0x20, 0x73, 0x20, 0x30, 0x17, 0x16, 0x17, 0x30, 0x40, 0x07, 0x13, 0x07,
+    0x40, 0x50, 0x01, 0x03, 0x50, 0x20, 0x02, 0x56, 0x02, 0x20, 0x00, 0x02, 0x73, 0x16, 0x02, 0x00,
+    0x00, 0x06, 0x13, 0x06, 0x23, 0x16, 0x01, 0x02, 0x06, 0x00, 0x00, 0x06, 0x13, 0x06, 0x13, 0x16,
+    0x02, 0x26, 0x00, 0x00, 0x33, 0x16, 0x12, 0x05, 0x06, 0x14, 0x00, 0x02, 0x13, 0x16, 0x02, 0x06,
+    0x02, 0x06, 0x34, 0x02, 0x02, 0x26, 0x12, 0x06, 0x54, 0x02, 0x02, 0x46, 0x14, 0x26, 0x14, 0x02,
+    0x00, 0x26, 0x04, 0x16, 0x04, 0x16, 0x14, 0x06, 0x00, 0x00, 0x02, 0x06, 0x34, 0x26, 0x04, 0x06,
+    0x02, 0x00, 0x10, 0x02, 0x06, 0x14, 0x16, 0x14, 0x06, 0x02, 0x10, 0x20, 0x02, 0x06, 0x04, 0x06,
+    0x14, 0x06, 0x02, 0x20, 0x40, 0x06, 0x14, 0x06, 0x40, 0x50, 0x12, 0x50, 0x10, 0x05, 0x18, 0x31,
+    0x18, 0x05, 0x10, 0x21, 0x08, 0x01, 0x08, 0x31, 0x08, 0x21, 0x01, 0x08, 0x31, 0x03, 0x21, 0x08,
+    0x04, 0x11, 0x01, 0x08, 0x01, 0x08, 0x11, 0x08, 0x02, 0x11, 0x08, 0x06, 0x08, 0x01, 0x08, 0xB1,
+    0x08, 0x08, 0x05, 0x08, 0x71, 0x08, 0x05, 0x08, 0x00, 0x15, 0x01, 0x38, 0x05, 0x08, 0x01, 0x15,
+    0x00, 0x00, 0x25, 0x08, 0x01, 0x28, 0x35, 0x00, 0x00, 0x08, 0x05, 0x28, 0x01, 0x18, 0x07, 0x15,
+    0x08, 0x00, 0x10, 0x38, 0x21, 0x25, 0x10, 0x20, 0x18, 0x21, 0x25, 0x20, 0x20, 0x05, 0x08, 0x01,
+    0x08, 0x01, 0x25, 0x20, 0x40, 0x08, 0x11, 0x08, 0x40, 0x50, 0x18, 0x50, 0x50, 0x11, 0x50, 0x40,
+    0x04, 0x11, 0x04, 0x40, 0x20, 0x71, 0x20, 0x00, 0x31, 0x02, 0x61, 0x00, 0x00, 0x31, 0x02, 0x11,
+    0x04, 0x31, 0x00, 0x00, 0x31, 0x34, 0x31, 0x00, 0x00, 0x31, 0x44, 0x21, 0x00, 0x00, 0x31, 0x02,
+    0x11, 0x04, 0x31, 0x00, 0x00, 0x11, 0x25, 0x01, 0x03, 0x25, 0x11, 0x00, 0x00, 0x11, 0x05, 0x01,
+    0x05, 0x01, 0x05, 0x11, 0x05, 0x11, 0x00, 0x00, 0x21, 0x35, 0x01, 0x05, 0x21, 0x00, 0x20, 0x71,
+    0x20, 0x40, 0x04, 0x11, 0x04, 0x40, 0x50, 0x11, 0x50, 0x30, 0x06, 0x31, 0x06, 0x30, 0x20, 0x71,
+    0x20, 0x10, 0x91, 0x10, 0x00, 0x91, 0x07, 0x01, 0x00, 0x06, 0x31, 0x06, 0x11, 0x06, 0x31, 0x06,
+    0x41, 0x04, 0x11, 0x04, 0x41, 0xB1, 0x05, 0x01, 0x01, 0x07, 0x31, 0x02, 0x03, 0x31, 0x07, 0x01,
+    0x01, 0x07, 0xB1, 0x06, 0xB1, 0x06, 0x00, 0x11, 0x06, 0x51, 0x06, 0x11, 0x00, 0x10, 0x91, 0x10,
+    0x20, 0x41, 0x07, 0x11, 0x20, 0x30, 0x06, 0x31, 0x06, 0x30, 0x10, 0x93, 0x10, 0x10, 0x03, 0x71,
+    0x03, 0x10, 0x10, 0x03, 0x01, 0x13, 0x11, 0x03, 0x11, 0x03, 0x10, 0x10, 0x03, 0x51, 0x03, 0x01,
+    0x03, 0x10, 0x10, 0x03, 0x01, 0x03, 0x01, 0x03, 0x01, 0x13, 0x01, 0x03, 0x10, 0x10, 0x03, 0x01,
+    0x03, 0x01, 0x13, 0x01, 0x03, 0x01, 0x03, 0x10, 0x10, 0x03, 0x01, 0x03, 0x01, 0x03, 0x11, 0x03,
+    0x01, 0x03, 0x10, 0x10, 0x03, 0x01, 0x03, 0x21, 0x13, 0x01, 0x03, 0x10, 0x10, 0x03, 0x01, 0x33,
+    0x01, 0x03, 0x01, 0x03, 0x10, 0x10, 0x03, 0x71, 0x03, 0x10, 0x10, 0x03, 0x01, 0x13, 0x01, 0x02,
+    0x01, 0x03, 0x01, 0x03, 0x10, 0x10, 0x91, 0x10, 0x20, 0x03, 0x01, 0x03, 0x11, 0x03, 0x01, 0x03,
+    0x20, 0x50, 0x13, 0x50, 0xD0, 0x50, 0x1A, 0x50, 0x30, 0x08, 0x01, 0x13, 0x01, 0x0A, 0x30, 0x00,
+    0x0A, 0x08, 0x0A, 0x13, 0x11, 0x13, 0x1A, 0x09, 0x00, 0x10, 0x01, 0x23, 0x0A, 0x08, 0x23, 0x01,
+    0x10, 0x10, 0x01, 0x03, 0x0B, 0x23, 0x0B, 0x13, 0x01, 0x10, 0x10, 0x0A, 0x03, 0x0B, 0x53, 0x0A,
+    0x10, 0x10, 0x0A, 0x03, 0x0B, 0x13, 0x1B, 0x07, 0x03, 0x08, 0x10, 0x20, 0x01, 0x03, 0x05, 0x04,
+    0x13, 0x06, 0x01, 0x20, 0x20, 0x7A, 0x20, 0x20, 0x1A, 0x38, 0x1A, 0x20, 0x30, 0x0A, 0x02, 0x13,
+    0x02, 0x08, 0x30, 0x40, 0x0A, 0x11, 0x08, 0x40, 0x50, 0x0A, 0x08, 0x50, 0x60, 0x08, 0x50, 0x30,
+    0x09, 0x10, 0x01, 0x08, 0x40, 0x30, 0x08, 0x10, 0x11, 0x18, 0x20, 0x60, 0x21, 0x08, 0x20, 0x40,
+    0x18, 0x31, 0x20, 0x20, 0x38, 0x21, 0x03, 0x20, 0x20, 0x28, 0x03, 0x02, 0x01, 0x04, 0x01, 0x20,
+    0x20, 0x08, 0x13, 0x11, 0x05, 0x06, 0x01, 0x20, 0x20, 0x23, 0x11, 0x07, 0x01, 0x08, 0x20, 0x20,
+    0x13, 0x41, 0x08, 0x20, 0x20, 0x03, 0x08, 0x11, 0x08, 0x01, 0x18, 0x20, 0x20, 0x28, 0x01, 0x18,
+    0x11, 0x20, 0x30, 0x38, 0x01, 0x08, 0x30, 0x50, 0x18, 0x50, 0xD1, 0x01, 0x0D, 0x16, 0x07, 0x08,
+    0x09, 0x0A, 0x1B, 0x1C, 0x03, 0x01, 0x01, 0x0D, 0x11, 0x07, 0x08, 0x01, 0x0A, 0x1B, 0x0C, 0x03,
+    0x11, 0x01, 0x0D, 0x01, 0x06, 0x07, 0x08, 0x01, 0x0A, 0x1B, 0x03, 0x21, 0x01, 0x0D, 0x16, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x02, 0x31, 0x01, 0x05, 0x16, 0x07, 0x01, 0x09, 0x0A, 0x02, 0x41, 0x00,
+    0x05, 0x16, 0x07, 0x08, 0x09, 0x02, 0x31, 0x04, 0x01, 0x00, 0x05, 0x16, 0x07, 0x08, 0x02, 0x41,
+    0x04, 0x00, 0x00, 0x01, 0x16, 0x07, 0x02, 0x61, 0x00, 0x00, 0x01, 0x04, 0x06, 0x02, 0x51, 0x04,
+    0x01, 0x00, 0x10, 0x01, 0x03, 0x71, 0x10, 0x00, 0x01, 0x03, 0x71, 0x20, 0x00, 0x01, 0x10, 0x01,
+    0x05, 0x11, 0x05, 0x01, 0x30, 0x50, 0x11, 0x50, 0x40, 0x33, 0x40, 0x20, 0x73, 0x20, 0x10, 0x01,
+    0x03, 0x01, 0x03, 0x01, 0x13, 0x01, 0x03, 0x01, 0x10, 0x10, 0x03, 0x11, 0x33, 0x11, 0x03, 0x10,
+    0x10, 0x03, 0x11, 0x13, 0x01, 0x03, 0x11, 0x03, 0x10, 0x10, 0x03, 0x11, 0x03, 0x01, 0x13, 0x11,
+    0x03, 0x10, 0x10, 0x03, 0x11, 0x33, 0x11, 0x03, 0x10, 0x10, 0x13, 0x01, 0x13, 0x01, 0x03, 0x01,
+    0x13, 0x10, 0x10, 0x93, 0x10, 0x10, 0x13, 0x02, 0x03, 0x01, 0x03, 0x01, 0x23, 0x10, 0x10, 0x13,
+    0x02, 0x03, 0x21, 0x23, 0x10, 0x10, 0x01, 0x23, 0x11, 0x23, 0x01, 0x10, 0x20, 0x23, 0x11, 0x23,
+    0x20, 0x40, 0x33, 0x40, 0x30, 0x01, 0x35, 0x01, 0x30, 0x20, 0x25, 0x11, 0x25, 0x20, 0x10, 0x05,
+    0x01, 0x15, 0x11, 0x15, 0x01, 0x05, 0x10, 0x00, 0x05, 0x02, 0x15, 0x01, 0x13, 0x11, 0x25, 0x00,
+    0x01, 0x25, 0x11, 0x15, 0x11, 0x25, 0x01, 0x25, 0x11, 0x05, 0x11, 0x03, 0x11, 0x25, 0x15, 0x01,
+    0x03, 0x01, 0x05, 0x01, 0x03, 0x05, 0x01, 0x03, 0x01, 0x15, 0x15, 0x01, 0x03, 0x01, 0x05, 0x01,
+    0x05, 0x11, 0x03, 0x01, 0x15, 0x25, 0x03, 0x01, 0x03, 0x31, 0x03, 0x25, 0x01, 0x25, 0x51, 0x25,
+    0x01, 0x00, 0x35, 0x33, 0x35, 0x00, 0x10, 0x35, 0x11, 0x05, 0x04, 0x15, 0x10, 0x20, 0x25, 0x01,
+    0x05, 0x01, 0x15, 0x20, 0x30, 0x01, 0x35, 0x01, 0x30, 0x30, 0x01, 0x39, 0x01, 0x30, 0x20, 0x09,
+    0x08, 0x07, 0x05, 0x28, 0x09, 0x20, 0x10, 0x01, 0x18, 0x01, 0x18, 0x01, 0x08, 0x11, 0x10, 0x00,
+    0x09, 0x91, 0x09, 0x00, 0x01, 0x08, 0x02, 0x03, 0x01, 0x0A, 0x11, 0x0A, 0x21, 0x08, 0x01, 0x09,
+    0x01, 0x08, 0x01, 0x0A, 0x01, 0x1A, 0x01, 0x0A, 0x21, 0x09, 0x09, 0x18, 0x01, 0x2A, 0x01, 0x0A,
+    0x11, 0x18, 0x09, 0x09, 0x18, 0x01, 0x1A, 0x01, 0x1A, 0x11, 0x18, 0x09, 0x09, 0x08, 0x11, 0x1A,
+    0x11, 0x1A, 0x21, 0x09, 0x01, 0x18, 0x05, 0x01, 0x0A, 0x11, 0x0A, 0x11, 0x18, 0x01, 0x00, 0x09,
+    0x18, 0x04, 0x61, 0x09, 0x00, 0x10, 0x01, 0x18, 0x01, 0x38, 0x11, 0x10, 0x20, 0x09, 0x08, 0x21,
+    0x06, 0x08, 0x09, 0x20, 0x30, 0x01, 0x39, 0x01, 0x30, 0xD0, 0x10, 0x91, 0x10, 0x10, 0x01, 0x02,
+    0x18, 0x12, 0x28, 0x01, 0x10, 0x10, 0x01, 0x12, 0x08, 0x22, 0x18, 0x01, 0x10, 0x10, 0x01, 0x18,
+    0x06, 0x18, 0x06, 0x18, 0x01, 0x10, 0x08, 0x00, 0x01, 0x07, 0x02, 0x06, 0x18, 0x06, 0x02, 0x07,
+    0x01, 0x00, 0x08, 0x08, 0x04, 0x32, 0x16, 0x32, 0x03, 0x08, 0x00, 0x02, 0x08, 0x22, 0x16, 0x22,
+    0x08, 0x02, 0x00, 0x02, 0x00, 0x01, 0x18, 0x36, 0x18, 0x01, 0x00, 0x02, 0x10, 0x11, 0x68, 0x01,
+    0x10, 0x10, 0x28, 0x01, 0x28, 0x01, 0x18, 0x10, 0x30, 0x01, 0x18, 0x05, 0x08, 0x01, 0x30, 0x50,
+    0x11, 0x50, 0xD0, 0x20, 0x11, 0x34, 0x11, 0x20, 0x10, 0x91, 0x10, 0x00, 0x31, 0x33, 0x31, 0x00,
+    0x00, 0x04, 0x11, 0x03, 0x01, 0x13, 0x01, 0x03, 0x11, 0x04, 0x00, 0x00, 0x04, 0x11, 0x13, 0x11,
+    0x13, 0x11, 0x04, 0x00, 0x00, 0x04, 0x11, 0x03, 0x01, 0x13, 0x01, 0x03, 0x11, 0x04, 0x00, 0x00,
+    0x04, 0x11, 0x53, 0x11, 0x04, 0x00, 0x00, 0x04, 0x21, 0x33, 0x21, 0x04, 0x00, 0x00, 0x31, 0x33,
+    0x31, 0x00, 0x10, 0x04, 0x71, 0x04, 0x10, 0x10, 0x02, 0x11, 0x04, 0x11, 0x04, 0x11, 0x02, 0x10,
+    0x20, 0x71, 0x20, 0x30, 0x51, 0x30, 0x50, 0x11, 0x50, 0x30, 0x07, 0x31, 0x07, 0x30, 0x20, 0x31,
+    0x03, 0x21, 0x20, 0x10, 0x01, 0x07, 0x11, 0x14, 0x31, 0x10, 0x00, 0x21, 0x07, 0x34, 0x07, 0x01,
+    0x06, 0x01, 0x00, 0x17, 0x01, 0x07, 0x51, 0x07, 0x01, 0x17, 0x01, 0x07, 0x01, 0x07, 0x51, 0x07,
+    0x21, 0x11, 0x17, 0x51, 0x17, 0x11, 0x11, 0x17, 0x21, 0x07, 0x11, 0x17, 0x11, 0x21, 0x07, 0x21,
+    0x07, 0x11, 0x07, 0x21, 0x07, 0x11, 0x17, 0x01, 0x02, 0x07, 0x01, 0x17, 0x11, 0x07, 0x00, 0x01,
+    0x07, 0x01, 0x07, 0x04, 0x11, 0x04, 0x07, 0x01, 0x07, 0x01, 0x00, 0x10, 0x31, 0x14, 0x11, 0x05,
+    0x01, 0x10, 0x20, 0x11, 0x07, 0x11, 0x07, 0x11, 0x20, 0x30, 0x07, 0x31, 0x07, 0x30, 0x30, 0x11,
+    0x14, 0x11, 0x30, 0x10, 0x04, 0x05, 0x51, 0x05, 0x20, 0x10, 0x01, 0x75, 0x01, 0x10, 0x00, 0x11,
+    0x75, 0x11, 0x00, 0x00, 0x41, 0x15, 0x41, 0x00, 0x51, 0x15, 0x51, 0x51, 0x15, 0x51, 0x51, 0x15,
+    0x51, 0x00, 0x41, 0x15, 0x41, 0x00, 0x00, 0x03, 0x31, 0x15, 0x41, 0x00, 0x10, 0x31, 0x15, 0x21,
+    0x02, 0x10, 0x20, 0x04, 0x11, 0x15, 0x11, 0x04, 0x20, 0x30, 0x01, 0x04, 0x15, 0x04, 0x01, 0x30,
+    0x50, 0x05, 0x01, 0x50, 0x10, 0x93, 0x10, 0x10, 0x06, 0x71, 0x06, 0x10, 0x10, 0x06, 0x21, 0x16,
+    0x21, 0x06, 0x10, 0x10, 0x06, 0x01, 0x16, 0x11, 0x06, 0x11, 0x06, 0x10, 0x10, 0x06, 0x11, 0x06,
+    0x41, 0x06, 0x10, 0x10, 0x06, 0x04, 0x03, 0x06, 0x01, 0x06, 0x21, 0x06, 0x10, 0x10, 0x06, 0x05,
+    0x11, 0x03, 0x01, 0x06, 0x11, 0x06, 0x10, 0x10, 0x03, 0x01, 0x03, 0x01, 0x13, 0x21, 0x03, 0x10,
+    0x10, 0x06, 0x01, 0x06, 0x51, 0x06, 0x10, 0x20, 0x06, 0x01, 0x02, 0x17, 0x03, 0x01, 0x06, 0x20,
+    0x20, 0x06, 0x11, 0x17, 0x11, 0x06, 0x20, 0x30, 0x03, 0x31, 0x03, 0x30, 0x40, 0x03, 0x11, 0x03,
+    0x40, 0x50, 0x16, 0x50, 0x20, 0x15, 0x31, 0x15, 0x20, 0x10, 0x03, 0x11, 0x06, 0x11, 0x06, 0x11,
+    0x03, 0x10, 0x10, 0x03, 0x01, 0x04, 0x06, 0x11, 0x06, 0x01, 0x06, 0x03, 0x10, 0x10, 0x03, 0x06,
+    0x41, 0x16, 0x03, 0x10, 0x10, 0x03, 0x01, 0x03, 0x31, 0x03, 0x01, 0x03, 0x10, 0x10, 0x13, 0x01,
+    0x06, 0x01, 0x16, 0x01, 0x13, 0x10, 0x10, 0x03, 0x11, 0x16, 0x31, 0x03, 0x10, 0x10, 0x03, 0x61,
+    0x06, 0x03, 0x10, 0x10, 0x03, 0x36, 0x01, 0x26, 0x03, 0x10, 0x10, 0x03, 0x16, 0x31, 0x06, 0x01,
+    0x03, 0x10, 0x10, 0x11, 0x36, 0x31, 0x10, 0x20, 0x03, 0x21, 0x16, 0x01, 0x03, 0x20, 0x30, 0x51,
+    0x30, 0x40, 0x02, 0x11, 0x02, 0x40, 0x20, 0x11, 0x3B, 0x11, 0x20, 0x00, 0xB1, 0x00, 0x00, 0x21,
+    0x0B, 0x01, 0x0B, 0x01, 0x05, 0x31, 0x00, 0x00, 0x11, 0x2B, 0x11, 0x2B, 0x11, 0x00, 0x00, 0x11,
+    0x23, 0x01, 0x03, 0x01, 0x03, 0x21, 0x00, 0x00, 0x31, 0x03, 0x01, 0x13, 0x01, 0x03, 0x11, 0x00,
+    0x00, 0x41, 0x03, 0x01, 0x23, 0x11, 0x00, 0x00, 0x31, 0x0B, 0x04, 0x09, 0x03, 0x31, 0x00, 0x10,
+    0x21, 0x08, 0x19, 0x07, 0x13, 0x02, 0x10, 0x10, 0x0B, 0x21, 0x16, 0x21, 0x0B, 0x10, 0x10, 0x31,
+    0x03, 0x0B, 0x13, 0x11, 0x10, 0x20, 0x71, 0x20, 0x30, 0x01, 0x0A, 0x11, 0x0B, 0x01, 0x30, 0x50,
+    0x11, 0x50, 0x50, 0x14, 0x50, 0x30, 0x04, 0x01, 0x12, 0x01, 0x04, 0x30, 0x10, 0x04, 0x01, 0x52,
+    0x01, 0x04, 0x10, 0x00, 0x04, 0x32, 0x11, 0x32, 0x04, 0x00, 0x00, 0x04, 0x92, 0x04, 0x00, 0x00,
+    0x03, 0x92, 0x03, 0x00, 0x10, 0x92, 0x10, 0x10, 0x01, 0x72, 0x01, 0x10, 0x10, 0x01, 0x02, 0x01,
+    0x52, 0x01, 0x10, 0x10, 0x04, 0x32, 0x01, 0x22, 0x04, 0x10, 0x20, 0x01, 0x22, 0x01, 0x12, 0x01,
+    0x20, 0x30, 0x01, 0x12, 0x01, 0x02, 0x01, 0x30, 0x40, 0x04, 0x02, 0x01, 0x04, 0x40, 0x50, 0x14,
+    0x50, 0x30, 0x06, 0x18, 0x26, 0x30, 0x10, 0x16, 0x08, 0x31, 0x08, 0x16, 0x10, 0x00, 0x06, 0x11,
+    0x03, 0x31, 0x08, 0x11, 0x06, 0x00, 0x00, 0x08, 0x91, 0x08, 0x00, 0x00, 0x01, 0x17, 0x02, 0x31,
+    0x08, 0x21, 0x00, 0x00, 0x21, 0x17, 0x11, 0x08, 0x31, 0x00, 0x00, 0x01, 0x17, 0x41, 0x08, 0x21,
+    0x00, 0x00, 0x08, 0x01, 0x05, 0x27, 0x01, 0x18, 0x11, 0x08, 0x00, 0x00, 0x06, 0x17, 0x11, 0x07,
+    0x01, 0x08, 0x21, 0x06, 0x00, 0x10, 0x01, 0x27, 0x51, 0x10, 0x10, 0x06, 0x11, 0x04, 0x07, 0x01,
+    0x08, 0x11, 0x06, 0x10, 0x20, 0x06, 0x51, 0x06, 0x20, 0x40, 0x01, 0x07, 0x11, 0x40, 0x50, 0x16,
+    0x50, 0x40, 0x05, 0x11, 0x05, 0x40, 0x30, 0x51, 0x30, 0x10, 0x31, 0x13, 0x01, 0x23, 0x10, 0x10,
+    0x21, 0x03, 0x11, 0x03, 0x05, 0x13, 0x10, 0x10, 0x21, 0x03, 0x21, 0x03, 0x05, 0x03, 0x10, 0x10,
+    0x11, 0x03, 0x01, 0x13, 0x01, 0x23, 0x10, 0x10, 0x01, 0x03, 0x41, 0x03, 0x04, 0x03, 0x10, 0x10,
+    0x01, 0x03, 0x11, 0x03, 0x11, 0x05, 0x04, 0x03, 0x10, 0x10, 0x03, 0x01, 0x03, 0x31, 0x03, 0x04,
+    0x03, 0x10, 0x10, 0x03, 0x11, 0x03, 0x21, 0x05, 0x13, 0x10, 0x10, 0x01, 0x03, 0x41, 0x03, 0x04,
+    0x01, 0x10, 0x20, 0x01, 0x03, 0x11, 0x02, 0x01, 0x13, 0x20, 0x30, 0x51, 0x30, 0x40, 0x05, 0x11,
+    0x05, 0x40, 0xD0, 0x40, 0x07, 0x14, 0x07, 0x40, 0x40, 0x07, 0x14, 0x07, 0x40, 0x20, 0x14, 0x07,
+    0x14, 0x07, 0x14, 0x20, 0x20, 0x07, 0x51, 0x07, 0x20, 0x20, 0x27, 0x11, 0x27, 0x20, 0x10, 0x07,
+    0x06, 0x54, 0x06, 0x07, 0x10, 0x00, 0x07, 0x02, 0x14, 0x17, 0x05, 0x07, 0x04, 0x27, 0x00, 0x07,
+    0x24, 0x57, 0x24, 0x07, 0x00, 0x04, 0x17, 0x02, 0x03, 0x11, 0x07, 0x02, 0x17, 0x04, 0x00, 0x20,
+    0x04, 0x17, 0x11, 0x17, 0x04, 0x20, 0x20, 0x17, 0x02, 0x11, 0x02, 0x17, 0x20, 0x40, 0x04, 0x17,
+    0x04, 0x40, 0xD0, 0xD0, 0x50, 0x11, 0x50, 0x30, 0x04, 0x01, 0x15, 0x01, 0x04, 0x30, 0x30, 0x05,
+    0x31, 0x05, 0x30, 0x20, 0x11, 0x05, 0x11, 0x05, 0x11, 0x20, 0x20, 0x05, 0x01, 0x15, 0x11, 0x15,
+    0x20, 0x10, 0x05, 0x21, 0x05, 0x41, 0x10, 0x10, 0x01, 0x05, 0x41, 0x05, 0x11, 0x10, 0x20, 0x13,
+    0x01, 0x05, 0x11, 0x13, 0x20, 0x20, 0x11, 0x03, 0x11, 0x03, 0x11, 0x20, 0x30, 0x03, 0x31, 0x03,
+    0x30, 0x30, 0x11, 0x13, 0x01, 0x02, 0x30, 0x50, 0x11, 0x50, 0xD0,
+};
+
+static constexpr AtlasLogo LOGO_ATLAS[] = {
+    {"atlanta united", {14, 14, LOGO_ATLAS_PALETTES + 0, LOGO_ATLAS_RUNS + 0}},  // atlanta-united-footballlogos-org_14x14.png
+    {"austin fc", {14, 14, LOGO_ATLAS_PALETTES + 9, LOGO_ATLAS_RUNS + 108}},  // austin-fc-footballlogos-org_14x14.png
+    {"cf montreal", {14, 14, LOGO_ATLAS_PALETTES + 14, LOGO_ATLAS_RUNS + 189}},  // cf-montreal-footballlogos-org_14x14.png
+    {"charlotte fc", {14, 14, LOGO_ATLAS_PALETTES + 20, LOGO_ATLAS_RUNS + 309}},  // charlotte-fc-footballlogos-org_14x14.png
+    {"chicago fire", {14, 14, LOGO_ATLAS_PALETTES + 24, LOGO_ATLAS_RUNS + 398}},  // chicago-fire-footballlogos-org_14x14.png
+    {"colorado rapids", {14, 14, LOGO_ATLAS_PALETTES + 29, LOGO_ATLAS_RUNS + 504}},  // colorado-rapids-footballlogos-org_14x14.png
+    {"columbus crew", {14, 14, LOGO_ATLAS_PALETTES + 37, LOGO_ATLAS_RUNS + 582}},  // columbus-crew-footballlogos-org_14x14.png
+    {"dc united", {14, 14, LOGO_ATLAS_PALETTES + 41, LOGO_ATLAS_RUNS + 650}},  // dc-united-footballlogos-org_14x14.png
+    {"fc cincinnati", {14, 14, LOGO_ATLAS_PALETTES + 49, LOGO_ATLAS_RUNS + 741}},  // fc-cincinnati-footballlogos-org_14x14.png
+    {"fc dallas", {14, 14, LOGO_ATLAS_PALETTES + 56, LOGO_ATLAS_RUNS + 844}},  // fc-dallas-footballlogos-org_14x14.png
+    {"houston dynamo", {14, 14, LOGO_ATLAS_PALETTES + 65, LOGO_ATLAS_RUNS + 940}},  // houston-dynamo-footballlogos-org_14x14.png
+    {"inter miami", {14, 14, LOGO_ATLAS_PALETTES + 71, LOGO_ATLAS_RUNS + 1017}},  // inter-miami-footballlogos-org_14x14.png
+    {"los angeles fc", {14, 14, LOGO_ATLAS_PALETTES + 79, LOGO_ATLAS_RUNS + 1082}},  // los-angeles-fc-footballlogos-org_14x14.png
+    {"los angeles galaxy", {14, 14, LOGO_ATLAS_PALETTES + 83, LOGO_ATLAS_RUNS + 1188}},  // los-angeles-galaxy-footballlogos-org_14x14.png
+    {"minnesota united", {14, 14, LOGO_ATLAS_PALETTES + 95, LOGO_ATLAS_RUNS + 1276}},  // minnesota-united-footballlogos-org_14x14.png
+    {"mls", {14, 14, LOGO_ATLAS_PALETTES + 105, LOGO_ATLAS_RUNS + 1354}},  // mls-footballlogos-org_14x14.png
+    {"nashville sc", {14, 14, LOGO_ATLAS_PALETTES + 119, LOGO_ATLAS_RUNS + 1464}},  // nashville-sc-footballlogos-org_14x14.png
+    {"new england revolution", {14, 14, LOGO_ATLAS_PALETTES + 123, LOGO_ATLAS_RUNS + 1556}},  // new-england-revolution-footballlogos-org_14x14.png
+    {"new york city fc", {14, 14, LOGO_ATLAS_PALETTES + 129, LOGO_ATLAS_RUNS + 1657}},  // new-york-city-fc-footballlogos-org_14x14.png
+    {"new york red bulls", {14, 14, LOGO_ATLAS_PALETTES + 140, LOGO_ATLAS_RUNS + 1769}},  // new-york-red-bulls-footballlogos-org_14x14.png
+    {"orlando city", {14, 14, LOGO_ATLAS_PALETTES + 149, LOGO_ATLAS_RUNS + 1859}},  // orlando-city-footballlogos-org_14x14.png
+    {"philadelphia union", {14, 14, LOGO_ATLAS_PALETTES + 154, LOGO_ATLAS_RUNS + 1945}},  // philadelphia-union-footballlogos-org_14x14.png
+    {"portland timbers", {14, 14, LOGO_ATLAS_PALETTES + 162, LOGO_ATLAS_RUNS + 2046}},  // portland-timbers-footballlogos-org_14x14.png
+    {"real salt lake", {14, 14, LOGO_ATLAS_PALETTES + 168, LOGO_ATLAS_RUNS + 2116}},  // real-salt-lake-footballlogos-org_14x14.png
+    {"san diego fc", {14, 14, LOGO_ATLAS_PALETTES + 176, LOGO_ATLAS_RUNS + 2212}},  // san-diego-fc-footballlogos-org_14x14.png
+    {"san jose earthquakes", {14, 14, LOGO_ATLAS_PALETTES + 183, LOGO_ATLAS_RUNS + 2310}},  // san-jose-earthquakes-footballlogos-org_14x14.png
+    {"seattle sounders", {14, 14, LOGO_ATLAS_PALETTES + 195, LOGO_ATLAS_RUNS + 2402}},  // seattle-sounders-footballlogos-org_14x14.png
+    {"sporting kansas city", {14, 14, LOGO_ATLAS_PALETTES + 200, LOGO_ATLAS_RUNS + 2481}},  // sporting-kansas-city-footballlogos-org_14x14.png
+    {"st louis city", {14, 14, LOGO_ATLAS_PALETTES + 209, LOGO_ATLAS_RUNS + 2577}},  // st-louis-city-footballlogos-org_14x14.png
+    {"toronto fc", {14, 14, LOGO_ATLAS_PALETTES + 215, LOGO_ATLAS_RUNS + 2674}},  // toronto-fc-footballlogos-org_14x14.png
+    {"vancouver whitecaps", {14, 14, LOGO_ATLAS_PALETTES + 223, LOGO_ATLAS_RUNS + 2755}},  // vancouver-whitecaps-footballlogos-org_14x14.png
+};
+
+}  // namespace matrix_render
+}  // namespace esphome
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace matrix_render {
+
+// A small palettized image stored as run-length-encoded rows, as emitted by
+// firmware/logos/build_logo_atlas.py. Each byte is one run: the high nibble is
+// the run length minus one, the low nibble a palette index. Index 0 is
+// transparent. Runs never cross a row, so a row can be skipped by walking its
+// runs.
+struct RleImage {
+  uint8_t width;
+  uint8_t height;
+  const uint16_t *palette;  // RGB565, native byte order; entry 0 is unused
+  const uint8_t *runs;
+};
+
+static constexpr uint8_t RLE_TRANSPARENT = 0;
+
+inline uint8_t rle_run_length(uint8_t run) { return (run >> 4) + 1; }
+inline uint8_t rle_run_index(uint8_t run) { return run & 0x0F; }
+
+// Calls fn(col, length, palette_index) for every run of one row and returns
+// the first run of the next row
+template<typename F> inline const uint8_t *rle_decode_row(const RleImage &image, const uint8_t *runs, F &&fn) {
+  for (int col = 0; col < image.width; runs++) {
+    uint8_t length = rle_run_length(*runs);
+    fn(col, length, rle_run_index(*runs));
+    col += length;
+  }
+  return runs;
+}
+
+inline const uint8_t *rle_skip_row(const RleImage &image, const uint8_t *runs) {
+  for (int col = 0; col < image.width; runs++) {
+    col += rle_run_length(*runs);
+  }
+  return runs;
+}
+
+}  // namespace matrix_render
+}  // namespace esphome
@@ -0,0 +1,198 @@
+#include "span_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace matrix_render {
+
+void SpanBuffer::begin(int x, int width) {
+  this->x_ = x;
+  this->width_ = std::min(width, MAX_SPAN_WIDTH);
+  memset(this->covered_, 0, (this->width_ + 7) / 8);
+}
+
+void HOT SpanBuffer::set_rgb565(int x, uint16_t rgb565) {
+  int i = x - this->x_;
+  if (i < 0 || i >= this->width_) {
+    return;
+  }
+
+  this->pixels_[i] = rgb565;
+  this->covered_[i >> 3] |= 1 << (i & 7);
+}
+
+void HOT SpanBuffer::fill_rgb565(int x_start, int x_end, uint16_t rgb565) {
+  for (int x = x_start; x < x_end; x++) {
+    this->set_rgb565(x, rgb565);
+  }
+}
+
+void HOT SpanBuffer::flush(display::Display *display, int y) const {
+  int i = 0;
+  while (i < this->width_) {
+    if (!(this->covered_[i >> 3] & (1 << (i & 7)))) {
+      i++;
+      continue;
+    }
+
+    int run_start = i;
+    while (i < this->width_ && (this->covered_[i >> 3] & (1 << (i & 7)))) {
+      i++;
+    }
+
+    int x_start = this->x_ + run_start;
+    int x_end = this->x_ + i;
+    if (!clip_span(display, y, x_start, x_end)) {
+      continue;
+    }
+
+    // Pixels are stored in native (little-endian) order
+    const uint16_t *run = &this->pixels_[x_start - this->x_];
+    display->draw_pixels_at(x_start, y, x_end - x_start, 1, reinterpret_cast<const uint8_t *>(run),
+                            display::COLOR_ORDER_RGB, display::COLOR_BITNESS_565, false);
+  }
+}
+
+// A canvas per band and per compositor zone; one that doesn't fit is drawn pixel by pixel
+static constexpr int MAX_ROW_COPY_DISPLAYS = 32;
+static std::atomic<const display::Display *> row_copy_displays[MAX_ROW_COPY_DISPLAYS];
+
+void register_row_copy(const display::Display *display) {
+  for (auto &slot : row_copy_displays) {
+    const display::Display *expected = nullptr;
+    if (slot.compare_exchange_strong(expected, display)) {
+      return;
+    }
+  }
+}
+
+void unregister_row_copy(const display::Display *display) {
+  for (auto &slot : row_copy_displays) {
+    const display::Display *expected = display;
+    slot.compare_exchange_strong(expected, nullptr);
+  }
+}
+
+bool copies_rows(const display::Display *display) {
+  for (auto &slot : row_copy_displays) {
+    if (slot.load(std::memory_order_relaxed) == display) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool clip_rect(display::Display *display, int &x_start, int &y_start, int &x_end, int &y_end) {
+  int clip_x1 = 0, clip_y1 = 0;
+  int clip_x2 = display->get_width(), clip_y2 = display->get_height();
+
+  if (display->is_clipping()) {
+    display::Rect clip = display->get_clipping();
+    clip_x1 = std::max(clip_x1, (int) clip.x);
+    clip_y1 = std::max(clip_y1, (int) clip.y);
+    clip_x2 = std::min(clip_x2, (int) clip.x2());
+    clip_y2 = std::min(clip_y2, (int) clip.y2());
+  }
+
+  x_start = std::max(x_start, clip_x1);
+  y_start = std::max(y_start, clip_y1);
+  x_end = std::min(x_end, clip_x2);
+  y_end = std::min(y_end, clip_y2);
+  return x_start < x_end && y_start < y_end;
+}
+
+bool clip_span(display::Display *display, int y, int &x_start, int &x_end) {
+  int y_start = y, y_end = y + 1;
+  return clip_rect(display, x_start, y_start, x_end, y_end);
+}
+
+// Apart from blit_image(), so the SpanBuffer is only on the stack when it is used
+static void __attribute__((noinline)) blit_rows_spans(display::Display *display, int x, int y, const RleImage &image,
+                                                      const uint8_t *runs, int x_start, int y_start, int x_end,
+                                                      int y_end) {
+  SpanBuffer span;
+  for (int row = y_start - y; row < y_end - y; row++) {
+    span.begin(x_start, x_end - x_start);
+    runs = rle_decode_row(image, runs, [&](int col, int length, uint8_t index) {
+      if (index != RLE_TRANSPARENT) {
+        span.fill_rgb565(x + col, x + col + length, image.palette[index]);
+      }
+    });
+    span.flush(display, y + row);
+  }
+}
+
+void HOT blit_image(display::Display *display, int x, int y, const RleImage &image) {
+  int x_start = x, y_start = y;
+  int x_end = x + image.width, y_end = y + image.height;
+  if (!clip_rect(display, x_start, y_start, x_end, y_end)) {
+    return;
+  }
+
+  const uint8_t *runs = image.runs;
+  for (int row = 0; row < y_start - y; row++) {
+    runs = rle_skip_row(image, runs);
+  }
+
+  if (copies_rows(display)) {
+    blit_rows_spans(display, x, y, image, runs, x_start, y_start, x_end, y_end);
+    return;
+  }
+
+  for (int row = y_start - y; row < y_end - y; row++) {
+    runs = rle_decode_row(image, runs, [&](int col, int length, uint8_t index) {
+      if (index == RLE_TRANSPARENT) {
+        return;
+      }
+      Color color = SpanBuffer::to_color(image.palette[index]);
+      for (int px = std::max(x + col, x_start); px < std::min(x + col + length, x_end); px++) {
+        display->draw_pixel_at(px, y + row, color);
+      }
+    });
+  }
+}
+
+#ifdef MATRIX_RENDER_HAS_IMAGE
+void HOT blit_image(display::Display *display, int x, int y, image::Image *image) {
+  if (!copies_rows(display)) {
+    display->image(x, y, image);
+    return;
+  }
+
+  const int width = image->get_width();
+  const int height = image->get_height();
+
+  int x_start = x, y_start = y;
+  int x_end = x + width, y_end = y + height;
+  if (!clip_rect(display, x_start, y_start, x_end, y_end)) {
+    return;
+  }
+
+  if (image->get_type() == image::IMAGE_TYPE_RGB565 && !image->has_transparency()) {
+    // ESPHome stores RGB565 image data big-endian
+    display->draw_pixels_at(x_start, y_start, x_end - x_start, y_end - y_start, image->get_data_start(),
+                            display::COLOR_ORDER_RGB, display::COLOR_BITNESS_565, true,
+                            x_start - x, y_start - y, (x + width) - x_end);
+    return;
+  }
+
+  SpanBuffer span;
+  for (int row = y_start - y; row < y_end - y; row++) {
+    span.begin(x_start, x_end - x_start);
+    for (int col = x_start - x; col < x_end - x; col++) {
+      Color color = image->get_pixel(col, row);
+      if (color.w >= 0x80) {
+        span.set(x + col, color);
+      }
+    }
+    span.flush(display, y + row);
+  }
+}
+#endif
+
+}  // namespace matrix_render
+}  // namespace esphome
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/components/display/display.h"
+
+#include "rle_image.h"
+
+#if __has_include("esphome/components/image/image.h")
+#include "esphome/components/image/image.h"
+#define MATRIX_RENDER_HAS_IMAGE
+#endif
+
+namespace esphome {
+namespace matrix_render {
+
+// Widest row a span can hold: eight chained 64px panels
+static constexpr int MAX_SPAN_WIDTH = 512;
+
+// A single row of RGB565 pixels with a coverage mask. Callers fill the row
+// locally and push it with flush(), which clips once per span and sends each
+// run of covered pixels to the display in a single draw_pixels_at() call.
+class SpanBuffer {
+  public:
+    // Start a new row covering [x, x + width) in display coordinates
+    void begin(int x, int width);
+
+    void set(int x, Color color) { this->set_rgb565(x, to_rgb565(color)); }
+    void set_rgb565(int x, uint16_t rgb565);
+    void fill(int x_start, int x_end, Color color) { this->fill_rgb565(x_start, x_end, to_rgb565(color)); }
+    void fill_rgb565(int x_start, int x_end, uint16_t rgb565);
+
+    // Push the covered pixels of this row to the display at the given y
+    void flush(display::Display *display, int y) const;
+
+    static uint16_t to_rgb565(Color color) {
+      return ((color.r & 0xF8) << 8) | ((color.g & 0xFC) << 3) | (color.b >> 3);
+    }
+    static Color to_color(uint16_t rgb565) {
+      uint8_t r = rgb565 >> 11, g = (rgb565 >> 5) & 0x3F, b = rgb565 & 0x1F;
+      return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+    }
+
+  protected:
+    int x_ = 0;
+    int width_ = 0;
+    uint16_t pixels_[MAX_SPAN_WIDTH];
+    uint8_t covered_[MAX_SPAN_WIDTH / 8];
+};
+
+// Displays whose draw_pixels_at() copies rows. ESPHome's own, which the HUB75
+// driver keeps, converts and draws one pixel at a time, so there a span costs
+// more than drawing its pixels directly (host/span_benchmark.cpp) and the
+// blits below draw pixel by pixel. BandCanvas registers itself; a driver that
+// overrides draw_pixels_at() can too. Safe from any task.
+void register_row_copy(const display::Display *display);
+void unregister_row_copy(const display::Display *display);
+bool copies_rows(const display::Display *display);
+
+// Clip a rectangle, or the horizontal run [x_start, x_end) on row y, against the
+// display bounds and its current clipping rectangle. Returns false if nothing is left.
+bool clip_rect(display::Display *display, int &x_start, int &y_start, int &x_end, int &y_end);
+bool clip_span(display::Display *display, int y, int &x_start, int &x_end);
+
+// Draw a run-length-encoded image, decoding each visible row straight into a
+// span, or onto the display pixel by pixel if it doesn't copy rows
+void blit_image(display::Display *display, int x, int y, const RleImage &image);
+
+#ifdef MATRIX_RENDER_HAS_IMAGE
+// Draw an image through the span path. Opaque RGB565 images go to the display
+// as one clipped rectangle; everything else is decoded row by row into spans.
+// A display that doesn't copy rows gets ESPHome's per-pixel Display::image().
+void blit_image(display::Display *display, int x, int y, image::Image *image);
+#endif
+
+}  // namespace matrix_render
+}  // namespace esphome
@@ -0,0 +1,178 @@
+#include "text_metrics.h"
+
+#ifdef MATRIX_RENDER_HAS_FONT
+
+#include <algorithm>
+#include <cstring>
+
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace matrix_render {
+
+// Extended glyphs covered by the table: Latin-1 Supplement and Latin
+// Extended-A, i.e. the two-byte sequences with lead bytes 0xC2..0xC5
+static constexpr uint16_t EXTENDED_FIRST = 0x0080;
+static constexpr uint16_t EXTENDED_LAST = 0x017F;
+
+void TextMetrics::build(font::Font *font) {
+  this->font_ = font;
+  this->extended_.clear();
+  if (font == nullptr) {
+    return;
+  }
+
+  int width, x_offset, baseline, height;
+
+  // A control character is never a glyph, so it measures as the fallback
+  // advance Font::print() uses for bytes it can't match
+  font->measure("\x01", &width, &x_offset, &baseline, &height);
+  this->unknown_.advance = width;
+  this->unknown_.offset_x = 0;
+  this->unknown_.known = false;
+
+  auto encode = [](uint16_t codepoint, char *str) {
+    if (codepoint < 0x80) {
+      str[0] = static_cast<char>(codepoint);
+      str[1] = '\0';
+    } else {
+      str[0] = static_cast<char>(0xC0 | (codepoint >> 6));
+      str[1] = static_cast<char>(0x80 | (codepoint & 0x3F));
+      str[2] = '\0';
+    }
+  };
+  // A missing glyph measures as one unknown advance per byte
+  auto measure = [&](uint16_t codepoint) {
+    char str[3];
+    encode(codepoint, str);
+    font->measure(str, &width, &x_offset, &baseline, &height);
+    GlyphMetrics metrics;
+    metrics.advance = width + x_offset;
+    metrics.offset_x = x_offset;
+    metrics.known = x_offset != 0 || width != (codepoint < 0x80 ? 1 : 2) * this->unknown_.advance;
+    return metrics;
+  };
+
+  for (uint16_t c = 1; c < 128; c++) {
+    this->ascii_[c] = measure(c);
+  }
+  this->ascii_[0] = this->unknown_;
+
+  // A real glyph can measure exactly like a skipped byte, but only real glyphs
+  // start the bounding box in Font::measure(). Measuring the candidate in front
+  // of a glyph with a horizontal offset tells the two apart. Without any such
+  // glyph the box always starts at 0 and the distinction doesn't matter.
+  char probe[3] = {};
+  int probe_offset = 0;
+  for (uint16_t codepoint = 1; codepoint <= EXTENDED_LAST && probe[0] == '\0'; codepoint++) {
+    GlyphMetrics metrics = codepoint < 0x80 ? this->ascii_[codepoint] : measure(codepoint);
+    if (metrics.offset_x != 0) {
+      encode(codepoint, probe);
+      probe_offset = metrics.offset_x;
+    }
+  }
+  auto resolve = [&](uint16_t codepoint, GlyphMetrics &metrics) {
+    if (metrics.known || probe[0] == '\0') {
+      return;
+    }
+    char str[6];
+    encode(codepoint, str);
+    strcat(str, probe);
+    font->measure(str, &width, &x_offset, &baseline, &height);
+    metrics.known = x_offset != probe_offset;
+  };
+
+  for (uint16_t c = 1; c < 128; c++) {
+    resolve(c, this->ascii_[c]);
+  }
+  for (uint16_t codepoint = EXTENDED_FIRST; codepoint <= EXTENDED_LAST; codepoint++) {
+    GlyphMetrics metrics = measure(codepoint);
+    resolve(codepoint, metrics);
+    if (metrics.known) {
+      this->extended_.push_back({codepoint, metrics});
+    }
+  }
+  this->extended_.shrink_to_fit();
+}
+
+const GlyphMetrics *TextMetrics::find_extended_(uint16_t codepoint) const {
+  auto it = std::lower_bound(this->extended_.begin(), this->extended_.end(), codepoint,
+                             [](const ExtendedGlyph &glyph, uint16_t cp) { return glyph.codepoint < cp; });
+  if (it == this->extended_.end() || it->codepoint != codepoint) {
+    return nullptr;
+  }
+  return &it->metrics;
+}
+
+GlyphMetrics HOT TextMetrics::next_glyph(const char *text, size_t &pos) const {
+  uint8_t c = text[pos];
+  if (c < 0x80) {
+    pos++;
+    return this->ascii_[c];
+  }
+
+  uint8_t next = text[pos + 1];
+  if (c >= 0xC2 && c <= 0xC5 && (next & 0xC0) == 0x80) {
+    const GlyphMetrics *metrics = this->find_extended_(((c & 0x1F) << 6) | (next & 0x3F));
+    if (metrics != nullptr) {
+      pos += 2;
+      return *metrics;
+    }
+  }
+
+  // Like Font::print(), skip unmatched input one byte at a time
+  pos++;
+  return this->unknown_;
+}
+
+int HOT TextMetrics::width(const char *text) const {
+  int x = 0;
+  int min_x = 0;
+  bool has_char = false;
+  size_t pos = 0;
+  while (text[pos] != '\0') {
+    GlyphMetrics glyph = this->next_glyph(text, pos);
+    if (glyph.known) {
+      min_x = has_char ? std::min(min_x, x + glyph.offset_x) : glyph.offset_x;
+      has_char = true;
+    }
+    x += glyph.advance;
+  }
+  return x - min_x;
+}
+
+int HOT TextMetrics::spaced_width(const char *text, int spacing_px) const {
+  int total = 0;
+  size_t pos = 0;
+  while (text[pos] != '\0') {
+    total += this->next_glyph(text, pos).width();
+    if (text[pos] != '\0') {
+      total += spacing_px;
+    }
+  }
+  return total;
+}
+
+size_t TextMetrics::clip_to_width(const char *text, int max_width, int spacing_px, int *width_out) const {
+  int total = 0;
+  size_t pos = 0;
+  while (text[pos] != '\0') {
+    size_t next = pos;
+    int glyph_width = this->next_glyph(text, next).width();
+    int gap = pos == 0 ? 0 : spacing_px;
+    if (total + gap + glyph_width > max_width) {
+      break;
+    }
+    total += gap + glyph_width;
+    pos = next;
+  }
+  if (width_out != nullptr) {
+    *width_out = total;
+  }
+  return pos;
+}
+
+}  // namespace matrix_render
+}  // namespace esphome
+
+#endif  // MATRIX_RENDER_HAS_FONT
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if __has_include("esphome/components/font/font.h")
+#include "esphome/components/font/font.h"
+#include "esphome/components/memory_placement/placement.h"
+#define MATRIX_RENDER_HAS_FONT
+#endif
+
+#ifdef MATRIX_RENDER_HAS_FONT
+
+namespace esphome {
+namespace matrix_render {
+
+struct GlyphMetrics {
+  int8_t advance = 0;
+  int8_t offset_x = 0;
+  // False for bytes the font has no glyph for, which Font::print() skips one
+  // byte at a time, advancing by the font's first glyph
+  bool known = false;
+
+  // Width of the glyph measured on its own
+  int width() const { return this->advance - this->offset_x; }
+};
+
+// Per-font glyph metrics, measured once so text can be sized without calling
+// Font::measure() per character. ASCII is indexed directly; the extended Latin
+// glyphs (U+0080..U+017F) the font actually has are kept in a small sorted
+// table. Widths match Font::measure() for the same string.
+class TextMetrics {
+  public:
+    // Measure every glyph of the font. Call from setup(), after the font exists.
+    void build(font::Font *font);
+    bool is_built() const { return this->font_ != nullptr; }
+    font::Font *get_font() const { return this->font_; }
+
+    // Metrics of the glyph starting at text[pos]; pos is advanced past it
+    GlyphMetrics next_glyph(const char *text, size_t &pos) const;
+
+    // Same result as the width reported by Font::measure()
+    int width(const char *text) const;
+    int width(const std::string &text) const { return this->width(text.c_str()); }
+
+    // Width when each glyph is drawn on its own with spacing_px between glyphs
+    int spaced_width(const char *text, int spacing_px) const;
+    int spaced_width(const std::string &text, int spacing_px) const {
+      return this->spaced_width(text.c_str(), spacing_px);
+    }
+
+    // Length in bytes of the longest prefix of whole glyphs that fits in
+    // max_width when drawn glyph by glyph with spacing_px between them. Its
+    // width is stored in width_out if given.
+    size_t clip_to_width(const char *text, int max_width, int spacing_px = 0, int *width_out = nullptr) const;
+
+  protected:
+    struct ExtendedGlyph {
+      uint16_t codepoint;
+      GlyphMetrics metrics;
+    };
+
+    const GlyphMetrics *find_extended_(uint16_t codepoint) const;
+
+    font::Font *font_{nullptr};
+    GlyphMetrics ascii_[128];
+    GlyphMetrics unknown_;
+    memory_placement::PlacementVector<ExtendedGlyph, memory_placement::CATEGORY_GLYPH_CACHE> extended_;
+};
+
+}  // namespace matrix_render
+}  // namespace esphome
+
+#endif  // MATRIX_RENDER_HAS_FONT
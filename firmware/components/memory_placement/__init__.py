@@ -0,0 +1,53 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+
+# Placement policy for the trackers' large caches and buffers. Loaded through
+# AUTO_LOAD, so every option is optional; by default the categories prefer
+# PSRAM and fall back to internal RAM on boards without it, except those read
+# on every frame, which stay in internal RAM.
+
+memory_placement_ns = cg.esphome_ns.namespace("memory_placement")
+MemoryPlacement = memory_placement_ns.class_("MemoryPlacement", cg.PollingComponent)
+
+Category = memory_placement_ns.enum("Category")
+CATEGORIES = {
+    "glyph_cache": Category.CATEGORY_GLYPH_CACHE,
+    "timetable": Category.CATEGORY_TIMETABLE,
+    "fixture_cache": Category.CATEGORY_FIXTURE_CACHE,
+    "response_buffer": Category.CATEGORY_RESPONSE_BUFFER,
+    "logo_index": Category.CATEGORY_LOGO_INDEX,
+    "image_cache": Category.CATEGORY_IMAGE_CACHE,
+    "trace_buffer": Category.CATEGORY_TRACE_BUFFER,
+    "zone_buffer": Category.CATEGORY_ZONE_BUFFER,
+    "schedule": Category.CATEGORY_SCHEDULE,
+}
+INTERNAL_BY_DEFAULT = {"schedule"}
+
+Placement = memory_placement_ns.enum("Placement")
+PLACEMENTS = {
+    "external": Placement.PLACEMENT_EXTERNAL,
+    "internal": Placement.PLACEMENT_INTERNAL,
+}
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(MemoryPlacement),
+        **{
+            cv.Optional(
+                category, default="internal" if category in INTERNAL_BY_DEFAULT else "external"
+            ): cv.enum(PLACEMENTS, lower=True)
+            for category in CATEGORIES
+        },
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    for category, category_enum in CATEGORIES.items():
+        cg.add(var.set_placement(category_enum, config[category]))
+
+    cg.add_define("USE_MEMORY_PLACEMENT")
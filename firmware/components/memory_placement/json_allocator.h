@@ -0,0 +1,38 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <ArduinoJson.h>
+
+#include "placement.h"
+
+namespace esphome {
+namespace memory_placement {
+
+#if ARDUINOJSON_VERSION_MAJOR >= 7
+// Places a JsonDocument's pool in the heap chosen for a category:
+//   JsonAllocator allocator(CATEGORY_RESPONSE_BUFFER);
+//   JsonDocument doc(&allocator);
+class JsonAllocator : public ArduinoJson::Allocator {
+  public:
+    explicit JsonAllocator(Category category) : category_(category) {}
+
+    void *allocate(size_t size) override { return memory_placement::allocate(this->category_, size); }
+    void deallocate(void *ptr) override { memory_placement::deallocate(this->category_, ptr); }
+
+    void *reallocate(void *ptr, size_t new_size) override {
+      void *moved = memory_placement::allocate(this->category_, new_size);
+      if (moved != nullptr && ptr != nullptr) {
+        memcpy(moved, ptr, std::min(new_size, get_allocated_size(ptr)));
+        memory_placement::deallocate(this->category_, ptr);
+      }
+      return moved;
+    }
+
+  protected:
+    Category category_;
+};
+#endif
+
+}  // namespace memory_placement
+}  // namespace esphome
@@ -0,0 +1,65 @@
+#include "memory_placement.h"
+
+#include "esphome/core/log.h"
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome {
+namespace memory_placement {
+
+static const char *TAG = "memory_placement";
+
+void MemoryPlacement::dump_config() {
+  ESP_LOGCONFIG(TAG, "Memory Placement:");
+#ifdef USE_ESP32
+  ESP_LOGCONFIG(TAG, "  PSRAM: %u bytes", (unsigned) heap_caps_get_total_size(MALLOC_CAP_SPIRAM));
+#endif
+  for (int i = 0; i < CATEGORY_COUNT; i++) {
+    auto category = static_cast<Category>(i);
+    ESP_LOGCONFIG(TAG, "  %s: %s", category_to_string(category),
+                  get_placement(category) == PLACEMENT_EXTERNAL ? "external" : "internal");
+  }
+}
+
+void MemoryPlacement::update() {
+#ifdef USE_ESP32
+  size_t internal_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+  size_t internal_min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+  size_t internal_largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+  size_t psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+  ESP_LOGD(TAG, "Internal: %u free (low %u, largest block %u), PSRAM: %u free", (unsigned) internal_free,
+           (unsigned) internal_min_free, (unsigned) internal_largest_block, (unsigned) psram_free);
+
+#ifdef USE_SENSOR
+  if (this->internal_free_sensor_ != nullptr) {
+    this->internal_free_sensor_->publish_state(internal_free);
+  }
+  if (this->internal_min_free_sensor_ != nullptr) {
+    this->internal_min_free_sensor_->publish_state(internal_min_free);
+  }
+  if (this->internal_largest_block_sensor_ != nullptr) {
+    this->internal_largest_block_sensor_->publish_state(internal_largest_block);
+  }
+  if (this->psram_free_sensor_ != nullptr) {
+    this->psram_free_sensor_->publish_state(psram_free);
+  }
+#endif
+#endif
+
+  for (int i = 0; i < CATEGORY_COUNT; i++) {
+    auto category = static_cast<Category>(i);
+    if (get_peak_bytes(category) == 0) {
+      continue;
+    }
+
+    ESP_LOGD(TAG, "  %s: %u bytes (%u in PSRAM), peak %u, %u fallbacks", category_to_string(category),
+             (unsigned) get_bytes_in_use(category), (unsigned) get_bytes_external(category),
+             (unsigned) get_peak_bytes(category), (unsigned) get_fallback_count(category));
+  }
+}
+
+}  // namespace memory_placement
+}  // namespace esphome
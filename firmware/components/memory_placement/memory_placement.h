@@ -0,0 +1,41 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+
+#include "placement.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+
+namespace esphome {
+namespace memory_placement {
+
+// Holds the YAML placement policy and periodically reports heap usage, both
+// per category and for the internal and PSRAM heaps as a whole.
+class MemoryPlacement : public PollingComponent {
+  public:
+    void dump_config() override;
+    void update() override;
+
+    void set_placement(Category category, Placement placement) { memory_placement::set_placement(category, placement); }
+
+#ifdef USE_SENSOR
+    void set_internal_free_sensor(sensor::Sensor *sensor) { internal_free_sensor_ = sensor; }
+    void set_internal_min_free_sensor(sensor::Sensor *sensor) { internal_min_free_sensor_ = sensor; }
+    void set_internal_largest_block_sensor(sensor::Sensor *sensor) { internal_largest_block_sensor_ = sensor; }
+    void set_psram_free_sensor(sensor::Sensor *sensor) { psram_free_sensor_ = sensor; }
+#endif
+
+  protected:
+#ifdef USE_SENSOR
+    sensor::Sensor *internal_free_sensor_{nullptr};
+    sensor::Sensor *internal_min_free_sensor_{nullptr};
+    sensor::Sensor *internal_largest_block_sensor_{nullptr};
+    sensor::Sensor *psram_free_sensor_{nullptr};
+#endif
+};
+
+}  // namespace memory_placement
+}  // namespace esphome
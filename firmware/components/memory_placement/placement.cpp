@@ -0,0 +1,149 @@
+#include "placement.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#include "esphome/core/defines.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_ALLOC_AUDIT
+#include "esphome/components/alloc_audit/alloc_scope.h"
+#endif
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome {
+namespace memory_placement {
+
+static const char *TAG = "memory_placement";
+
+// Every block carries its size and heap, so stats stay exact without asking the allocator
+struct alignas(alignof(std::max_align_t)) BlockHeader {
+  uint32_t size;
+  bool external;
+};
+
+struct CategoryState {
+  Placement placement = PLACEMENT_EXTERNAL;
+  std::atomic<size_t> in_use{0};
+  std::atomic<size_t> external{0};
+  std::atomic<size_t> peak{0};
+  std::atomic<uint32_t> fallbacks{0};
+};
+
+static CategoryState category_states[CATEGORY_COUNT];
+
+const char *category_to_string(Category category) {
+  switch (category) {
+    case CATEGORY_GLYPH_CACHE:
+      return "glyph_cache";
+    case CATEGORY_TIMETABLE:
+      return "timetable";
+    case CATEGORY_FIXTURE_CACHE:
+      return "fixture_cache";
+    case CATEGORY_RESPONSE_BUFFER:
+      return "response_buffer";
+    case CATEGORY_LOGO_INDEX:
+      return "logo_index";
+    case CATEGORY_IMAGE_CACHE:
+      return "image_cache";
+    case CATEGORY_TRACE_BUFFER:
+      return "trace_buffer";
+    case CATEGORY_ZONE_BUFFER:
+      return "zone_buffer";
+    case CATEGORY_SCHEDULE:
+      return "schedule";
+    default:
+      return "unknown";
+  }
+}
+
+void set_placement(Category category, Placement placement) { category_states[category].placement = placement; }
+
+Placement get_placement(Category category) { return category_states[category].placement; }
+
+static void *raw_allocate(size_t size, bool external) {
+#ifdef USE_ESP32
+  return heap_caps_malloc(size, (external ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL) | MALLOC_CAP_8BIT);
+#else
+  return external ? nullptr : malloc(size);
+#endif
+}
+
+void *allocate(Category category, size_t size) {
+  CategoryState &state = category_states[category];
+  const size_t total = sizeof(BlockHeader) + size;
+  const bool want_external = state.placement == PLACEMENT_EXTERNAL;
+
+  bool external = want_external;
+  void *block = raw_allocate(total, external);
+  if (block == nullptr) {
+    external = !external;
+    block = raw_allocate(total, external);
+
+    if (block == nullptr) {
+      ESP_LOGE(TAG, "Out of memory allocating %u bytes for %s", (unsigned) size, category_to_string(category));
+      return nullptr;
+    }
+
+    // Boards without PSRAM land here for every external allocation; only a full internal heap is worth a warning
+    if (state.fallbacks++ == 0 && !want_external) {
+      ESP_LOGW(TAG, "Internal RAM exhausted, %s is spilling into PSRAM", category_to_string(category));
+    }
+  }
+
+#if defined(USE_ALLOC_AUDIT) && defined(USE_ESP32)
+  // heap_caps_malloc() doesn't go through the malloc wraps
+  alloc_audit::count_allocation(size);
+#endif
+
+  auto *header = static_cast<BlockHeader *>(block);
+  header->size = size;
+  header->external = external;
+
+  size_t in_use = state.in_use += size;
+  if (external) {
+    state.external += size;
+  }
+
+  size_t peak = state.peak.load();
+  while (in_use > peak && !state.peak.compare_exchange_weak(peak, in_use)) {
+  }
+
+  return header + 1;
+}
+
+void deallocate(Category category, void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  CategoryState &state = category_states[category];
+  auto *header = static_cast<BlockHeader *>(ptr) - 1;
+
+  state.in_use -= header->size;
+  if (header->external) {
+    state.external -= header->size;
+  }
+
+#ifdef USE_ESP32
+  heap_caps_free(header);
+#else
+  free(header);
+#endif
+}
+
+size_t get_allocated_size(const void *ptr) { return (static_cast<const BlockHeader *>(ptr) - 1)->size; }
+
+size_t get_bytes_in_use(Category category) { return category_states[category].in_use.load(); }
+
+size_t get_bytes_external(Category category) { return category_states[category].external.load(); }
+
+size_t get_peak_bytes(Category category) { return category_states[category].peak.load(); }
+
+uint32_t get_fallback_count(Category category) { return category_states[category].fallbacks.load(); }
+
+}  // namespace memory_placement
+}  // namespace esphome
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace esphome {
+namespace memory_placement {
+
+// Bulky, rarely-touched data is tagged with a category so its heap can be
+// chosen from YAML. Per-frame state is either left uncategorized on the
+// default (internal) heap or, when it is worth counting, put in a category
+// that YAML defaults to internal RAM (CATEGORY_SCHEDULE).
+enum Category : uint8_t {
+  CATEGORY_GLYPH_CACHE = 0,
+  CATEGORY_TIMETABLE,
+  CATEGORY_FIXTURE_CACHE,
+  CATEGORY_RESPONSE_BUFFER,
+  CATEGORY_LOGO_INDEX,
+  CATEGORY_IMAGE_CACHE,
+  CATEGORY_TRACE_BUFFER,
+  // The display compositor's per-zone frames
+  CATEGORY_ZONE_BUFFER,
+  // The departures drawn on every frame
+  CATEGORY_SCHEDULE,
+  CATEGORY_COUNT,
+};
+
+enum Placement : uint8_t {
+  // PSRAM when present, internal RAM otherwise
+  PLACEMENT_EXTERNAL = 0,
+  PLACEMENT_INTERNAL,
+};
+
+const char *category_to_string(Category category);
+
+void set_placement(Category category, Placement placement);
+Placement get_placement(Category category);
+
+// Allocates from the heap selected for the category, falling back to the other
+// heap rather than failing. Returns nullptr only when both are exhausted.
+void *allocate(Category category, size_t size);
+void deallocate(Category category, void *ptr);
+// Size requested when ptr was returned by allocate()
+size_t get_allocated_size(const void *ptr);
+
+// Live bytes per category, split by where they actually landed
+size_t get_bytes_in_use(Category category);
+size_t get_bytes_external(Category category);
+size_t get_peak_bytes(Category category);
+uint32_t get_fallback_count(Category category);
+
+// Minimal STL allocator over allocate()/deallocate(). Like RAMAllocator, it
+// returns nullptr instead of throwing when memory runs out.
+template<typename T, Category C> class PlacementAllocator {
+  public:
+    using value_type = T;
+
+    template<typename U> struct rebind {
+      using other = PlacementAllocator<U, C>;
+    };
+
+    PlacementAllocator() = default;
+    template<typename U> PlacementAllocator(const PlacementAllocator<U, C> &) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(memory_placement::allocate(C, n * sizeof(T))); }
+    void deallocate(T *ptr, size_t) { memory_placement::deallocate(C, ptr); }
+
+    template<typename U> bool operator==(const PlacementAllocator<U, C> &) const { return true; }
+    template<typename U> bool operator!=(const PlacementAllocator<U, C> &) const { return false; }
+};
+
+template<Category C> using PlacementString = std::basic_string<char, std::char_traits<char>, PlacementAllocator<char, C>>;
+
+template<typename T, Category C> using PlacementVector = std::vector<T, PlacementAllocator<T, C>>;
+
+template<typename K, typename V, Category C>
+using PlacementMap = std::map<K, V, std::less<K>, PlacementAllocator<std::pair<const K, V>, C>>;
+
+template<typename K, typename V, Category C>
+using PlacementUnorderedMap =
+    std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, PlacementAllocator<std::pair<const K, V>, C>>;
+
+}  // namespace memory_placement
+}  // namespace esphome
@@ -0,0 +1,57 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_BYTES,
+)
+
+from . import MemoryPlacement
+
+DEPENDENCIES = ["memory_placement"]
+
+CONF_MEMORY_PLACEMENT_ID = "memory_placement_id"
+CONF_INTERNAL_FREE = "internal_free"
+CONF_INTERNAL_MIN_FREE = "internal_min_free"
+CONF_INTERNAL_LARGEST_BLOCK = "internal_largest_block"
+CONF_PSRAM_FREE = "psram_free"
+
+_HEAP_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_BYTES,
+    icon=ICON_COUNTER,
+    accuracy_decimals=0,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_MEMORY_PLACEMENT_ID): cv.use_id(MemoryPlacement),
+        cv.Optional(CONF_INTERNAL_FREE): _HEAP_SCHEMA,
+        cv.Optional(CONF_INTERNAL_MIN_FREE): _HEAP_SCHEMA,
+        cv.Optional(CONF_INTERNAL_LARGEST_BLOCK): _HEAP_SCHEMA,
+        cv.Optional(CONF_PSRAM_FREE): _HEAP_SCHEMA,
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_MEMORY_PLACEMENT_ID])
+
+    if internal_free := config.get(CONF_INTERNAL_FREE):
+        sens = await sensor.new_sensor(internal_free)
+        cg.add(parent.set_internal_free_sensor(sens))
+
+    if internal_min_free := config.get(CONF_INTERNAL_MIN_FREE):
+        sens = await sensor.new_sensor(internal_min_free)
+        cg.add(parent.set_internal_min_free_sensor(sens))
+
+    if internal_largest_block := config.get(CONF_INTERNAL_LARGEST_BLOCK):
+        sens = await sensor.new_sensor(internal_largest_block)
+        cg.add(parent.set_internal_largest_block_sensor(sens))
+
+    if psram_free := config.get(CONF_PSRAM_FREE):
+        sens = await sensor.new_sensor(psram_free)
+        cg.add(parent.set_psram_free_sensor(sens))
@@ -1,11 +1,12 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import display, font, time as time_, image
-from esphome.components.http_request import CONF_HTTP_REQUEST_ID, HttpRequestComponent
+from esphome.components.connection_manager import CONF_CONNECTION_MANAGER_ID, ConnectionManager
 from esphome.const import CONF_ID, CONF_DISPLAY_ID, CONF_TIME_ID
 
 DEPENDENCIES = ["network", "http_request"]
-AUTO_LOAD = ["json"]
+AUTO_LOAD = ["json", "watchdog", "matrix_render", "memory_placement", "connection_manager", "trace_recorder",
+             "alloc_audit"]
 
 soccer_tracker_ns = cg.esphome_ns.namespace("soccer_tracker")
 SoccerTracker = soccer_tracker_ns.class_("SoccerTracker", cg.Component)
@@ -16,6 +17,35 @@ CONF_API_KEY = "api_key"
 CONF_FAVORITE_TEAM = "favorite_team"
 CONF_TEAM_ID = "team_id"
 CONF_TEAM_LOGOS = "team_logos"
+CONF_POLL_INTERVALS = "poll_intervals"
+CONF_SCHEDULED = "scheduled"
+CONF_TODAY = "today"
+CONF_LIVE = "live"
+CONF_PUSH_URL = "push_url"
+CONF_TEAMS = "teams"
+CONF_LEAGUE_ID = "league_id"
+CONF_SEASON = "season"
+CONF_ROTATE_INTERVAL = "rotate_interval"
+CONF_SEASON_CACHE = "season_cache"
+
+# Logo filenames look like "atlanta-united-footballlogos-org_14x14.png"
+LOGO_FILENAME_SUFFIX = "-footballlogos-org"
+
+
+def logo_team_name(key):
+    """Team name a team_logos key stands for: a logo filename or the name itself."""
+    if LOGO_FILENAME_SUFFIX in key:
+        return key[: key.index(LOGO_FILENAME_SUFFIX)].replace("-", " ")
+    return key
+
+
+def validate_ws_url(value):
+    url = cv.url(value)
+    if not value.startswith("ws://") and not value.startswith("wss://"):
+        raise cv.Invalid("URL must start with 'ws://' or 'wss://")
+
+    return url
+
 
 CONFIG_SCHEMA = cv.Schema(
     {
@@ -24,13 +54,24 @@ CONFIG_SCHEMA = cv.Schema(
         cv.GenerateID(CONF_FONT_ID): cv.use_id(font.Font),
         cv.GenerateID(CONF_SMALL_FONT_ID): cv.use_id(font.Font),
         cv.GenerateID(CONF_TIME_ID): cv.use_id(time_.RealTimeClock),
-        cv.GenerateID(CONF_HTTP_REQUEST_ID): cv.use_id(HttpRequestComponent),
+        cv.GenerateID(CONF_CONNECTION_MANAGER_ID): cv.use_id(ConnectionManager),
         cv.Required(CONF_API_KEY): cv.string,
         cv.Required(CONF_FAVORITE_TEAM): cv.string,
         cv.Required(CONF_TEAM_ID): cv.positive_int,
+        cv.Optional(CONF_TEAMS, default=[]): cv.ensure_list(cv.positive_int),
+        cv.Optional(CONF_LEAGUE_ID, default=253): cv.positive_int,
+        cv.Optional(CONF_SEASON): cv.int_range(min=2000, max=2100),
+        cv.Optional(CONF_ROTATE_INTERVAL, default="10s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_SEASON_CACHE, default=True): cv.boolean,
         cv.Optional(CONF_TEAM_LOGOS, default={}): cv.Schema({
             cv.string: cv.use_id(image.Image_)
         }),
+        cv.Optional(CONF_POLL_INTERVALS, default={}): cv.Schema({
+            cv.Optional(CONF_SCHEDULED, default="6h"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_TODAY, default="10min"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_LIVE, default="30s"): cv.positive_time_period_milliseconds,
+        }),
+        cv.Optional(CONF_PUSH_URL): validate_ws_url,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -51,15 +92,38 @@ async def to_code(config):
     time_var = await cg.get_variable(config[CONF_TIME_ID])
     cg.add(var.set_rtc(time_var))
 
-    http_request_var = await cg.get_variable(config[CONF_HTTP_REQUEST_ID])
-    cg.add(var.set_http_request(http_request_var))
+    connection_manager = await cg.get_variable(config[CONF_CONNECTION_MANAGER_ID])
+    cg.add(var.set_connection_manager(connection_manager))
+    # Its sync is what hands the clock over from the servers to the time source
+    cg.add(connection_manager.set_time(time_var))
 
     cg.add(var.set_api_key(config[CONF_API_KEY]))
     cg.add(var.set_favorite_team(config[CONF_FAVORITE_TEAM]))
     cg.add(var.set_team_id(config[CONF_TEAM_ID]))
+    for team_id in config[CONF_TEAMS]:
+        cg.add(var.add_team(team_id))
+    cg.add(var.set_league_id(config[CONF_LEAGUE_ID]))
+    if CONF_SEASON in config:
+        cg.add(var.set_season(config[CONF_SEASON]))
+    cg.add(var.set_rotate_interval(config[CONF_ROTATE_INTERVAL]))
+    if config[CONF_SEASON_CACHE]:
+        cg.add_define("USE_SOCCER_SEASON_CACHE")
+        cg.add(var.set_season_cache(True))
+        cg.add_library("LittleFS", None)
+
+    poll_intervals = config[CONF_POLL_INTERVALS]
+    cg.add(var.set_scheduled_interval(poll_intervals[CONF_SCHEDULED]))
+    cg.add(var.set_pending_interval(poll_intervals[CONF_TODAY]))
+    cg.add(var.set_live_interval(poll_intervals[CONF_LIVE]))
+
+    if CONF_PUSH_URL in config:
+        cg.add_define("USE_SOCCER_PUSH")
+        cg.add(var.set_push_url(config[CONF_PUSH_URL]))
+        cg.add_library(
+            "ArduinoWebsockets", None, "https://github.com/tjhorner/ArduinoWebsockets"
+        )
 
-    # Register team logos
-    if CONF_TEAM_LOGOS in config:
-        for team_name, logo_id in config[CONF_TEAM_LOGOS].items():
-            logo = await cg.get_variable(logo_id)
-            cg.add(var.register_team_logo(team_name, logo))
+    # Images from YAML take precedence over the built-in logo atlas
+    for key, logo_id in config[CONF_TEAM_LOGOS].items():
+        logo = await cg.get_variable(logo_id)
+        cg.add(var.register_team_logo(logo_team_name(key), logo))
@@ -0,0 +1,237 @@
+#include "chunked_reader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/components/trace_recorder/trace.h"
+
+namespace esphome {
+namespace soccer_tracker {
+
+static const char *TAG = "soccer_tracker.reader";
+
+// Anything bigger than this is a framing error rather than a real chunk
+static const size_t MAX_CHUNK_SIZE = 1 << 20;
+
+ChunkedReader::ChunkedReader(http_request::HttpContainer *container, uint32_t timeout)
+    : container_(container), timeout_(timeout) {
+  size_t content_length = container->content_length;
+  this->raw_remaining_ = (content_length == 0 || content_length == SIZE_MAX) ? SIZE_MAX : content_length;
+}
+
+bool ChunkedReader::fill_() {
+  if (this->raw_remaining_ == 0) {
+    return false;
+  }
+
+  uint32_t last_progress = millis();
+  while (true) {
+    size_t wanted = std::min(sizeof(this->buffer_), this->raw_remaining_);
+    int read_len = this->container_->read(this->buffer_, wanted);
+
+    if (read_len > 0) {
+      TRACE_INSTANT("http read", read_len);
+      this->buffer_pos_ = 0;
+      this->buffer_len_ = read_len;
+      if (this->raw_remaining_ != SIZE_MAX) {
+        this->raw_remaining_ -= read_len;
+      }
+      return true;
+    }
+
+    if (read_len < 0) {
+      return false;
+    }
+
+    if (millis() - last_progress > this->timeout_) {
+      ESP_LOGW(TAG, "Timed out waiting for response body after %u bytes", (unsigned) this->bytes_read_);
+      return false;
+    }
+
+    // Runs on the fetch thread, so waiting here doesn't hold up the display
+    delay(10);
+  }
+}
+
+int ChunkedReader::peek_raw_() {
+  if (this->buffer_pos_ == this->buffer_len_ && !this->fill_()) {
+    return -1;
+  }
+  return this->buffer_[this->buffer_pos_];
+}
+
+int ChunkedReader::read_raw_() {
+  int c = this->peek_raw_();
+  if (c >= 0) {
+    this->buffer_pos_++;
+  }
+  return c;
+}
+
+bool ChunkedReader::detect_framing_() {
+  int c = this->peek_raw_();
+  if (c < 0) {
+    return false;
+  }
+  this->chunked_ = isxdigit(c);
+  this->state_ = this->chunked_ ? STATE_CHUNK_SIZE : STATE_BODY;
+  return true;
+}
+
+void ChunkedReader::end_chunk_header_() {
+  // The last chunk is followed by trailers, if any, and an empty line
+  this->state_ = this->chunk_remaining_ == 0 ? STATE_TRAILER : STATE_CHUNK_DATA;
+}
+
+int ChunkedReader::read() {
+  while (true) {
+    switch (this->state_) {
+      case STATE_START: {
+        if (!this->detect_framing_()) {
+          return -1;
+        }
+        break;
+      }
+
+      case STATE_BODY: {
+        int c = this->read_raw_();
+        if (c >= 0) {
+          this->bytes_read_++;
+        }
+        return c;
+      }
+
+      case STATE_CHUNK_SIZE: {
+        int c = this->read_raw_();
+        if (c < 0) {
+          return -1;
+        }
+
+        if (isxdigit(c)) {
+          int digit = isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+          this->chunk_remaining_ = (this->chunk_remaining_ << 4) + digit;
+          if (this->chunk_remaining_ > MAX_CHUNK_SIZE) {
+            ESP_LOGW(TAG, "Chunk size out of range");
+            this->state_ = STATE_DONE;
+          }
+        } else if (c == ';') {
+          this->state_ = STATE_CHUNK_EXTENSION;
+        } else if (c == '\n') {
+          this->end_chunk_header_();
+        } else if (c != '\r') {
+          ESP_LOGW(TAG, "Malformed chunk header");
+          this->state_ = STATE_DONE;
+        }
+        break;
+      }
+
+      case STATE_CHUNK_EXTENSION: {
+        int c = this->read_raw_();
+        if (c < 0) {
+          return -1;
+        }
+        if (c == '\n') {
+          this->end_chunk_header_();
+        }
+        break;
+      }
+
+      case STATE_CHUNK_DATA: {
+        int c = this->read_raw_();
+        if (c < 0) {
+          return -1;
+        }
+        this->bytes_read_++;
+        if (--this->chunk_remaining_ == 0) {
+          this->state_ = STATE_CHUNK_END;
+        }
+        return c;
+      }
+
+      case STATE_CHUNK_END: {
+        // CRLF after the chunk data, then the next size line
+        int c = this->read_raw_();
+        if (c < 0) {
+          return -1;
+        }
+        if (c == '\n') {
+          this->state_ = STATE_CHUNK_SIZE;
+        }
+        break;
+      }
+
+      case STATE_TRAILER: {
+        // Trailer fields are of no interest, but they must be read off the
+        // wire, or the kept-alive connection would be closed as dirty
+        int c = this->read_raw_();
+        if (c < 0) {
+          return -1;
+        }
+        if (c == '\n') {
+          if (this->trailer_line_empty_) {
+            this->state_ = STATE_DONE;
+          }
+          this->trailer_line_empty_ = true;
+        } else if (c != '\r') {
+          this->trailer_line_empty_ = false;
+        }
+        break;
+      }
+
+      case STATE_DONE:
+      default:
+        return -1;
+    }
+  }
+}
+
+size_t ChunkedReader::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+  while (count < length) {
+    bool in_data = this->state_ == STATE_BODY || this->state_ == STATE_CHUNK_DATA;
+    if (in_data && this->buffer_pos_ < this->buffer_len_) {
+      // Copy straight out of the receive buffer up to the end of the chunk
+      size_t n = std::min(length - count, this->buffer_len_ - this->buffer_pos_);
+      if (this->state_ == STATE_CHUNK_DATA) {
+        n = std::min(n, this->chunk_remaining_);
+        this->chunk_remaining_ -= n;
+        if (this->chunk_remaining_ == 0) {
+          this->state_ = STATE_CHUNK_END;
+        }
+      }
+
+      memcpy(buffer + count, this->buffer_ + this->buffer_pos_, n);
+      this->buffer_pos_ += n;
+      this->bytes_read_ += n;
+      count += n;
+      continue;
+    }
+
+    int c = this->read();
+    if (c < 0) {
+      break;
+    }
+    buffer[count++] = c;
+  }
+  return count;
+}
+
+void ChunkedReader::drain() {
+  // Nothing was read, so the framing isn't known yet
+  if (this->state_ == STATE_START && !this->detect_framing_()) {
+    return;
+  }
+  if (!this->chunked_ && this->raw_remaining_ == SIZE_MAX) {
+    // The body runs to the end of the connection, which can't be reused anyway
+    return;
+  }
+  char scratch[64];
+  while (this->readBytes(scratch, sizeof(scratch)) > 0) {
+  }
+}
+
+}  // namespace soccer_tracker
+}  // namespace esphome
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esphome/components/http_request/http_request.h"
+
+namespace esphome {
+namespace soccer_tracker {
+
+// Presents an HTTP response body to ArduinoJson as a byte stream, undoing
+// chunked transfer encoding on the fly. Only one receive buffer is held, so
+// memory use doesn't depend on the size of the response.
+//
+// http_request hands over the raw socket stream, so chunk framing shows up in
+// the body; it is detected from the first byte, since a JSON body can't start
+// with a hex digit.
+class ChunkedReader {
+  public:
+    ChunkedReader(http_request::HttpContainer *container, uint32_t timeout);
+
+    // ArduinoJson custom reader interface
+    int read();
+    size_t readBytes(char *buffer, size_t length);
+    // Reads and discards the rest of the body, so a kept-alive connection is
+    // left at the start of the next response
+    void drain();
+
+    size_t get_bytes_read() const { return bytes_read_; }
+    bool is_chunked() const { return chunked_; }
+
+  protected:
+    enum State : uint8_t {
+      STATE_START,
+      STATE_BODY,
+      STATE_CHUNK_SIZE,
+      STATE_CHUNK_EXTENSION,
+      STATE_CHUNK_DATA,
+      STATE_CHUNK_END,
+      STATE_TRAILER,
+      STATE_DONE,
+    };
+
+    bool fill_();
+    int peek_raw_();
+    int read_raw_();
+    // Chunked or not, from the first byte of the body
+    bool detect_framing_();
+    void end_chunk_header_();
+
+    http_request::HttpContainer *container_;
+    uint32_t timeout_;
+
+    uint8_t buffer_[256];
+    size_t buffer_pos_ = 0;
+    size_t buffer_len_ = 0;
+    // Bytes left on the wire when Content-Length is known, SIZE_MAX otherwise
+    size_t raw_remaining_;
+
+    State state_ = STATE_START;
+    bool chunked_ = false;
+    size_t chunk_remaining_ = 0;
+    // Whether the trailer line being read is still empty
+    bool trailer_line_empty_ = true;
+    size_t bytes_read_ = 0;
+};
+
+}  // namespace soccer_tracker
+}  // namespace esphome
@@ -0,0 +1,96 @@
+#include "fixture_table.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace soccer_tracker {
+
+static uint8_t clamp_score(int score) { return std::min(std::max(score, 0), 255); }
+
+void FixtureTable::store(const Match &match) {
+  Fixture fixture;
+  fixture.id = match.fixture_id;
+  fixture.kickoff = match.match_time;
+  fixture.finish_time = match.finish_time;
+  fixture.home_id = match.home_team.id;
+  fixture.away_id = match.away_team.id;
+  fixture.home_name = this->intern_(match.home_team.name);
+  fixture.away_name = this->intern_(match.away_team.name);
+  fixture.home_score = clamp_score(match.home_team.score);
+  fixture.away_score = clamp_score(match.away_team.score);
+  fixture.state = match.state;
+
+  auto it = std::find_if(this->fixtures_.begin(), this->fixtures_.end(),
+                         [&fixture](const Fixture &f) { return f.id == fixture.id; });
+  if (it != this->fixtures_.end()) {
+    this->fixtures_.erase(it);
+  }
+
+  // Kickoffs move when matches are rescheduled, so the slot is found afresh
+  auto pos = std::upper_bound(this->fixtures_.begin(), this->fixtures_.end(), fixture,
+                              [](const Fixture &a, const Fixture &b) { return a.kickoff < b.kickoff; });
+  this->fixtures_.insert(pos, fixture);
+}
+
+void FixtureTable::load(const Fixture &fixture, Match &out) const {
+  out.fixture_id = fixture.id;
+  out.match_time = fixture.kickoff;
+  out.finish_time = fixture.finish_time;
+  out.state = fixture.state;
+  out.home_team.id = fixture.home_id;
+  out.home_team.name = this->name(fixture.home_name);
+  out.home_team.score = fixture.home_score;
+  out.away_team.id = fixture.away_id;
+  out.away_team.name = this->name(fixture.away_name);
+  out.away_team.score = fixture.away_score;
+}
+
+Fixture *FixtureTable::find(uint32_t id) {
+  for (auto &fixture : this->fixtures_) {
+    if (fixture.id == id)
+      return &fixture;
+  }
+  return nullptr;
+}
+
+const Fixture *FixtureTable::find(uint32_t id) const { return const_cast<FixtureTable *>(this)->find(id); }
+
+void FixtureTable::keep_next_per_team(const std::vector<uint32_t> &team_ids) {
+  // Fixtures are in kickoff order, so a team's first unstarted fixture is its next one
+  std::vector<bool> seen(team_ids.size(), false);
+  this->remove_if([&](const Fixture &fixture) {
+    if (fixture.state == IN_PROGRESS || fixture.state == FINISHED)
+      return false;
+    bool next_for_any = false;
+    for (size_t i = 0; i < team_ids.size(); i++) {
+      if (!seen[i] && fixture.involves(team_ids[i])) {
+        seen[i] = true;
+        next_for_any = true;
+      }
+    }
+    return !next_for_any;
+  });
+}
+
+uint16_t FixtureTable::intern_(const std::string &name) {
+  for (size_t pos = 0; pos < this->names_.size(); pos += strlen(this->names_.c_str() + pos) + 1) {
+    if (name == this->names_.c_str() + pos)
+      return pos;
+  }
+  uint16_t offset = this->names_.size();
+  this->names_.append(name.c_str(), name.size() + 1);
+  return offset;
+}
+
+void FixtureTable::compact_names_() {
+  auto old_names = std::move(this->names_);
+  this->names_.clear();
+  for (auto &fixture : this->fixtures_) {
+    fixture.home_name = this->intern_(old_names.c_str() + fixture.home_name);
+    fixture.away_name = this->intern_(old_names.c_str() + fixture.away_name);
+  }
+}
+
+}  // namespace soccer_tracker
+}  // namespace esphome
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "esphome/components/memory_placement/placement.h"
+
+namespace esphome {
+namespace soccer_tracker {
+
+enum MatchState : uint8_t {
+  SCHEDULED,      // Match is scheduled but not today
+  TODAY_PENDING,  // Match is today but hasn't started
+  IN_PROGRESS,    // Match is currently being played
+  FINISHED        // Match just finished (show for 1 hour)
+};
+
+struct Team {
+  uint32_t id = 0;
+  std::string name;
+  int score = 0;
+};
+
+// A fixture as parsed from the API and as drawn
+struct Match {
+  uint32_t fixture_id = 0;
+  Team home_team;
+  Team away_team;
+  time_t match_time = 0;
+  MatchState state = SCHEDULED;
+  time_t finish_time = 0; // Time when match finished (for FINISHED state)
+};
+
+// A fixture as stored in the table: 28 bytes, with each team name kept once
+// in the table's name pool however many fixtures it appears in
+struct Fixture {
+  uint32_t id;
+  uint32_t kickoff;      // Epoch seconds
+  uint32_t finish_time;  // Epoch seconds, 0 until seen finished
+  uint32_t home_id;
+  uint32_t away_id;
+  uint16_t home_name;  // Offsets into the name pool
+  uint16_t away_name;
+  uint8_t home_score;
+  uint8_t away_score;
+  MatchState state;
+
+  bool involves(uint32_t team_id) const { return this->home_id == team_id || this->away_id == team_id; }
+};
+
+// The fixtures being followed, ordered by kickoff
+class FixtureTable {
+  public:
+    using Fixtures = memory_placement::PlacementVector<Fixture, memory_placement::CATEGORY_FIXTURE_CACHE>;
+
+    // Adds the match, or updates the fixture with the same id
+    void store(const Match &match);
+    // Expands a fixture back into a match, names included
+    void load(const Fixture &fixture, Match &out) const;
+
+    Fixture *find(uint32_t id);
+    const Fixture *find(uint32_t id) const;
+
+    // Keeps every started fixture and, per team, the earliest one still to be played
+    void keep_next_per_team(const std::vector<uint32_t> &team_ids);
+    // Removes the fixtures pred() returns true for and drops names no longer used
+    template<typename Pred> void remove_if(Pred pred) {
+      size_t kept = 0;
+      for (size_t i = 0; i < this->fixtures_.size(); i++) {
+        if (!pred(this->fixtures_[i])) {
+          this->fixtures_[kept++] = this->fixtures_[i];
+        }
+      }
+      if (kept != this->fixtures_.size()) {
+        this->fixtures_.resize(kept);
+        this->compact_names_();
+      }
+    }
+
+    const char *name(uint16_t offset) const { return this->names_.c_str() + offset; }
+    size_t names_size() const { return this->names_.size(); }
+
+    Fixtures::const_iterator begin() const { return this->fixtures_.begin(); }
+    Fixtures::const_iterator end() const { return this->fixtures_.end(); }
+    Fixtures::iterator begin() { return this->fixtures_.begin(); }
+    Fixtures::iterator end() { return this->fixtures_.end(); }
+    size_t size() const { return this->fixtures_.size(); }
+    bool empty() const { return this->fixtures_.empty(); }
+    void clear() {
+      this->fixtures_.clear();
+      this->names_.clear();
+    }
+
+  protected:
+    uint16_t intern_(const std::string &name);
+    void compact_names_();
+
+    Fixtures fixtures_;
+    // Team names, each terminated by '\0'
+    memory_placement::PlacementString<memory_placement::CATEGORY_FIXTURE_CACHE> names_;
+};
+
+}  // namespace soccer_tracker
+}  // namespace esphome
@@ -0,0 +1,181 @@
+#include "season_cache.h"
+
+#include <algorithm>
+#include <string>
+
+#include "esphome/core/defines.h"
+#include "esphome/core/log.h"
+
+#ifdef USE_SOCCER_SEASON_CACHE
+#include <LittleFS.h>
+#endif
+
+namespace esphome {
+namespace soccer_tracker {
+
+static const char *TAG = "soccer_tracker.season_cache";
+
+static constexpr size_t MAX_NAME_LENGTH = 64;
+
+bool SeasonCache::mount() {
+#ifdef USE_SOCCER_SEASON_CACHE
+  // Mounted at /littlefs; an unformatted partition is formatted on first use
+  if (!LittleFS.begin(true)) {
+    ESP_LOGW(TAG, "Could not mount LittleFS");
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint32_t SeasonCache::make_key(std::vector<uint32_t> team_ids, int league_id, int season) {
+  // FNV-1a over the sorted team ids, the league and the season
+  std::sort(team_ids.begin(), team_ids.end());
+
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](const void *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ static_cast<const uint8_t *>(data)[i]) * 16777619u;
+    }
+  };
+  mix(team_ids.data(), team_ids.size() * sizeof(uint32_t));
+  mix(&league_id, sizeof(league_id));
+  mix(&season, sizeof(season));
+  return hash;
+}
+
+bool SeasonCache::open() {
+  this->close();
+  this->file_ = fopen(this->path_, "rb");
+  if (this->file_ == nullptr) {
+    return false;
+  }
+
+  if (fread(&this->header_, sizeof(Header), 1, this->file_) != 1 || this->header_.magic != MAGIC ||
+      this->header_.record_size != sizeof(Fixture)) {
+    ESP_LOGW(TAG, "Ignoring %s: not a season cache of this version", this->path_);
+    this->close();
+    return false;
+  }
+
+  fseek(this->file_, 0, SEEK_END);
+  long expected = sizeof(Header) + (long) this->header_.count * sizeof(Fixture) + this->header_.names_size;
+  if (ftell(this->file_) != expected) {
+    ESP_LOGW(TAG, "Ignoring %s: truncated", this->path_);
+    this->close();
+    return false;
+  }
+
+  return true;
+}
+
+void SeasonCache::close() {
+  if (this->file_ != nullptr) {
+    fclose(this->file_);
+    this->file_ = nullptr;
+  }
+}
+
+bool SeasonCache::write(const FixtureTable &fixtures, uint32_t key, time_t fetched_at) {
+  this->close();
+
+  // Written under a temporary name and renamed, so a reset mid-write leaves the old file
+  std::string temp_path = std::string(this->path_) + ".tmp";
+  FILE *file = fopen(temp_path.c_str(), "wb");
+  if (file == nullptr) {
+    ESP_LOGW(TAG, "Could not create %s", temp_path.c_str());
+    return false;
+  }
+
+  Header header{};
+  header.magic = MAGIC;
+  header.record_size = sizeof(Fixture);
+  header.count = std::min<size_t>(fixtures.size(), UINT16_MAX);
+  header.fetched_at = fetched_at;
+  header.key = key;
+  header.names_size = fixtures.names_size();
+
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  if (header.count > 0) {
+    ok = ok && fwrite(&*fixtures.begin(), sizeof(Fixture), header.count, file) == header.count;
+  }
+  ok = ok && fwrite(fixtures.name(0), 1, header.names_size, file) == header.names_size;
+  ok = fclose(file) == 0 && ok;
+
+  if (!ok || rename(temp_path.c_str(), this->path_) != 0) {
+    ESP_LOGW(TAG, "Could not write %s", this->path_);
+    remove(temp_path.c_str());
+    return false;
+  }
+
+  ESP_LOGD(TAG, "Cached %u fixtures in %s (%u bytes)", header.count, this->path_,
+           (unsigned) (sizeof(header) + header.count * sizeof(Fixture) + header.names_size));
+  return this->open();
+}
+
+bool SeasonCache::find_next(uint32_t team_id, time_t after, Match &out) {
+  if (this->file_ == nullptr) {
+    return false;
+  }
+
+  // First record kicking off at or after `after`
+  size_t low = 0;
+  size_t high = this->header_.count;
+  Fixture fixture;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (!this->read_record_(mid, fixture)) {
+      return false;
+    }
+    if ((time_t) fixture.kickoff < after) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  // A single team's file matches at once; a shared one skips other clubs' fixtures
+  for (size_t index = low; index < this->header_.count; index++) {
+    if (!this->read_record_(index, fixture)) {
+      return false;
+    }
+    if (fixture.involves(team_id)) {
+      out.fixture_id = fixture.id;
+      out.match_time = fixture.kickoff;
+      out.finish_time = 0;
+      out.state = fixture.state;
+      out.home_team.id = fixture.home_id;
+      out.home_team.score = fixture.home_score;
+      out.away_team.id = fixture.away_id;
+      out.away_team.score = fixture.away_score;
+      return this->read_name_(fixture.home_name, out.home_team.name) &&
+             this->read_name_(fixture.away_name, out.away_team.name);
+    }
+  }
+  return false;
+}
+
+bool SeasonCache::read_record_(size_t index, Fixture &out) {
+  long offset = sizeof(Header) + (long) index * sizeof(Fixture);
+  return fseek(this->file_, offset, SEEK_SET) == 0 && fread(&out, sizeof(Fixture), 1, this->file_) == 1;
+}
+
+bool SeasonCache::read_name_(uint16_t offset, std::string &out) {
+  if (offset >= this->header_.names_size) {
+    return false;
+  }
+  long position = sizeof(Header) + (long) this->header_.count * sizeof(Fixture) + offset;
+  char name[MAX_NAME_LENGTH + 1];
+  size_t length = std::min<size_t>(this->header_.names_size - offset, MAX_NAME_LENGTH);
+  if (fseek(this->file_, position, SEEK_SET) != 0 || fread(name, 1, length, this->file_) != length) {
+    return false;
+  }
+  name[length] = '\0';
+  out = name;
+  return true;
+}
+
+}  // namespace soccer_tracker
+}  // namespace esphome
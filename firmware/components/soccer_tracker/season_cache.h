@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+#include "fixture_table.h"
+
+namespace esphome {
+namespace soccer_tracker {
+
+// The rest of a season's fixtures in a flash file, so "next match" is a
+// local lookup instead of an API call, and is known right after a reboot.
+//
+// Layout: a Header, then `count` Fixture records ordered by kickoff, then the
+// '\0'-separated name pool the records' name offsets point into. Records are
+// fixed-size, so lookups binary-search the file without loading it.
+class SeasonCache {
+  public:
+    static constexpr uint32_t MAGIC = 0x31435353;  // "SSC1"
+
+    struct Header {
+      uint32_t magic;
+      uint16_t record_size;
+      uint16_t count;
+      uint32_t fetched_at;  // Epoch seconds of the download
+      uint32_t key;         // What the file covers, see make_key()
+      uint32_t names_size;
+    };
+
+    // Mounts the filesystem; false if there is none
+    static bool mount();
+    // Identifies the teams, league and season a file was downloaded for
+    static uint32_t make_key(std::vector<uint32_t> team_ids, int league_id, int season);
+
+    explicit SeasonCache(const char *path) : path_(path) {}
+    ~SeasonCache() { this->close(); }
+
+    // Opens the file and checks its header; false if it is missing or corrupt
+    bool open();
+    void close();
+    bool write(const FixtureTable &fixtures, uint32_t key, time_t fetched_at);
+
+    bool is_open() const { return this->file_ != nullptr; }
+    const Header &get_header() const { return this->header_; }
+    const char *get_path() const { return this->path_; }
+
+    // The first fixture of team_id kicking off at or after `after`
+    bool find_next(uint32_t team_id, time_t after, Match &out);
+
+  protected:
+    bool read_record_(size_t index, Fixture &out);
+    bool read_name_(uint16_t offset, std::string &out);
+
+    const char *path_;
+    FILE *file_ = nullptr;
+    Header header_{};
+};
+
+}  // namespace soccer_tracker
+}  // namespace esphome
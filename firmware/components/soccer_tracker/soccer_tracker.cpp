@@ -1,97 +1,32 @@
 #include "soccer_tracker.h"
+#include "chunked_reader.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include "esphome/components/json/json_util.h"
 #include "esphome/components/network/util.h"
+#include "esphome/components/matrix_render/logo_atlas.h"
+#include "esphome/components/matrix_render/span_buffer.h"
+#include "esphome/components/memory_placement/json_allocator.h"
+#include "esphome/components/alloc_audit/alloc_scope.h"
+#include "esphome/components/trace_recorder/trace.h"
 #include <ctime>
 #include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <sys/time.h>
 #include "esphome/components/web_server_base/web_server_base.h"
+#include "esphome/components/watchdog/watchdog.h"
+
+#ifdef USE_ESP32
+#include <esp_pthread.h>
+#include <esp_task_wdt.h>
+#endif
 
 namespace esphome {
 namespace soccer_tracker {
 
 static const char *TAG = "soccer_tracker";
 
-// Helper function: Chunked-transfer decoding that handles multiple chunks
-static bool dechunk_(const std::string &in, std::string &out) {
-  size_t pos = 0;
-  out.clear();
-
-  // Check if this looks like chunked encoding
-  size_t first_crlf = in.find("\r\n", 0);
-  if (first_crlf == std::string::npos || first_crlf == 0) {
-    // No chunk header or empty, treat as non-chunked
-    out = in;
-    return true;
-  }
-
-  // Check if first line is a hex number
-  std::string first_line = in.substr(0, first_crlf);
-  if (first_line.empty() || !isxdigit(first_line[0])) {
-    // Not chunked encoding
-    out = in;
-    return true;
-  }
-
-  // Process all chunks
-  while (pos < in.size()) {
-    // Find chunk size line
-    size_t line_end = in.find("\r\n", pos);
-    if (line_end == std::string::npos) {
-      // Incomplete - return what we have
-      return out.size() > 0;
-    }
-
-    std::string size_str = in.substr(pos, line_end - pos);
-    
-    // Parse hex chunk size
-    size_t chunk_size = 0;
-    for (char c : size_str) {
-      uint8_t v;
-      if (c >= '0' && c <= '9') v = c - '0';
-      else if (c >= 'a' && c <= 'f') v = 10 + (c - 'a');
-      else if (c >= 'A' && c <= 'F') v = 10 + (c - 'A');
-      else {
-        // Invalid hex - if we have data, return it
-        return out.size() > 0;
-      }
-      chunk_size = (chunk_size << 4) + v;
-    }
-
-    pos = line_end + 2;  // skip CRLF after chunk size
-
-    if (chunk_size == 0) {
-      // Final chunk (0\r\n) - we're done
-      return true;
-    }
-
-    // Extract chunk data
-    size_t available = in.size() - pos;
-    if (available < chunk_size) {
-      // Incomplete chunk - take what we can get
-      if (available > 0) {
-        out.append(in, pos, available);
-      }
-      return out.size() > 0;
-    }
-
-    // Full chunk available
-    out.append(in, pos, chunk_size);
-    pos += chunk_size;
-
-    // Skip CRLF after chunk data
-    if (pos + 2 <= in.size() && in[pos] == '\r' && in[pos + 1] == '\n') {
-      pos += 2;
-    } else {
-      // Missing CRLF but we have data
-      return out.size() > 0;
-    }
-  }
-
-  return out.size() > 0;
-}
-
 // Helper function to parse ISO 8601 datetime
 static bool parse_iso8601(const std::string &datetime_str, time_t &result) {
   struct tm tm_time = {};
@@ -111,9 +46,79 @@ static bool parse_iso8601(const std::string &datetime_str, time_t &result) {
   return result != -1;
 }
 
+// Start of the local calendar day containing t
+static time_t local_day_start(time_t t) {
+  struct tm tm_time;
+  localtime_r(&t, &tm_time);
+  tm_time.tm_hour = 0;
+  tm_time.tm_min = 0;
+  tm_time.tm_sec = 0;
+  tm_time.tm_isdst = -1;
+  return mktime(&tm_time);
+}
+
+// State of a match from its API-Football status code
+static MatchState state_for_status(const std::string &status, time_t match_time, time_t now) {
+  if (status == "1H" || status == "2H" || status == "HT" || status == "ET" || status == "BT" || status == "P" || status == "LIVE") {
+    return IN_PROGRESS;
+  }
+  if (status == "FT" || status == "AET" || status == "PEN") {
+    return FINISHED;
+  }
+  // Not Started / Scheduled - match day is a local calendar day. A match
+  // that is late to kick off stays pending for the rest of its day.
+  if ((status == "NS" || status == "TBD") && local_day_start(now) == local_day_start(match_time)) {
+    return TODAY_PENDING;
+  }
+  return SCHEDULED;
+}
+
+#ifdef USE_SOCCER_PUSH
+// Wall clock in epoch milliseconds; only meaningful once the RTC has synced
+static int64_t wall_clock_ms() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+#endif
+
 void SoccerTracker::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Soccer Tracker...");
 
+  this->fetch_backoff_ = this->connection_manager_->make_backoff();
+#ifdef USE_SOCCER_PUSH
+  this->push_backoff_ = this->connection_manager_->make_backoff();
+#endif
+
+  this->team_ids_.push_back(this->team_id_);
+  for (int team_id : this->extra_team_ids_) {
+    if (std::find(this->team_ids_.begin(), this->team_ids_.end(), (uint32_t) team_id) == this->team_ids_.end()) {
+      this->team_ids_.push_back(team_id);
+    }
+  }
+  if (this->multi_team_()) {
+    this->set_interval("rotate", this->rotate_interval_, [this]() { this->rotate_fixture_(); });
+  }
+
+  if (this->season_cache_enabled_) {
+    if (SeasonCache::mount()) {
+      // A missing or stale file is replaced by the first poll
+      this->season_cache_.open();
+    } else {
+      this->season_cache_enabled_ = false;
+    }
+  }
+
+  this->font_metrics_.build(this->font_);
+  this->small_font_metrics_.build(this->small_font_);
+
+  // Built-in logos come after the team_logos option, which takes precedence
+  for (const auto &logo : matrix_render::LOGO_ATLAS) {
+    TeamLogo entry;
+    entry.atlas = &logo.image;
+    this->register_logo_(logo.name, entry);
+  }
+
   // Register a simple config endpoint on the embedded web server
   if (web_server_base::global_web_server_base != nullptr) {
     auto server = web_server_base::global_web_server_base->get_server();
@@ -166,446 +171,1192 @@ void SoccerTracker::setup() {
     }
   }
   
-  // Check immediately if RTC is already valid
-  if (this->rtc_->now().is_valid()) {
-    ESP_LOGI(TAG, "RTC already valid at setup, doing initial fetch now");
-    this->fetch_match_data_();
-    // initial_fetch_done_ will be set to true by fetch_match_data_ if successful
-  } else {
-    ESP_LOGW(TAG, "RTC not yet valid at setup, will retry");
-  }
-  
-  // Check for RTC validity every 2 seconds and do initial fetch when ready
-  this->set_interval("rtc_check", 2000, [this]() {
-    bool rtc_valid = this->rtc_->now().is_valid();
-    if (!this->initial_fetch_done_ && rtc_valid) {
-      ESP_LOGI(TAG, "RTC now valid, starting initial fetch");
-      this->fetch_match_data_();
-      // initial_fetch_done_ will be set to true by fetch_match_data_ if successful
-    }
+#ifdef USE_SOCCER_PUSH
+  // A wss:// push URL gets a client whose reconnects resume TLS sessions
+  this->push_client_ = connection_manager::make_websocket_client(this->connection_manager_, this->push_url_);
+  this->push_client_.onMessage([this](websockets::WebsocketsMessage message) {
+    this->on_push_message_(message);
   });
-  
-  // Set up periodic fetching (will only run after initial fetch succeeds)
-  this->set_interval("fetch_matches", FETCH_INTERVAL, [this]() {
-    ESP_LOGD(TAG, "Periodic fetch check: initial_fetch_done=%d", this->initial_fetch_done_);
-    if (this->initial_fetch_done_) {
-      // In test mode, also enforce a faster polling interval
-      if (this->test_mode_) {
-        if (millis() - this->last_fetch_ >= 10000) {
-          this->fetch_match_data_();
-        }
-      } else {
-        this->fetch_match_data_();
-      }
+
+  this->push_client_.onEvent([this](websockets::WebsocketsEvent event, String data) {
+    this->on_push_event_(event, data);
+  });
+
+  this->connect_push_();
+#endif
+
+  // The servers' names are looked up while SNTP syncs. Until the first
+  // fixtures are in, the network coming up starts a poll at once rather than
+  // at the next retry.
+  this->connection_manager_->prefetch(this->api_server_());
+#ifdef USE_SOCCER_PUSH
+  this->connection_manager_->prefetch(this->push_url_);
+#endif
+  this->connection_manager_->add_on_network_ready_callback([this]() {
+    if (!this->initial_fetch_done_) {
+      this->poll_requested_ = true;
     }
+#ifdef USE_SOCCER_PUSH
+    this->cancel_timeout("push_reconnect");
+    this->connect_push_();
+#endif
   });
+
+  // Polls are chained timeouts; each one picks its own interval (see next_poll_interval_())
+  this->poll_();
 }
 
 void SoccerTracker::loop() {
-  // Update display every second
-  if (millis() - this->last_update_ >= UPDATE_INTERVAL) {
-    this->last_update_ = millis();
-    
-    if (this->has_match_data_) {
-      this->update_match_state_();
-      this->colon_visible_ = !this->colon_visible_; // Toggle for heartbeat effect
-    }
+  if (this->fetch_complete_) {
+    this->finish_fetch_();
+  }
+
+  if (this->poll_requested_) {
+    this->poll_requested_ = false;
+    this->schedule_poll_(0);
+  }
+
+#ifdef USE_SOCCER_PUSH
+  this->push_client_.poll();
+
+  if (this->last_push_heartbeat_ != 0 && millis() - this->last_push_heartbeat_ > PUSH_HEARTBEAT_TIMEOUT) {
+    ESP_LOGW(TAG, "Push heartbeat timeout, reconnecting");
+    this->push_client_.close();
+    this->connect_push_();
   }
+#endif
 }
 
 void SoccerTracker::dump_config() {
   ESP_LOGCONFIG(TAG, "Soccer Tracker:");
   ESP_LOGCONFIG(TAG, "  Favorite Team: %s", this->favorite_team_.c_str());
   ESP_LOGCONFIG(TAG, "  Team ID: %d", this->team_id_);
-  ESP_LOGCONFIG(TAG, "  Registered Logos: %d", this->team_logos_.size());
+  if (this->multi_team_()) {
+    ESP_LOGCONFIG(TAG, "  Teams: %u, batched through league %d", (unsigned) this->team_ids_.size(), this->league_id_);
+    ESP_LOGCONFIG(TAG, "  Rotate interval: %us", this->rotate_interval_ / 1000);
+  }
+  if (this->season_cache_enabled_) {
+    if (this->season_cache_.is_open()) {
+      ESP_LOGCONFIG(TAG, "  Season cache: %s, %u fixtures", this->season_cache_.get_path(),
+                    this->season_cache_.get_header().count);
+    } else {
+      ESP_LOGCONFIG(TAG, "  Season cache: %s, empty", this->season_cache_.get_path());
+    }
+  }
+  ESP_LOGCONFIG(TAG, "  Logo Index: %u names", (unsigned) this->logo_index_.size());
+  ESP_LOGCONFIG(TAG, "  Poll intervals: scheduled %us, today %us, live %us", this->scheduled_interval_ / 1000,
+                this->pending_interval_ / 1000, this->live_interval_ / 1000);
+#ifdef USE_SOCCER_PUSH
+  ESP_LOGCONFIG(TAG, "  Push URL: %s", this->push_url_.c_str());
+#endif
 }
 
-void SoccerTracker::fetch_match_data_() {
-  if (!network::is_connected()) {
-    ESP_LOGW(TAG, "Not connected to network, skipping fetch");
-    return;
+void SoccerTracker::poll_() {
+  if (this->season_cache_active_() && this->rtc_->now().is_valid()) {
+    this->update_from_season_cache_();
+    if (this->can_skip_fetch_(this->rtc_->now().timestamp)) {
+      ESP_LOGV(TAG, "Next fixtures known from the season cache, nothing to fetch");
+      this->schedule_poll_(this->next_poll_interval_(true));
+      return;
+    }
   }
-  
-  if (!this->rtc_->now().is_valid()) {
-    ESP_LOGW(TAG, "RTC time not valid, skipping fetch");
+
+  if (!this->fetch_match_data_()) {
+    // Nothing was sent (no network yet, or a fetch is running); check again shortly
+    this->schedule_poll_(PRECONDITION_RETRY_INTERVAL);
+  }
+}
+
+void SoccerTracker::schedule_poll_(uint32_t delay) {
+  ESP_LOGV(TAG, "Next poll in %ums", delay);
+  this->set_timeout("poll", delay, [this]() { this->poll_(); });
+}
+
+uint32_t SoccerTracker::next_poll_interval_(bool last_fetch_ok) {
+  if (this->test_mode_) {
+    return TEST_POLL_INTERVAL;
+  }
+
+  time_t now = this->rtc_->now().timestamp;
+  uint32_t interval;
+
+  MatchState state = this->most_urgent_state_(now);
+  if (!last_fetch_ok) {
+    interval = this->fetch_backoff_.next_delay();
+  } else if (!this->has_match_data_) {
+    interval = ERROR_RETRY_INTERVAL;
+  } else {
+    switch (state) {
+      case IN_PROGRESS:
+        interval = this->live_interval_;
+#ifdef USE_SOCCER_PUSH
+        // Goals and status changes arrive over the push channel; polls only back it up
+        if (this->push_live_()) {
+          interval = this->pending_interval_;
+        }
+#endif
+        break;
+      case TODAY_PENDING: {
+        // Land the next poll on kickoff rather than up to one interval after it
+        uint32_t until_kickoff = std::max<time_t>(0, this->next_kickoff_(now) - now) * 1000;
+        interval = std::min(this->pending_interval_, std::max(this->live_interval_, until_kickoff));
+        break;
+      }
+      case FINISHED:
+        interval = this->pending_interval_;
+        break;
+      case SCHEDULED:
+      default:
+        interval = this->scheduled_interval_;
+        break;
+    }
+  }
+
+  if (this->minute_quota_exhausted_) {
+    interval = std::max<uint32_t>(interval, 60000);
+  }
+
+  // Spread what's left of the daily quota over the time until it resets at 00:00 UTC,
+  // keeping a reserve that only a live match may spend
+  if (this->quota_remaining_ >= 0) {
+    uint32_t until_reset = (86400 - now % 86400) * 1000;
+    int reserve = state == IN_PROGRESS ? 0 : QUOTA_RESERVE;
+    int usable = this->quota_remaining_ - reserve;
+    uint32_t quota_interval = usable > 0 ? until_reset / usable : until_reset;
+
+    if (quota_interval > interval) {
+      ESP_LOGD(TAG, "Stretching poll interval to %us to stay within quota (%d left)", quota_interval / 1000,
+               this->quota_remaining_);
+      interval = quota_interval;
+    }
+  }
+
+  return interval;
+}
+
+MatchState SoccerTracker::most_urgent_state_(time_t now) const {
+  // Live beats today's kickoffs, which beat a recent result, which beats the rest
+  static const uint8_t URGENCY[] = {0, 2, 3, 1};  // Indexed by MatchState
+  MatchState state = SCHEDULED;
+  for (const auto &fixture : this->fixtures_) {
+    if (!this->is_expired_(fixture, now) && URGENCY[fixture.state] > URGENCY[state]) {
+      state = fixture.state;
+    }
+  }
+  return state;
+}
+
+time_t SoccerTracker::next_kickoff_(time_t now) const {
+  // The table is in kickoff order
+  for (const auto &fixture : this->fixtures_) {
+    if (fixture.state == TODAY_PENDING) {
+      return fixture.kickoff;
+    }
+  }
+  return now;
+}
+
+bool SoccerTracker::has_next_fixture_(uint32_t team_id) const {
+  return std::any_of(this->fixtures_.begin(), this->fixtures_.end(), [team_id](const Fixture &fixture) {
+    return fixture.involves(team_id) && fixture.state != FINISHED;
+  });
+}
+
+bool SoccerTracker::season_refresh_due_(time_t now) const {
+  if (!this->season_cache_.is_open() || this->season_cache_.get_header().key != this->season_cache_key_()) {
+    return true;
+  }
+  time_t age = now - (time_t) this->season_cache_.get_header().fetched_at;
+  if (age >= SEASON_REFRESH_INTERVAL) {
+    return true;
+  }
+  // A team with nothing left in the file may have had fixtures added since (playoffs, a new season)
+  return age >= SEASON_RETRY_INTERVAL &&
+         !std::all_of(this->team_ids_.begin(), this->team_ids_.end(),
+                      [this](uint32_t team_id) { return this->has_next_fixture_(team_id); });
+}
+
+void SoccerTracker::update_from_season_cache_() {
+  if (!this->season_cache_.is_open() || this->season_cache_.get_header().key != this->season_cache_key_()) {
     return;
   }
+
+  time_t now = this->rtc_->now().timestamp;
+  size_t count = this->fixtures_.size();
+  this->fixtures_.remove_if([this, now](const Fixture &fixture) { return this->is_expired_(fixture, now); });
+  bool changed = this->fixtures_.size() != count;
+
+  for (uint32_t team_id : this->team_ids_) {
+    if (this->has_next_fixture_(team_id)) {
+      continue;
+    }
+    // Matches that kicked off a while ago may still be on, and are confirmed by the next fetch
+    Match match;
+    time_t after = now - FULLTIME_AFTER;
+    bool found;
+    while ((found = this->season_cache_.find_next(team_id, after, match)) &&
+           this->fixtures_.find(match.fixture_id) != nullptr) {
+      after = match.match_time + 1;  // Already in the table, finished
+    }
+    if (!found) {
+      continue;
+    }
+    // The file's scores and statuses are as old as the file; only the schedule is trusted
+    bool today = match.match_time <= now || local_day_start(match.match_time) == local_day_start(now);
+    match.state = today ? TODAY_PENDING : SCHEDULED;
+    match.home_team.score = 0;
+    match.away_team.score = 0;
+    ESP_LOGD(TAG, "Next fixture of team %u from the season cache: %s vs %s", team_id, match.home_team.name.c_str(),
+             match.away_team.name.c_str());
+    this->fixtures_.store(match);
+    changed = true;
+  }
+
+  if (changed) {
+    this->has_match_data_ = !this->fixtures_.empty();
+    this->show_fixture_();
+    this->arm_transition_timer_();
+    this->request_frame_();
+  }
+}
+
+bool SoccerTracker::can_skip_fetch_(time_t now) const {
+  if (this->season_refresh_due_(now)) {
+    return false;
+  }
+  // Only the day's matches need the network
+  return std::none_of(this->fixtures_.begin(), this->fixtures_.end(), [](const Fixture &fixture) {
+    return fixture.state == TODAY_PENDING || fixture.state == IN_PROGRESS;
+  });
+}
+
+std::string SoccerTracker::api_server_() const {
+  // Allow override via local test server when in test mode
+  if (this->test_mode_ && !this->test_server_url_.empty()) {
+    std::string server = this->test_server_url_;
+    if (server.rfind("http://", 0) != 0 && server.rfind("https://", 0) != 0) {
+      server = std::string("http://") + server;
+    }
+    return server;
+  }
+  return "https://v3.football.api-sports.io";
+}
+
+bool SoccerTracker::fetch_match_data_() {
+  ALLOC_SCOPE("fetch_match_data");
+  if (!this->connection_manager_->is_network_ready()) {
+    ESP_LOGW(TAG, "Network not ready, skipping fetch");
+    return false;
+  }
   
-  if (this->api_key_.empty() || this->team_id_ == 0) {
+  if (this->api_key_.empty() || this->team_ids_.empty() || this->team_id_ == 0) {
     ESP_LOGW(TAG, "API key or team ID not configured");
-    return;
+    return false;
   }
   
-  if (this->http_request_ == nullptr) {
-    ESP_LOGE(TAG, "HTTP request component not initialized!");
-    return;
+  if (this->fetch_in_flight_) {
+    ESP_LOGV(TAG, "Fetch already in progress");
+    return false;
   }
-  
-  ESP_LOGD(TAG, "Fetching match data for team %d", this->team_id_);
-  
-  // Build the API URL for team fixtures. Allow override via local test server when in test mode.
-  char url[256];
-  if (this->test_mode_ && !this->test_server_url_.empty()) {
-    std::string base = this->test_server_url_;
-    if (base.rfind("http://", 0) != 0 && base.rfind("https://", 0) != 0) {
-      base = std::string("http://") + base;
+
+  std::string server = this->api_server_();
+  std::string base = server + "/fixtures?";
+
+  FetchRequest request;
+  char query[64];
+  time_t now = this->rtc_->now().timestamp;
+
+  if (!this->rtc_->now().is_valid()) {
+    // Which fixtures to ask for depends on the date. Rather than wait for
+    // SNTP, the clock is read off the API server: API-Football's status
+    // doesn't count against the quota.
+    ESP_LOGD(TAG, "No time yet, asking the API server for it");
+    request.urls.push_back(server + "/status");
+    request.clock_probe = true;
+  } else if (this->season_cache_active_()) {
+    // The schedule comes from the season cache, so only the day's matches are
+    // refreshed, by id, plus each team's whole season when the file is due
+    std::string ids;
+    size_t id_count = 0;
+    for (const auto &fixture : this->fixtures_) {
+      if (fixture.state == TODAY_PENDING || fixture.state == IN_PROGRESS) {
+        ids += id_count++ == 0 ? "" : "-";
+        ids += std::to_string(fixture.id);
+      }
     }
-    snprintf(url, sizeof(url), "%s/fixtures", base.c_str());
-  } else {
+    if (!ids.empty()) {
+      request.urls.push_back(base + "ids=" + ids);
+    }
+    if (this->season_refresh_due_(now)) {
+      for (uint32_t team_id : this->team_ids_) {
+        snprintf(query, sizeof(query), "team=%u&season=%d", team_id, this->current_season_());
+        request.urls.push_back(base + query);
+      }
+      request.season = true;
+      request.not_before = local_day_start(now);
+    }
+    ESP_LOGD(TAG, "Fetching %u fixtures of the day%s", (unsigned) id_count,
+             request.season ? " and the teams' season" : "");
+  } else if (!this->multi_team_()) {
     // API-Football: next=1 for single upcoming fixture
-    snprintf(url, sizeof(url), "https://v3.football.api-sports.io/fixtures?team=%d&next=1", 
-             this->team_id_);
+    ESP_LOGD(TAG, "Fetching match data for team %d", this->team_id_);
+    snprintf(query, sizeof(query), "team=%d&next=1", this->team_id_);
+    request.urls.push_back(base + query);
+  } else {
+    // Batched: the fixtures already known to be under way are refreshed by id,
+    // up to 20 per request, and the next fixture of every team is looked up in
+    // a single league request. Only teams that request misses (other leagues,
+    // long breaks) cost a request of their own.
+    std::string ids;
+    size_t id_count = 0;
+    auto flush_ids = [&]() {
+      if (!ids.empty()) {
+        request.urls.push_back(base + "ids=" + ids);
+        ids.clear();
+      }
+    };
+    bool needs_discovery = now - this->last_discovery_ >= (time_t) (this->scheduled_interval_ / 1000);
+    for (const auto &fixture : this->fixtures_) {
+      bool started = fixture.state == IN_PROGRESS || (fixture.state == TODAY_PENDING && (time_t) fixture.kickoff <= now);
+      if (started) {
+        if (id_count++ % MAX_IDS_PER_REQUEST == 0) {
+          flush_ids();
+        } else {
+          ids += "-";
+        }
+        ids += std::to_string(fixture.id);
+      } else if (fixture.state == FINISHED && this->is_expired_(fixture, now)) {
+        needs_discovery = true;
+      }
+    }
+    flush_ids();
+
+    // Every team needs an upcoming fixture in the table
+    for (uint32_t team_id : this->team_ids_) {
+      needs_discovery |= !this->has_next_fixture_(team_id);
+    }
+
+    if (needs_discovery || request.urls.empty()) {
+      snprintf(query, sizeof(query), "league=%d&season=%d&next=%d", this->league_id_, this->current_season_(),
+               LEAGUE_LOOKAHEAD);
+      request.urls.push_back(base + query);
+      request.teams = this->team_ids_;
+      request.team_url_prefix = base + "team=";
+    }
+    ESP_LOGD(TAG, "Fetching fixtures for %u teams: %u batched requests%s", (unsigned) this->team_ids_.size(),
+             (unsigned) request.urls.size(), request.teams.empty() ? "" : " and a lookup of next fixtures");
   }
-  
-  ESP_LOGD(TAG, "API URL: %s", url);
+
+  for (const auto &url : request.urls) {
+    ESP_LOGD(TAG, "API URL: %s", url.c_str());
+  }
+  request.empty_ok = this->multi_team_() || this->season_cache_active_();
   
   // Prepare headers for API-Football
-  std::list<http_request::Header> headers;
-  headers.push_back(http_request::Header{"x-apisports-key", this->api_key_});
+  request.headers.push_back(http_request::Header{"x-apisports-key", this->api_key_});
   // Force plain (non-gzip) response so ArduinoJson can parse without a decompressor
-  headers.push_back(http_request::Header{"Accept-Encoding", "identity"});
+  request.headers.push_back(http_request::Header{"Accept-Encoding", "identity"});
+
+  // Conditional request: an unchanged fixture comes back as an empty 304. Only
+  // a single request can be conditional; batches always fetch in full.
+  const std::string &url = request.urls.front();
+  if (request.clock_probe) {
+    // Leaves the validators for the fixture request that follows
+  } else if (request.urls.size() == 1 && request.teams.empty()) {
+    if (this->validator_url_ == url) {
+      if (!this->etag_.empty()) {
+        request.headers.push_back(http_request::Header{"If-None-Match", this->etag_});
+      }
+      if (!this->last_modified_.empty()) {
+        request.headers.push_back(http_request::Header{"If-Modified-Since", this->last_modified_});
+      }
+    }
+    this->validator_url_ = url;
+  } else {
+    this->validator_url_.clear();
+  }
   
-  // Make synchronous HTTP GET request (ESPHome's http_request doesn't support async callbacks)
+  // http_request only offers a blocking get(), so the request runs on its own
+  // thread and the result is picked up by loop() once fetch_complete_ is set
+  this->fetch_in_flight_ = true;
+#ifdef USE_ESP32
+  esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+  cfg.thread_name = "soccer_fetch";
+  cfg.stack_size = FETCH_STACK_SIZE;
+  cfg.pin_to_core = 0;
+  esp_pthread_set_cfg(&cfg);
+#endif
+  this->fetch_thread_ = std::thread(&SoccerTracker::fetch_task_, this, std::move(request));
+  return true;
+}
+
+void SoccerTracker::fetch_task_(FetchRequest request) {
+#ifdef USE_ESP32
+  // http_request feeds the task watchdog, which only works for subscribed tasks
+  esp_task_wdt_add(nullptr);
+#endif
+  TRACE_SCOPE("fetch");
+  ALLOC_SCOPE("fetch");
+
+  this->fetch_result_ = FetchResult{};
+  FetchResult &result = this->fetch_result_;
+  if (request.clock_probe) {
+    // The response sets the clock on arrival, so the body is of no interest.
+    // It is still read to the end, leaving the kept-alive connection at the
+    // start of the next response for the fixture request that follows.
+    auto response = this->connection_manager_->get(request.urls.front(), request.headers, {});
+    if (response != nullptr) {
+      ChunkedReader reader(response.get(), READ_TIMEOUT);
+      reader.drain();
+      response->end();
+    }
+    result.clock_probe = true;
+#ifdef USE_ESP32
+    esp_task_wdt_delete(nullptr);
+#endif
+    this->fetch_complete_ = true;
+    return;
+  }
+
+  bool ok = true;
+  for (const auto &url : request.urls) {
+    ok = this->download_fixtures_(url, request, result) && ok;
+  }
+
+  if (!request.teams.empty() && ok) {
+    // Teams the league request didn't reach are looked up one by one
+    for (uint32_t team_id : request.teams) {
+      bool found = std::any_of(result.fixtures.begin(), result.fixtures.end(), [team_id](const Fixture &fixture) {
+        return fixture.involves(team_id) && fixture.state != FINISHED;
+      });
+      if (!found) {
+        ESP_LOGD(TAG, "No upcoming league fixture for team %u, asking for it directly", team_id);
+        std::string team_url = request.team_url_prefix + std::to_string(team_id) + "&next=1";
+        ok = this->download_fixtures_(team_url, request, result) && ok;
+      }
+    }
+    result.fixtures.keep_next_per_team(request.teams);
+    result.discovery = ok;
+  }
+  if (request.season && ok) {
+    // Played fixtures are of no use to the cache
+    time_t not_before = request.not_before;
+    result.fixtures.remove_if([not_before](const Fixture &fixture) { return (time_t) fixture.kickoff < not_before; });
+    result.season = true;
+  }
+  result.parsed = ok && !result.not_modified;
+
+#ifdef USE_ESP32
+  esp_task_wdt_delete(nullptr);
+#endif
+
+  // Publishes fetch_result_ to loop(); the task doesn't touch it afterwards
+  this->fetch_complete_ = true;
+}
+
+void SoccerTracker::finish_fetch_() {
+  this->fetch_thread_.join();
+  this->fetch_complete_ = false;
+  this->fetch_in_flight_ = false;
+  this->last_fetch_ = millis();
+
+  FetchResult &result = this->fetch_result_;
+
+  if (result.clock_probe) {
+    // With the clock set, the fixtures are fetched right away
+    bool clock_set = this->rtc_->now().is_valid();
+    if (clock_set) {
+      this->fetch_backoff_.reset();
+    }
+    this->schedule_poll_(clock_set ? 0 : this->next_poll_interval_(false));
+    return;
+  }
+
+  if (result.quota_remaining >= 0) {
+    this->quota_remaining_ = result.quota_remaining;
+    this->quota_limit_ = result.quota_limit;
+    ESP_LOGD(TAG, "API quota: %d of %d requests left today", this->quota_remaining_, this->quota_limit_);
+  }
+  this->minute_quota_exhausted_ = result.minute_quota_remaining == 0;
+  if (result.parsed || result.not_modified) {
+    this->fetch_backoff_.reset();
+  }
+
+  if (result.not_modified) {
+    ESP_LOGD(TAG, "Fixture unchanged since last fetch");
+  } else if (result.parsed) {
+    time_t now = this->rtc_->now().timestamp;
+    this->etag_ = std::move(result.etag);
+    this->last_modified_ = std::move(result.last_modified);
+
+    if (result.season) {
+      if (!this->season_cache_.write(result.fixtures, this->season_cache_key_(), now)) {
+        // Without a file every poll would download the season again
+        ESP_LOGW(TAG, "Season cache disabled");
+        this->season_cache_enabled_ = false;
+      }
+      // Only each team's next fixture goes into the table; the rest stays in the file
+      result.fixtures.keep_next_per_team(this->team_ids_);
+      result.discovery = true;
+    }
+
+    if (!this->multi_team_()) {
+      // The single team's next fixture replaces whatever was there
+      for (const auto &fixture : this->fixtures_) {
+        Fixture *fetched = result.fixtures.find(fixture.id);
+        if (fetched != nullptr && fetched->state == FINISHED && fixture.state == FINISHED) {
+          fetched->finish_time = fixture.finish_time;
+        }
+      }
+      this->fixtures_ = std::move(result.fixtures);
+    } else {
+      if (result.discovery) {
+        // Unstarted fixtures the lookup no longer returns were rescheduled or
+        // superseded; finished ones go once their hour is up
+        this->last_discovery_ = now;
+        this->fixtures_.remove_if([&](const Fixture &fixture) {
+          bool unstarted = fixture.state == SCHEDULED || fixture.state == TODAY_PENDING;
+          return (unstarted && result.fixtures.find(fixture.id) == nullptr) || this->is_expired_(fixture, now);
+        });
+      }
+      Match match;
+      for (const auto &fetched : result.fixtures) {
+        result.fixtures.load(fetched, match);
+        // A match that was already over keeps the time it was first seen finished
+        const Fixture *known = this->fixtures_.find(match.fixture_id);
+        if (known != nullptr && known->state == FINISHED && match.state == FINISHED) {
+          match.finish_time = known->finish_time;
+        }
+        this->fixtures_.store(match);
+      }
+    }
+
+    this->has_match_data_ = !this->fixtures_.empty();
+    this->show_fixture_();
+    this->arm_transition_timer_();
+    this->request_frame_();
+
+    // Mark initial fetch as done only after successful parse
+    if (!this->initial_fetch_done_) {
+      this->initial_fetch_done_ = true;
+      ESP_LOGI(TAG, "Initial fetch successful, %u fixtures available", (unsigned) this->fixtures_.size());
+      this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_FIRST_DATA);
+    }
+  }
+
+  this->schedule_poll_(this->next_poll_interval_(result.parsed || result.not_modified));
+}
+
+void SoccerTracker::show_fixture_() {
+  const Fixture *fixture = this->fixtures_.find(this->current_match_.fixture_id);
+  if (fixture == nullptr && !this->fixtures_.empty()) {
+    fixture = &*this->fixtures_.begin();
+    if (this->multi_team_()) {
+      // Start from the first fixture the rotation would show
+      this->current_match_.fixture_id = 0;
+      this->rotate_fixture_();
+      return;
+    }
+  }
+  if (fixture != nullptr) {
+    this->load_current_(*fixture);
+  }
+}
+
+void SoccerTracker::load_current_(const Fixture &fixture) {
+  this->fixtures_.load(fixture, this->current_match_);
+  this->get_team_logo_(this->current_match_.home_team.name);
+  this->get_team_logo_(this->current_match_.away_team.name);
+}
+
+void SoccerTracker::rotate_fixture_() {
+  if (this->fixtures_.empty() || !this->rtc_->now().is_valid()) {
+    return;
+  }
+
+  // Matches under way, due today or just finished take the screen; only when
+  // there are none does the rotation go through every team's next fixture
+  time_t now = this->rtc_->now().timestamp;
+  auto relevant = [this, now](const Fixture &fixture) {
+    return fixture.state != SCHEDULED && !this->is_expired_(fixture, now);
+  };
+  bool any_relevant = std::any_of(this->fixtures_.begin(), this->fixtures_.end(), relevant);
+
+  // The next eligible fixture after the one on display, wrapping around
+  const Fixture *first = nullptr;
+  const Fixture *next = nullptr;
+  bool past_current = false;
+  for (const auto &fixture : this->fixtures_) {
+    if (any_relevant && !relevant(fixture)) {
+      continue;
+    }
+    if (first == nullptr) {
+      first = &fixture;
+    }
+    if (past_current) {
+      next = &fixture;
+      break;
+    }
+    past_current = fixture.id == this->current_match_.fixture_id;
+  }
+  if (next == nullptr) {
+    next = first;
+  }
+
+  if (next != nullptr && next->id != this->current_match_.fixture_id) {
+    this->load_current_(*next);
+    this->request_frame_();
+  }
+}
+
+bool SoccerTracker::download_fixtures_(const std::string &url, const FetchRequest &request, FetchResult &result) {
+  static const char *const ETAG = "etag";
+  static const char *const LAST_MODIFIED = "last-modified";
+  // API-Football's daily and per-minute rate limit headers
+  static const char *const DAILY_LIMIT = "x-ratelimit-requests-limit";
+  static const char *const DAILY_REMAINING = "x-ratelimit-requests-remaining";
+  static const char *const MINUTE_REMAINING = "x-ratelimit-remaining";
+
   ESP_LOGD(TAG, "Making HTTP GET request...");
-  auto response = this->http_request_->get(url, headers);
+  // Over a kept-alive connection, so only the first request in a while pays for a TLS handshake
+  TRACE_BEGIN("http request");
+  auto response = this->connection_manager_->get(url, request.headers,
+                                                 {ETAG, LAST_MODIFIED, DAILY_LIMIT, DAILY_REMAINING, MINUTE_REMAINING});
+  TRACE_END("http request");
   ESP_LOGD(TAG, "HTTP request returned");
   
   if (response == nullptr) {
     ESP_LOGW(TAG, "HTTP request returned null response");
-    this->last_fetch_ = millis();
-    return;
+    return false;
   }
   
   ESP_LOGD(TAG, "HTTP response status: %d, content_length: %zu", response->status_code, response->content_length);
-  
+
+  auto header_int = [&response](const char *name) {
+    std::string value = response->get_response_header(name);
+    return value.empty() ? -1 : atoi(value.c_str());
+  };
+  result.quota_limit = header_int(DAILY_LIMIT);
+  result.quota_remaining = header_int(DAILY_REMAINING);
+  result.minute_quota_remaining = header_int(MINUTE_REMAINING);
+
+  if (response->status_code == 304) {
+    result.not_modified = true;
+    response->end();
+    return true;
+  }
+
   if (response->status_code != 200) {
     ESP_LOGW(TAG, "HTTP request failed with code: %d", response->status_code);
-    this->last_fetch_ = millis();
+    if (response->status_code == 429) {
+      result.minute_quota_remaining = 0;
+    }
     response->end();
-    return;
+    return false;
   }
+
+  result.etag = response->get_response_header(ETAG);
+  result.last_modified = response->get_response_header(LAST_MODIFIED);
   
-  // Read response body; stop cleanly at Content-Length to avoid extra reads
-  std::string response_str;
-  size_t max_length = 8192;  // 8KB safety cap
-  response_str.reserve(max_length);
+  ChunkedReader reader(response.get(), READ_TIMEOUT);
 
-  uint8_t buf[256];
-  unsigned long read_timeout = millis() + 2000;  // 2s timeout
-  int consecutive_short_reads = 0;
-  int idle_reads = 0;
-  const bool length_known = (response->content_length > 0 && response->content_length < max_length);
+  // Parse straight off the socket; the filter drops everything but the fixture
+  // fields, so the document stays small however large the response is
+#if ARDUINOJSON_VERSION_MAJOR >= 7
+  JsonDocument filter;
+  memory_placement::JsonAllocator allocator(memory_placement::CATEGORY_RESPONSE_BUFFER);
+  JsonDocument doc(&allocator);
+#else
+  StaticJsonDocument<256> filter;
+  DynamicJsonDocument doc(2048);
+#endif
+  filter["errors"] = true;
+  JsonObject fixture_filter = filter["response"][0].to<JsonObject>();
+  fixture_filter["fixture"]["id"] = true;
+  fixture_filter["fixture"]["date"] = true;
+  fixture_filter["fixture"]["status"] = true;
+  for (const char *side : {"home", "away"}) {
+    JsonObject team_filter = fixture_filter["teams"][side].to<JsonObject>();
+    team_filter["id"] = true;
+    team_filter["name"] = true;
+    team_filter["goals"] = true;
+  }
+  fixture_filter["goals"] = true;
 
-  // Small delay to ensure response body is ready
-  delay(25);
+  // Reads happen inside parsing, so "http read" events show up within "parse"
+  TRACE_BEGIN("parse");
+  DeserializationError error = deserializeJson(doc, reader, DeserializationOption::Filter(filter));
+  reader.drain();
+  response->end();
+  TRACE_END("parse");
 
-  while (response_str.size() < max_length && millis() < read_timeout) {
-    // If length is known and we've read enough, stop
-    if (length_known && response_str.size() >= response->content_length) {
-      break;
-    }
+  ESP_LOGD(TAG, "Streamed %u body bytes (%s)", (unsigned) reader.get_bytes_read(),
+           reader.is_chunked() ? "chunked" : "identity");
 
-    int read_len = response->read(buf, sizeof(buf));
-    ESP_LOGD(TAG, "Read attempt: %d bytes", read_len);
+  if (error) {
+    ESP_LOGW(TAG, "JSON parse error: %s", error.c_str());
+    return false;
+  }
 
-    if (read_len > 0) {
-      response_str.append((char *)buf, read_len);
-      read_timeout = millis() + 2000;  // reset timeout on progress
-      idle_reads = 0;
+  // API-Football response structure: { "get": "fixtures", "results": N, "response": [...] }
+  JsonObject root = doc.as<JsonObject>();
+  JsonVariant errors = root["errors"];
+  if (errors.is<JsonObject>() && errors.size() > 0) {
+    ESP_LOGW(TAG, "API returned errors");
+  }
 
-      if (!length_known) {
-        // Heuristic EOF for unknown-length responses
-        if (read_len < (int)sizeof(buf)) {
-          consecutive_short_reads++;
-          if (consecutive_short_reads >= 3) break;
-        } else {
-          consecutive_short_reads = 0;
-        }
-      }
-    } else {
-      // No data; avoid hammering the stream
-      idle_reads++;
-      if (idle_reads >= 3) break;  // stream likely closed
-      yield();
+  if (!root.containsKey("response")) {
+    ESP_LOGW(TAG, "Response does not contain 'response' key");
+    return false;
+  }
+  
+  JsonArray fixtures = root["response"].as<JsonArray>();
+  if (fixtures.size() == 0) {
+    ESP_LOGW(TAG, "No fixtures found");
+    return request.empty_ok;
+  }
+
+  Match match;
+  for (JsonObject fixture : fixtures) {
+    if (this->parse_fixture_(fixture, match)) {
+      result.fixtures.store(match);
     }
   }
-  ESP_LOGD(TAG, "Read %zu bytes from response", response_str.length());
+  return !result.fixtures.empty() || request.empty_ok;
+}
+
+bool SoccerTracker::parse_fixture_(JsonObject next_match, Match &out) {
+  // Validate fixture structure
+  if (!next_match.containsKey("fixture") || !next_match.containsKey("teams") || !next_match.containsKey("goals")) {
+    ESP_LOGW(TAG, "Fixture missing required fields");
+    return false;
+  }
   
-  response->end();
+  // Parse fixture info
+  JsonObject fixture_info = next_match["fixture"];
+  if (!fixture_info.containsKey("date") || !fixture_info.containsKey("status")) {
+    ESP_LOGW(TAG, "Fixture info missing date or status");
+    return false;
+  }
   
-  if (response_str.empty()) {
-    ESP_LOGW(TAG, "Empty response received");
-    this->last_fetch_ = millis();
-    return;
+  out.fixture_id = fixture_info["id"].as<uint32_t>();
+  std::string match_date_str = fixture_info["date"].as<std::string>();
+  
+  if (!parse_iso8601(match_date_str, out.match_time)) {
+    ESP_LOGW(TAG, "Failed to parse match date: %s", match_date_str.c_str());
+    return false;
   }
   
-  ESP_LOGD(TAG, "Received response (%zu bytes)", response_str.length());
-
-  // Debug: log the first part of the payload to diagnose parse errors
-  // const size_t preview_len = std::min<size_t>(response_str.size(), 200);
-  // std::string preview = response_str.substr(0, preview_len);
-  // Also log first few bytes in hex to detect gzip/binary responses
-  // char hexbuf[200];
-  // size_t hex_len = std::min<size_t>(response_str.size(), 32);
-  // size_t pos_hex = 0;
-  // for (size_t i = 0; i < hex_len && pos_hex + 3 < sizeof(hexbuf); i++) {
-  //   pos_hex += snprintf(hexbuf + pos_hex, sizeof(hexbuf) - pos_hex, "%02X ", (uint8_t)response_str[i]);
-  // }
-  // hexbuf[std::min<size_t>(pos_hex, sizeof(hexbuf) - 1)] = '\0';
-  // ESP_LOGD(TAG, "Response first bytes (hex): %s", hexbuf);
-
-  // Also log last bytes to see if we got the terminating chunk
-  // if (response_str.size() > 32) {
-  //   char hexbuf_end[200];
-  //   size_t hex_end = std::min<size_t>(response_str.size() - 32, 32);
-  //   size_t pos_hex_end = 0;
-  //   for (size_t i = response_str.size() - hex_end; i < response_str.size() && pos_hex_end + 3 < sizeof(hexbuf_end); i++) {
-  //     pos_hex_end += snprintf(hexbuf_end + pos_hex_end, sizeof(hexbuf_end) - pos_hex_end, "%02X ", (uint8_t)response_str[i]);
-  //   }
-  //   hexbuf_end[std::min<size_t>(pos_hex_end, sizeof(hexbuf_end) - 1)] = '\0';
-  //   ESP_LOGD(TAG, "Response last bytes (hex): %s", hexbuf_end);
-  //  }
-
-  // Handle chunked transfer encoding (Content-Length: -1 came through as UINT_MAX)
-  if (!response_str.empty() && isxdigit(response_str[0])) {
-    std::string dechunked;
-    if (dechunk_(response_str, dechunked)) {
-      ESP_LOGD(TAG, "Dechunked body size: %zu", dechunked.size());
-      response_str.swap(dechunked);
-    }
-  }
-  
-  this->parse_match_response_(response_str);
-  this->last_fetch_ = millis();
+  // Parse home team
+  JsonObject teams = next_match["teams"];
+  if (!teams.containsKey("home") || !teams.containsKey("away")) {
+    ESP_LOGW(TAG, "Teams missing home or away");
+    return false;
+  }
   
-  // Mark initial fetch as done only after successful parse
-  if (this->has_match_data_) {
-    this->initial_fetch_done_ = true;
-    ESP_LOGI(TAG, "Initial fetch successful, match data available");
+  JsonObject home_team_obj = teams["home"];
+  if (!home_team_obj.containsKey("name")) {
+    ESP_LOGW(TAG, "Home team missing name");
+    return false;
+  }
+  out.home_team.id = home_team_obj["id"].as<uint32_t>();
+  out.home_team.name = home_team_obj["name"].as<std::string>();
+  out.home_team.score = home_team_obj["goals"].as<int>();
+  
+  // Parse away team
+  JsonObject away_team_obj = teams["away"];
+  if (!away_team_obj.containsKey("name")) {
+    ESP_LOGW(TAG, "Away team missing name");
+    return false;
   }
+  out.away_team.id = away_team_obj["id"].as<uint32_t>();
+  out.away_team.name = away_team_obj["name"].as<std::string>();
+  out.away_team.score = away_team_obj["goals"].as<int>();
+  
+  // API-Football reports goals at the top level; teams.*.goals is the test server's shape
+  JsonObject goals = next_match["goals"];
+  if (goals.containsKey("home") && !home_team_obj.containsKey("goals")) {
+    out.home_team.score = goals["home"].as<int>();
+    out.away_team.score = goals["away"].as<int>();
+  }
+
+  // Get status; API-Football sends {"short": "1H", ...}, the test server a bare code
+  JsonVariant status_field = fixture_info["status"];
+  std::string status = status_field.is<JsonObject>() ? status_field["short"].as<std::string>()
+                                                      : status_field.as<std::string>();
+  time_t now_time = this->rtc_->now().timestamp;
+  
+  out.state = state_for_status(status, out.match_time, now_time);
+  out.finish_time = out.state == FINISHED ? now_time : 0;
+  
+  const char *state_str = "SCHEDULED";
+  switch (out.state) {
+    case SCHEDULED: state_str = "SCHEDULED"; break;
+    case TODAY_PENDING: state_str = "TODAY_PENDING"; break;
+    case IN_PROGRESS: state_str = "IN_PROGRESS"; break;
+    case FINISHED: state_str = "FINISHED"; break;
+  }
+
+  ESP_LOGD(TAG, "Match classified: %s vs %s -> %s (status: %s)",
+           out.home_team.name.c_str(),
+           out.away_team.name.c_str(),
+           state_str,
+           status.c_str());
+  
+  return true;
 }
 
-void SoccerTracker::parse_match_response_(const std::string &response) {
-  bool parsed = json::parse_json(response, [this](JsonObject root) -> bool {
-    // API-Football response structure: { "get": "fixtures", "results": N, "response": [...] }
-    if (!root.containsKey("response")) {
-      ESP_LOGW(TAG, "Response does not contain 'response' key");
-      return false;
+time_t SoccerTracker::next_transition_at_(const Fixture &fixture, time_t now) const {
+  time_t kickoff = fixture.kickoff;
+  time_t at = 0;
+  switch (fixture.state) {
+    case SCHEDULED:
+      at = local_day_start(kickoff);
+      break;
+    case TODAY_PENDING:
+      at = kickoff;
+      break;
+    case IN_PROGRESS:
+      at = kickoff + HALFTIME_AFTER;
+      if (at <= now) {
+        at = kickoff + FULLTIME_AFTER;
+      }
+      break;
+    case FINISHED:
+      at = (time_t) fixture.finish_time + FINISHED_DISPLAY_TIME;
+      break;
+  }
+  return at > now ? at : 0;
+}
+
+void SoccerTracker::arm_transition_timer_() {
+  this->cancel_timeout("transition");
+  this->transition_at_ = 0;
+  if (!this->has_match_data_ || !this->rtc_->now().is_valid()) {
+    return;
+  }
+
+  // One timer serves every fixture: it is armed for the earliest transition
+  time_t now = this->rtc_->now().timestamp;
+  time_t at = 0;
+  for (const auto &fixture : this->fixtures_) {
+    time_t fixture_at = this->next_transition_at_(fixture, now);
+    if (fixture_at != 0 && (at == 0 || fixture_at < at)) {
+      at = fixture_at;
     }
-    
-    JsonArray fixtures = root["response"].as<JsonArray>();
-    if (fixtures.size() == 0) {
-      ESP_LOGW(TAG, "No fixtures found");
-      return false;
+  }
+  if (at == 0) {
+    // Past the last clock-driven transition; polling takes it from here
+    return;
+  }
+
+  this->transition_at_ = at;
+  this->transition_armed_at_ = now;
+  uint32_t wait = std::min(at - now, MAX_TRANSITION_WAIT) * 1000;
+  ESP_LOGD(TAG, "Next match transition in %us", wait / 1000);
+  this->set_timeout("transition", wait, [this]() { this->run_transition_(); });
+}
+
+void SoccerTracker::run_transition_() {
+  time_t now = this->rtc_->now().timestamp;
+  if (now < this->transition_at_) {
+    // A capped wait or a clock correction woke the timer early
+    this->arm_transition_timer_();
+    return;
+  }
+
+  // Every fixture whose transition, as seen when the timer was armed, has come
+  bool fetch = false;
+  bool match_day = false;
+  for (auto &fixture : this->fixtures_) {
+    time_t at = this->next_transition_at_(fixture, this->transition_armed_at_);
+    if (at == 0 || at > now) {
+      continue;
     }
-    
-    // Get first fixture (we only requested 1)
-    JsonObject next_match = fixtures[0];
-    
-    // Validate fixture structure
-    if (!next_match.containsKey("fixture") || !next_match.containsKey("teams") || !next_match.containsKey("goals")) {
-      ESP_LOGW(TAG, "Fixture missing required fields");
-      return false;
+    switch (fixture.state) {
+      case SCHEDULED:
+        // Match day: the display switches to the countdown and polling to the match-day rate
+        fixture.state = TODAY_PENDING;
+        match_day = true;
+        break;
+      case TODAY_PENDING:
+      case IN_PROGRESS:
+        ESP_LOGD(TAG, "Match %u should be at a new stage, fetching", fixture.id);
+        fetch = true;
+        break;
+      case FINISHED:
+        ESP_LOGD(TAG, "Finished match %u expired, fetching the next one", fixture.id);
+        fetch = true;
+        break;
     }
-    
-    // Parse fixture info
-    JsonObject fixture_info = next_match["fixture"];
-    if (!fixture_info.containsKey("date") || !fixture_info.containsKey("status")) {
-      ESP_LOGW(TAG, "Fixture info missing date or status");
-      return false;
+  }
+
+  if (fetch) {
+    this->schedule_poll_(0);
+  } else if (match_day) {
+    this->schedule_poll_(this->next_poll_interval_(true));
+  }
+  this->show_fixture_();
+  this->request_frame_();
+
+  // Fetches re-arm the timer once their result is in
+  this->arm_transition_timer_();
+}
+
+#ifdef USE_SOCCER_PUSH
+void SoccerTracker::connect_push_() {
+  if (this->push_client_.available(true)) {
+    ESP_LOGV(TAG, "Not reconnecting, push channel already connected");
+    return;
+  }
+
+  if (!this->connection_manager_->is_network_ready()) {
+    // Not a failed attempt: the network-ready callback connects
+    ESP_LOGD(TAG, "Network not ready, connecting the push channel once it is");
+    return;
+  }
+
+  // Never two handshakes at once; the fetch thread's will be done shortly
+  auto handshake = this->connection_manager_->try_acquire_handshake();
+  if (!handshake.owns_lock()) {
+    this->set_timeout("push_reconnect", connection_manager::ConnectionManager::HANDSHAKE_RETRY_INTERVAL,
+                      [this]() { this->connect_push_(); });
+    return;
+  }
+
+  watchdog::WatchdogManager wdm(20000);
+  TRACE_SCOPE("push connect");
+
+  this->set_push_live_(false);
+
+  ESP_LOGD(TAG, "Connecting to push server (attempt %d): %s", this->push_backoff_.get_attempts(),
+           this->push_url_.c_str());
+
+  bool connection_success = connection_manager::connect_websocket(this->push_client_, this->push_url_);
+
+  if (!connection_success) {
+    // Polling keeps the display current meanwhile, so keep backing off instead of giving up
+    uint32_t timeout = this->push_backoff_.next_delay();
+    ESP_LOGW(TAG, "Failed to connect to push server, retrying in %.1fs", timeout / 1000.0f);
+
+    this->set_timeout("push_reconnect", timeout, [this]() {
+      this->connect_push_();
+    });
+  } else {
+    this->push_backoff_.reset();
+    this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_CONNECTED);
+  }
+}
+
+void SoccerTracker::set_push_live_(bool live) {
+  bool was_live = this->last_push_heartbeat_ != 0;
+  this->last_push_heartbeat_ = live ? millis() : 0;
+
+  // A live match switches between the live and the backup poll rate
+  if (live != was_live && this->has_match_data_ &&
+      this->most_urgent_state_(this->rtc_->now().timestamp) == IN_PROGRESS) {
+    ESP_LOGD(TAG, "Push channel %s", live ? "up, polling as a backup" : "down, polling at the live rate");
+    this->schedule_poll_(this->next_poll_interval_(true));
+  }
+}
+
+void SoccerTracker::on_push_event_(websockets::WebsocketsEvent event, String data) {
+  if (event == websockets::WebsocketsEvent::ConnectionOpened) {
+    ESP_LOGD(TAG, "Push connection opened");
+
+    auto message = json::build_json([this](JsonObject root) {
+      root["event"] = "fixture:subscribe";
+      auto data = root.createNestedObject("data");
+      JsonArray teams = data.createNestedArray("teams");
+      for (uint32_t team_id : this->team_ids_) {
+        teams.add(team_id);
+      }
+    });
+
+    ESP_LOGV(TAG, "Sending message: %s", message.c_str());
+    this->push_client_.send(message.c_str());
+  } else if (event == websockets::WebsocketsEvent::ConnectionClosed) {
+    ESP_LOGD(TAG, "Push connection closed");
+    this->set_push_live_(false);
+    if (this->push_backoff_.get_attempts() == 0) {
+      this->defer([this]() {
+        this->connect_push_();
+      });
     }
-    
-    std::string match_date_str = fixture_info["date"].as<std::string>();
-    
-    if (!parse_iso8601(match_date_str, this->current_match_.match_time)) {
-      ESP_LOGW(TAG, "Failed to parse match date: %s", match_date_str.c_str());
-      return false;
+  }
+}
+
+void SoccerTracker::on_push_message_(websockets::WebsocketsMessage message) {
+  TRACE_INSTANT("push message", message.rawData().size());
+  TRACE_SCOPE("parse");
+  ALLOC_SCOPE("push_message");
+  ESP_LOGV(TAG, "Received push message: %s", message.rawData().c_str());
+
+  // Stamp arrival before parsing, like the transit tracker does for "sentAt"
+  int64_t received_at = this->rtc_->now().is_valid() ? wall_clock_ms() : 0;
+
+  bool valid = json::parse_json(message.rawData(), [this, &received_at](JsonObject root) -> bool {
+    // Until SNTP syncs, the push server's clock sets ours, like the transit server's does
+    int64_t sent_at = root["sentAt"].isNull() ? 0 : root["sentAt"].as<int64_t>();
+    if (sent_at > 0 && this->connection_manager_->get_server_clock()->offer(sent_at, 0, "the push server")) {
+      received_at = 0;
     }
-    
-    // Parse home team
-    JsonObject teams = next_match["teams"];
-    if (!teams.containsKey("home") || !teams.containsKey("away")) {
-      ESP_LOGW(TAG, "Teams missing home or away");
-      return false;
+
+    std::string event = root["event"].as<std::string>();
+    if (event == "heartbeat") {
+      ESP_LOGV(TAG, "Received push heartbeat");
+      this->set_push_live_(true);
+      return true;
     }
-    
-    JsonObject home_team_obj = teams["home"];
-    if (!home_team_obj.containsKey("name")) {
-      ESP_LOGW(TAG, "Home team missing name");
-      return false;
+
+    if (event != "score" || !this->has_match_data_) {
+      return true;
     }
-    this->current_match_.home_team.name = home_team_obj["name"].as<std::string>();
-    this->current_match_.home_team.score = home_team_obj["goals"].as<int>();
-    
-    // Parse away team
-    JsonObject away_team_obj = teams["away"];
-    if (!away_team_obj.containsKey("name")) {
-      ESP_LOGW(TAG, "Away team missing name");
-      return false;
-    }
-    this->current_match_.away_team.name = away_team_obj["name"].as<std::string>();
-    this->current_match_.away_team.score = away_team_obj["goals"].as<int>();
-    
-    // Get status
-    std::string status = fixture_info["status"].as<std::string>();
-    time_t now_time = this->rtc_->now().timestamp;
-    
-    // Determine match state based on status codes
-    if (status == "1H" || status == "2H" || status == "HT" || status == "ET" || status == "BT" || status == "P" || status == "LIVE") {
-      this->current_match_.state = IN_PROGRESS;
-      this->current_match_.minute = 0;
-      this->current_match_.second = 0;
-      
-    } else if (status == "FT" || status == "AET" || status == "PEN") {
-      this->current_match_.state = FINISHED;
-      this->current_match_.finish_time = now_time;
-      
-    } else if (status == "NS" || status == "TBD") {
-      // Not Started / Scheduled - use local timezone for date comparison
-      ESPTime now_local = this->rtc_->now();
-      ESPTime match_local = ESPTime::from_epoch_local(this->current_match_.match_time);
-      
-      bool is_today = (now_local.year == match_local.year &&
-               now_local.month == match_local.month &&
-               now_local.day_of_month == match_local.day_of_month);
-      
-      // Use local timestamps for comparison to avoid UTC skew
-      if (is_today && match_local.timestamp > now_local.timestamp) {
-        this->current_match_.state = TODAY_PENDING;
-      } else {
-        this->current_match_.state = SCHEDULED;
+
+    // Events name the fixture by its id, so one for a match not in the table is ignored
+    JsonObject data = root["data"];
+    const Fixture *fixture = this->fixtures_.find(data["fixture"].as<uint32_t>());
+    if (fixture == nullptr) {
+      ESP_LOGD(TAG, "Ignoring score event for another fixture");
+      return true;
+    }
+
+    Match match;
+    this->fixtures_.load(*fixture, match);
+    MatchState previous_state = match.state;
+    if (!data["home"].isNull()) {
+      match.home_team.score = data["home"].as<int>();
+    }
+    if (!data["away"].isNull()) {
+      match.away_team.score = data["away"].as<int>();
+    }
+    if (!data["status"].isNull()) {
+      time_t now = this->rtc_->now().timestamp;
+      match.state = state_for_status(data["status"].as<std::string>(), match.match_time, now);
+      if (match.state == FINISHED && previous_state != FINISHED) {
+        match.finish_time = now;
       }
-    } else {
-      this->current_match_.state = SCHEDULED;
     }
-    
-    this->has_match_data_ = true;
 
-    const char *state_str = "SCHEDULED";
-    switch (this->current_match_.state) {
-      case SCHEDULED: state_str = "SCHEDULED"; break;
-      case TODAY_PENDING: state_str = "TODAY_PENDING"; break;
-      case IN_PROGRESS: state_str = "IN_PROGRESS"; break;
-      case FINISHED: state_str = "FINISHED"; break;
+    if (sent_at > 0 && received_at > 0) {
+      ESP_LOGD(TAG, "Score event %d-%d is %ldms old on arrival", match.home_team.score, match.away_team.score,
+               static_cast<long>(received_at - sent_at));
+      this->push_sent_at_ = sent_at;
+    } else {
+      ESP_LOGD(TAG, "Score event %d-%d", match.home_team.score, match.away_team.score);
     }
 
-    ESP_LOGD(TAG, "Match classified: %s vs %s -> %s (status: %s)",
-             this->current_match_.home_team.name.c_str(),
-             this->current_match_.away_team.name.c_str(),
-             state_str,
-             status.c_str());
-    
+    this->fixtures_.store(match);
+    this->show_fixture_();
+    if (match.state != previous_state) {
+      this->arm_transition_timer_();
+      this->schedule_poll_(this->next_poll_interval_(true));
+    }
+    this->request_frame_();
     return true;
   });
-  
-  if (!parsed) {
-    ESP_LOGW(TAG, "Failed to parse match response");
+
+  if (!valid) {
+    ESP_LOGW(TAG, "Failed to parse push message");
   }
 }
+#endif
 
-void SoccerTracker::update_match_state_() {
-  if (!this->has_match_data_) return;
-  
-  time_t now = this->rtc_->now().timestamp;
-  
-  // Check if FINISHED state should expire (after 1 hour)
-  if (this->current_match_.state == FINISHED) {
-    if (now - this->current_match_.finish_time > 3600) {
-      // Fetch new match data
-      this->fetch_match_data_();
-      return;
-    }
+// Short forms the API uses for some city names, as normalized words
+static const char *const TEAM_NAME_ABBREVIATIONS[][2] = {
+    {"los-angeles", "la"},
+    {"new-york", "ny"},
+    {"saint", "st"},
+};
+
+// Replace the words long_form in a normalized name with short_form, or
+// return an empty string if the name doesn't contain them
+static std::string abbreviate(const std::string &key, const char *long_form, const char *short_form) {
+  std::string padded = "-" + key + "-";
+  std::string needle = std::string("-") + long_form + "-";
+  size_t pos = padded.find(needle);
+  if (pos == std::string::npos)
+    return "";
+  padded.replace(pos, needle.size(), std::string("-") + short_form + "-");
+  return padded.substr(1, padded.size() - 2);
+}
+
+void SoccerTracker::register_logo_(const std::string &team_name, TeamLogo logo) {
+  std::string key = normalize_team_name_(team_name);
+  if (key.empty())
+    return;
+
+  // The first registration of a name wins, except over a generated alias
+  auto it = this->logo_index_.find(key);
+  if (it == this->logo_index_.end()) {
+    this->logo_index_.emplace(key, logo);
+  } else if (it->second.alias) {
+    it->second = logo;
   }
-  
-  // Update IN_PROGRESS timing
-  if (this->current_match_.state == IN_PROGRESS) {
-    int elapsed = now - this->current_match_.match_time;
-    this->current_match_.minute = elapsed / 60;
-    this->current_match_.second = elapsed % 60;
-    
-    // Cap at 90 minutes (could be extended for extra time)
-    if (this->current_match_.minute > 90) {
-      this->current_match_.minute = 90;
+
+  logo.alias = true;
+  for (const auto &abbreviation : TEAM_NAME_ABBREVIATIONS) {
+    std::string alias = abbreviate(key, abbreviation[0], abbreviation[1]);
+    // "Los Angeles FC" would reduce to a bare "la" and match any LA team
+    if (!alias.empty() && alias != abbreviation[1]) {
+      this->logo_index_.emplace(alias, logo);
     }
   }
-  
-  // Check if SCHEDULED becomes TODAY_PENDING (use local timezone)
-  if (this->current_match_.state == SCHEDULED) {
-    ESPTime now_local = this->rtc_->now();
-    ESPTime match_local = ESPTime::from_epoch_local(this->current_match_.match_time);
-    
-    bool is_today = (now_local.year == match_local.year &&
-                     now_local.month == match_local.month &&
-                     now_local.day_of_month == match_local.day_of_month);
-    
-    if (is_today && match_local.timestamp > now_local.timestamp) {
-      this->current_match_.state = TODAY_PENDING;
+
+  this->logo_cache_.clear();
+}
+
+// Club designators that one source includes and another leaves out
+static bool is_club_designator(const std::string &word) {
+  return word == "fc" || word == "sc" || word == "cf" || word == "afc";
+}
+
+// Reduce a team name to its lookup key: lowercase words joined by hyphens,
+// with accents folded, "." and "'" dropped and club designators removed, so
+// "CF Montréal" -> "montreal" and "D.C. United" -> "dc-united".
+std::string SoccerTracker::normalize_team_name_(const std::string &team_name) {
+  // ASCII folding of U+00C0..U+00FF, which UTF-8 encodes as 0xC3 0x80..0xBF
+  static const char LATIN1_FOLD[] = "aaaaaaaceeeeiiiidnooooo ouuuuyts"
+                                    "aaaaaaaceeeeiiiidnooooo ouuuuyty";
+  std::string key;
+  std::string word;
+  auto end_word = [&]() {
+    if (!word.empty() && !is_club_designator(word)) {
+      if (!key.empty())
+        key.push_back('-');
+      key += word;
     }
-  }
-  
-  // Check if TODAY_PENDING should become IN_PROGRESS
-  if (this->current_match_.state == TODAY_PENDING) {
-    if (now >= this->current_match_.match_time) {
-      // Fetch fresh data as match should be starting
-      this->fetch_match_data_();
+    word.clear();
+  };
+
+  for (size_t i = 0; i < team_name.size(); i++) {
+    unsigned char c = team_name[i];
+    if (c == 0xC3 && i + 1 < team_name.size()) {
+      unsigned char next = team_name[++i];
+      c = (next >= 0x80 && next <= 0xBF) ? LATIN1_FOLD[next - 0x80] : ' ';
+    } else if (c >= 0x80) {
+      continue;  // Other multi-byte sequences carry no ASCII equivalent
     }
-  }
-}
 
-std::string SoccerTracker::format_team_name_(const std::string &logo_filename) {
-  // Extract team name from filename like "atlanta-united-footballlogos-org_14x14.png"
-  size_t pos = logo_filename.find("-footballlogos-org");
-  if (pos == std::string::npos) return "";
-  
-  std::string team_name = logo_filename.substr(0, pos);
-  
-  // Replace hyphens with spaces
-  for (char &c : team_name) {
-    if (c == '-') c = ' ';
-  }
-  
-  // Capitalize each word
-  bool capitalize_next = true;
-  for (char &c : team_name) {
-    if (std::isspace(c)) {
-      capitalize_next = true;
-    } else if (capitalize_next) {
-      c = std::toupper(c);
-      capitalize_next = false;
+    if (std::isalnum(c)) {
+      word.push_back(std::tolower(c));
+    } else if (c != '.' && c != '\'') {
+      end_word();
     }
   }
-  
-  // Special case: "fc" should be "FC"
-  size_t fc_pos = team_name.find(" fc");
-  if (fc_pos != std::string::npos) {
-    team_name[fc_pos + 1] = 'F';
-    team_name[fc_pos + 2] = 'C';
-  }
-  fc_pos = team_name.find(" Fc");
-  if (fc_pos != std::string::npos) {
-    team_name[fc_pos + 2] = 'C';
-  }
-  
-  return team_name;
+  end_word();
+
+  return key;
 }
 
-std::string SoccerTracker::normalize_team_name_(const std::string &team_name) {
-  std::string normalized = team_name;
-  
-  // Convert to lowercase and replace spaces with hyphens
-  for (char &c : normalized) {
-    if (std::isspace(c)) {
-      c = '-';
-    } else {
-      c = std::tolower(c);
-    }
+// True if needle appears in haystack as a run of whole hyphen-separated words
+static bool contains_words(const std::string &haystack, const std::string &needle) {
+  for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) {
+    size_t end = pos + needle.size();
+    if ((pos == 0 || haystack[pos - 1] == '-') && (end == haystack.size() || haystack[end] == '-'))
+      return true;
   }
-  
-  // Remove common suffixes that might not be in logo names
-  const std::string suffixes[] = {"-sc", "-united", "-fc", "-city"};
-  // This is a simplistic match - in practice you'd want fuzzy matching
-  
-  return normalized;
+  return false;
 }
 
 // Insert a single space between non-space characters to improve legibility
@@ -625,75 +1376,88 @@ std::string SoccerTracker::add_spacing_(const std::string &text) {
 }
 
 // Draw text with custom per-character spacing and alignment (supports TOP_LEFT and TOP_RIGHT)
-void SoccerTracker::draw_text_with_spacing_(int x, int y, font::Font *font, Color color,
+void SoccerTracker::draw_text_with_spacing_(int x, int y, const matrix_render::TextMetrics &metrics, Color color,
                                            const std::string &text, int spacing_px,
                                            display::TextAlign align) {
-  if (font == nullptr || this->display_ == nullptr) return;
+  if (!metrics.is_built() || this->display_ == nullptr) return;
 
-  // Compute total width
-  int total_width = 0;
-  for (size_t i = 0; i < text.size(); i++) {
-    char c_str[2] = {text[i], '\0'};
-    int w = 0, xo = 0, bl = 0, h = 0;
-    font->measure(c_str, &w, &xo, &bl, &h);
-    total_width += w;
-    if (i + 1 < text.size()) total_width += spacing_px;
-  }
-
-  int start_x = x;
+  int cursor_x = x;
   if (align == display::TextAlign::TOP_RIGHT) {
-    start_x = x - total_width;
+    cursor_x = x - metrics.spaced_width(text, spacing_px);
   }
 
-  int cursor_x = start_x;
-  for (size_t i = 0; i < text.size(); i++) {
-    char c_str[2] = {text[i], '\0'};
-    this->display_->print(cursor_x, y, font, color, display::TextAlign::TOP_LEFT, c_str);
-    int w = 0, xo = 0, bl = 0, h = 0;
-    font->measure(c_str, &w, &xo, &bl, &h);
+  const char *str = text.c_str();
+  size_t pos = 0;
+  while (str[pos] != '\0') {
+    size_t start = pos;
+    int w = metrics.next_glyph(str, pos).width();
+    char glyph[5] = {};
+    memcpy(glyph, str + start, std::min<size_t>(pos - start, 4));
+    this->display_->print(cursor_x, y, metrics.get_font(), color, display::TextAlign::TOP_LEFT, glyph);
     cursor_x += w + spacing_px;
   }
 }
 
-image::Image* SoccerTracker::get_team_logo_(const std::string &team_name) {
-  // Check cache first
+const TeamLogo *SoccerTracker::get_team_logo_(const std::string &team_name) {
   auto cache_it = this->logo_cache_.find(team_name);
   if (cache_it != this->logo_cache_.end()) {
     return cache_it->second;
   }
-  
-  // Cache miss - perform lookup
-  std::string normalized = this->normalize_team_name_(team_name);
-  ESP_LOGD(TAG, "Cache miss - looking for logo for team: '%s' (normalized: '%s')", team_name.c_str(), normalized.c_str());
-  
-  // Search through registered logos
-  for (auto &pair : this->team_logos_) {
-    std::string logo_team = this->format_team_name_(pair.first);
-    std::string logo_normalized = this->normalize_team_name_(logo_team);
-    
-    ESP_LOGD(TAG, "  Checking logo: '%s' -> '%s' (normalized: '%s')", 
-             pair.first.c_str(), logo_team.c_str(), logo_normalized.c_str());
-    
-    // Check if names match
-    if (normalized.find(logo_normalized) != std::string::npos ||
-        logo_normalized.find(normalized) != std::string::npos) {
-      ESP_LOGD(TAG, "  MATCH! Using logo: %s for team: %s", pair.first.c_str(), team_name.c_str());
-      // Cache the result
-      this->logo_cache_[team_name] = pair.second;
-      return pair.second;
+
+  // First time this name is drawn: resolve it once and remember the outcome,
+  // misses included, so the draw modes never search again
+  std::string key = normalize_team_name_(team_name);
+  const TeamLogo *logo = this->find_team_logo_(key);
+  if (logo == nullptr) {
+    ESP_LOGW(TAG, "No logo found for team: %s (key '%s')", team_name.c_str(), key.c_str());
+  } else {
+    ESP_LOGD(TAG, "Using logo for team: %s (key '%s')", team_name.c_str(), key.c_str());
+  }
+  this->logo_cache_.emplace(team_name, logo);
+  return logo;
+}
+
+const TeamLogo *SoccerTracker::find_team_logo_(const std::string &key) const {
+  if (key.empty())
+    return nullptr;
+
+  auto it = this->logo_index_.find(key);
+  if (it != this->logo_index_.end())
+    return &it->second;
+
+  // Fuzzy fallback for names with extra or missing words: the longest
+  // indexed name whose words all appear in the key, or the other way round
+  const TeamLogo *best = nullptr;
+  size_t best_length = 0;
+  for (auto &entry : this->logo_index_) {
+    const std::string &name = entry.first;
+    if (name.size() > best_length && (contains_words(key, name) || contains_words(name, key))) {
+      best = &entry.second;
+      best_length = name.size();
     }
   }
-  
-  ESP_LOGW(TAG, "No logo found for team: %s", team_name.c_str());
-  return nullptr;
+  return best;
+}
+
+void SoccerTracker::draw_match(display::Display &it) {
+  // Drawing only happens on the main loop, so the target can be swapped for the call
+  display::Display *display = this->display_;
+  this->display_ = &it;
+  this->draw_match();
+  this->display_ = display;
 }
 
 void SoccerTracker::draw_match() {
+  TRACE_SCOPE("render");
+  ALLOC_SCOPE("draw_match");
   if (this->display_ == nullptr) {
     ESP_LOGW(TAG, "No display attached");
     return;
   }
 
+  // Everything below is static between colon pulses and fetches, which request their own frames
+  this->next_frame_at_ = millis() + IDLE_FRAME_INTERVAL;
+
   int x = this->display_->get_width() / 2;
   int y = this->display_->get_height() / 2 - 8;
   
@@ -724,9 +1488,11 @@ void SoccerTracker::draw_match() {
     snprintf(status, sizeof(status), "%lu ms", time_since_fetch);
     this->display_->printf(x, y + 10, this->font_, Color(0, 230, 0), 
                           display::TextAlign::CENTER, status);
+    this->next_frame_at_ = millis() + UPDATE_INTERVAL;
     return;
   }
-  
+
+  this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_FIRST_CONTENT);
   switch (this->current_match_.state) {
 
     case SCHEDULED:
@@ -741,40 +1507,52 @@ void SoccerTracker::draw_match() {
     case FINISHED:
       break;
   }
+
+#ifdef USE_SOCCER_PUSH
+  if (this->push_sent_at_ != 0) {
+    ESP_LOGD(TAG, "Score event drawn %ldms after it was sent", static_cast<long>(wall_clock_ms() - this->push_sent_at_));
+    this->push_sent_at_ = 0;
+  }
+#endif
+
+  // The countdown and match clock pulse their colon once a second
+  if (this->current_match_.state == TODAY_PENDING || this->current_match_.state == IN_PROGRESS) {
+    this->next_frame_at_ = (millis() / UPDATE_INTERVAL + 1) * UPDATE_INTERVAL;
+  }
 }
 
-std::string SoccerTracker::clip_team_name_(const std::string &team_name, int max_width_px, font::Font *font) {
-  if (font == nullptr) return team_name;
-  
+void SoccerTracker::clip_team_name_(const std::string &team_name, int max_width_px,
+                                    const matrix_render::TextMetrics &metrics, char *out, size_t out_size) {
+  // Room for the ellipsis and the terminator
+  size_t length = std::min(team_name.size(), out_size - 4);
   int current_width = 0;
-  std::string result;
-  
-  for (size_t i = 0; i < team_name.size(); i++) {
-    char c_str[2] = {team_name[i], '\0'};
-    int w = 0, xo = 0, bl = 0, h = 0;
-    font->measure(c_str, &w, &xo, &bl, &h);
-    
-    if (current_width + w > max_width_px) {
-      // Add ellipsis if we can fit it
-      if (current_width + 6 <= max_width_px) {
-        result += "...";
-      }
-      break;
-    }
-    result += team_name[i];
-    current_width += w;
+  if (metrics.is_built()) {
+    length = std::min(length, metrics.clip_to_width(team_name.c_str(), max_width_px, 0, &current_width));
+  }
+  memcpy(out, team_name.data(), length);
+  out[length] = '\0';
+
+  // Add ellipsis if the name was cut and we can fit it
+  if (metrics.is_built() && length < team_name.size() &&
+      current_width + metrics.spaced_width("...", 0) <= max_width_px) {
+    strcpy(out + length, "...");
   }
-  
-  return result;
 }
 
-void SoccerTracker::draw_team_row_(int y, const Team &team, bool is_favorite, image::Image *logo) {
+void SoccerTracker::draw_team_row_(int y, const Team &team, bool is_favorite, const TeamLogo *logo) {
   int x = 0;
   int text_y = y;
   
   // Draw logo if available
   if (logo != nullptr) {
-    this->display_->image(x, y, logo);
+#ifdef MATRIX_RENDER_HAS_IMAGE
+    if (logo->image != nullptr) {
+      matrix_render::blit_image(this->display_, x, y, logo->image);
+    }
+#endif
+    if (logo->atlas != nullptr) {
+      matrix_render::blit_image(this->display_, x, y, *logo->atlas);
+    }
     x += logo->get_width() + 2; // 2 pixel gap
     // Center text vertically with logo (logo is 14px, font ~8px, offset by 3px)
     text_y = y + 3;
@@ -782,10 +1560,12 @@ void SoccerTracker::draw_team_row_(int y, const Team &team, bool is_favorite, im
   
   // Clip team name to avoid overlapping date/time (right-side area starts ~60px from right edge)
   int max_name_width = this->display_->get_width() - x - 35;
-  std::string clipped_name = this->clip_team_name_(team.name, max_name_width, this->font_);
+  // On the stack, so a frame doesn't allocate for long names
+  char clipped_name[64];
+  this->clip_team_name_(team.name, max_name_width, this->font_metrics_, clipped_name, sizeof(clipped_name));
   
   // Draw team name
-  this->display_->print(x, text_y, this->font_, Color(255, 255, 255), clipped_name.c_str());
+  this->display_->print(x, text_y, this->font_, Color(255, 255, 255), clipped_name);
 }
 
 void SoccerTracker::draw_date_time_(int x, int y, time_t match_time) {
@@ -808,7 +1588,7 @@ void SoccerTracker::draw_date_time_(int x, int y, time_t match_time) {
 void SoccerTracker::draw_countdown_(int x, int y, int hours, int minutes) {
   char countdown_str[16];
   snprintf(countdown_str, sizeof(countdown_str), "%02d%c%02d", 
-           hours, (this->colon_visible_ ? ':' : ' '), minutes);
+           hours, (this->colon_visible_() ? ':' : ' '), minutes);
   
   this->display_->printf(x, y, this->font_, Color(255, 255, 0),
                         display::TextAlign::TOP_RIGHT, "%s", countdown_str);
@@ -829,43 +1609,30 @@ void SoccerTracker::draw_time_in_match_(int x, int y, int minutes, int seconds,
   snprintf(seconds_str, sizeof(seconds_str), "%02d", seconds);
   
   // Draw with fixed spacing to prevent jumping
-  // Calculate total width for right alignment
-  std::string full_time = std::string(minutes_str) + ":" + std::string(seconds_str);
-  int total_width = 0;
-  for (size_t i = 0; i < full_time.size(); i++) {
-    char c_str[2] = {full_time[i], '\0'};
-    int w = 0, xo = 0, bl = 0, h = 0;
-    this->small_font_->measure(c_str, &w, &xo, &bl, &h);
-    total_width += w;
-    if (i + 1 < full_time.size()) total_width += 1;  // 1px spacing
-  }
-  
+  // Calculate total width for right alignment (1px spacing between all glyphs)
+  const auto &metrics = this->small_font_metrics_;
+  int minutes_width = metrics.spaced_width(minutes_str, 1);
+  int colon_width = metrics.spaced_width(":", 1);
+  int total_width = minutes_width + 1 + colon_width + 1 + metrics.spaced_width(seconds_str, 1);
+
   int start_x = x - total_width;
-  
+
   // Draw minutes with spacing
-  this->draw_text_with_spacing_(start_x, y, this->small_font_, Color(255, 255, 255),
+  this->draw_text_with_spacing_(start_x, y, metrics, Color(255, 255, 255),
                                 minutes_str, 1, display::TextAlign::TOP_LEFT);
-  
-  // Calculate position after minutes
-  int cursor_x = start_x;
-  for (char c : std::string(minutes_str)) {
-    char c_str[2] = {c, '\0'};
-    int w = 0, xo = 0, bl = 0, h = 0;
-    this->small_font_->measure(c_str, &w, &xo, &bl, &h);
-    cursor_x += w + 1;
-  }
-  
+
+  // Position after minutes
+  int cursor_x = start_x + minutes_width + 1;
+
   // Draw colon (always visible for spacing, but transparent when pulsing off)
-  Color colon_color = (pulse && this->colon_visible_) ? Color(255, 255, 255) : Color(0, 0, 0);
+  Color colon_color = (pulse && this->colon_visible_()) ? Color(255, 255, 255) : Color(0, 0, 0);
   this->display_->print(cursor_x, y, this->small_font_, colon_color, display::TextAlign::TOP_LEFT, ":");
-  
-  // Calculate position after colon
-  int w = 0, xo = 0, bl = 0, h = 0;
-  this->small_font_->measure(":", &w, &xo, &bl, &h);
-  cursor_x += w + 1;
-  
+
+  // Position after colon
+  cursor_x += colon_width + 1;
+
   // Draw seconds with spacing
-  this->draw_text_with_spacing_(cursor_x, y, this->small_font_, Color(255, 255, 255),
+  this->draw_text_with_spacing_(cursor_x, y, metrics, Color(255, 255, 255),
                                 seconds_str, 1, display::TextAlign::TOP_LEFT);
 }
 
@@ -902,8 +1669,8 @@ void SoccerTracker::draw_scheduled_mode_() {
 
   Color green(0, 255, 0);
   // Render with minimal extra spacing (0px) since the font has built-in ~1px advance
-  this->draw_text_with_spacing_(right_x, date_y, this->font_, green, date_str, 0, display::TextAlign::TOP_RIGHT);
-  this->draw_text_with_spacing_(right_x, time_y, this->font_, green, time_str, 0, display::TextAlign::TOP_RIGHT);
+  this->draw_text_with_spacing_(right_x, date_y, this->font_metrics_, green, date_str, 0, display::TextAlign::TOP_RIGHT);
+  this->draw_text_with_spacing_(right_x, time_y, this->font_metrics_, green, time_str, 0, display::TextAlign::TOP_RIGHT);
 }
 
 void SoccerTracker::draw_today_pending_mode_() {
@@ -920,7 +1687,7 @@ void SoccerTracker::draw_today_pending_mode_() {
   
   // Calculate time until match
   time_t now = this->rtc_->now().timestamp;
-  int seconds_until = this->current_match_.match_time - now;
+  int seconds_until = std::max<time_t>(0, this->current_match_.match_time - now);
   int hours = seconds_until / 3600;
   int minutes = (seconds_until % 3600) / 60;
   
@@ -956,9 +1723,9 @@ void SoccerTracker::draw_in_progress_mode_() {
   // Draw match time (MM:SS) centered vertically between the two scores
   // Y position: centered between score_y and score_y+16, adjusted for font height
   int time_y = score_y + 6;  // Center between top and bottom scores
-  this->draw_time_in_match_(score_x - 8, time_y, 
-                           this->current_match_.minute,
-                           this->current_match_.second, true);
+  // Clock time since kickoff, capped at 90 minutes (could be extended for extra time)
+  int elapsed = std::max<time_t>(0, this->rtc_->now().timestamp - this->current_match_.match_time);
+  this->draw_time_in_match_(score_x - 8, time_y, std::min(elapsed / 60, 90), elapsed % 60, true);
 }
 
 void SoccerTracker::draw_finished_mode_() {
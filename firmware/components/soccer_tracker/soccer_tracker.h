@@ -1,46 +1,100 @@
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <map>
 #include <string>
+#include <thread>
+#include <vector>
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/components/display/display.h"
 #include "esphome/components/font/font.h"
 #include "esphome/components/time/real_time_clock.h"
 #include "esphome/components/http_request/http_request.h"
-#include "esphome/components/image/image.h"
+#include "esphome/components/connection_manager/connection_manager.h"
 #include "esphome/components/web_server_base/web_server_base.h"
+#include "esphome/components/json/json_util.h"
+#include "esphome/components/memory_placement/placement.h"
+#include "esphome/components/matrix_render/rle_image.h"
+#include "esphome/components/matrix_render/span_buffer.h"
+#include "esphome/components/matrix_render/text_metrics.h"
+#include "fixture_table.h"
+#include "season_cache.h"
+
+#ifdef USE_SOCCER_PUSH
+#include <ArduinoWebsockets.h>
+#include "esphome/components/connection_manager/websocket_transport.h"
+#endif
 
 namespace esphome {
 namespace soccer_tracker {
 
-enum MatchState {
-  SCHEDULED,      // Match is scheduled but not today
-  TODAY_PENDING,  // Match is today but hasn't started
-  IN_PROGRESS,    // Match is currently being played
-  FINISHED        // Match just finished (show for 1 hour)
+// A team logo: an image from the team_logos option, or an entry of the
+// built-in logo atlas (matrix_render/logo_atlas.h)
+struct TeamLogo {
+#ifdef MATRIX_RENDER_HAS_IMAGE
+  image::Image *image = nullptr;
+#endif
+  const matrix_render::RleImage *atlas = nullptr;
+  bool alias = false;  // Registered under a generated short form of the name
+
+  int get_width() const {
+#ifdef MATRIX_RENDER_HAS_IMAGE
+    if (this->image != nullptr)
+      return this->image->get_width();
+#endif
+    return this->atlas->width;
+  }
 };
 
-struct Team {
-  std::string name;
-  std::string logo_id;
-  int score;
+using LogoIndex = memory_placement::PlacementUnorderedMap<std::string, TeamLogo, memory_placement::CATEGORY_LOGO_INDEX>;
+using LogoCache =
+    memory_placement::PlacementUnorderedMap<std::string, const TeamLogo *, memory_placement::CATEGORY_LOGO_INDEX>;
+
+// Everything a background fetch hands back to loop()
+struct FetchResult {
+  bool parsed = false;
+  bool not_modified = false;  // 304: the last match is still current
+  bool discovery = false;     // The teams' next fixtures were looked up, not just known ones refreshed
+  bool season = false;        // Holds the teams' remaining season, for the season cache
+  bool clock_probe = false;   // Only asked for the server's time
+  FixtureTable fixtures;
+  std::string etag;
+  std::string last_modified;
+  int quota_remaining = -1;         // Daily requests left, -1 if not reported
+  int quota_limit = -1;
+  int minute_quota_remaining = -1;  // Requests left this minute, -1 if not reported
 };
 
-struct Match {
-  Team home_team;
-  Team away_team;
-  time_t match_time;
-  MatchState state;
-  int minute;      // Current minute of play
-  int second;      // Current second within minute
-  time_t finish_time; // Time when match finished (for FINISHED state)
+// What a background fetch asks the API for
+struct FetchRequest {
+  std::vector<std::string> urls;
+  std::list<http_request::Header> headers;
+  // Teams whose next fixture must be in the result; any the URLs miss are
+  // looked up one team at a time
+  std::vector<uint32_t> teams;
+  std::string team_url_prefix;
+  // Season downloads: fixtures kicking off before not_before are dropped
+  bool season = false;
+  time_t not_before = 0;
+  // Before the clock is set: a request for nothing but the response's Date
+  // header, which ConnectionManager::get() hands to the server clock
+  bool clock_probe = false;
+  // A response without fixtures still counts as a successful fetch: batches
+  // and seasons can legitimately come back empty, a single team's next
+  // fixture can't. Decided by loop(), so the fetch thread reads no settings.
+  bool empty_ok = false;
 };
 
 class SoccerTracker : public Component {
   public:
     void setup() override;
       // Runtime test controls
-      void set_test_mode(bool enabled) { this->test_mode_ = enabled; }
+      void set_test_mode(bool enabled) {
+        this->test_mode_ = enabled;
+        this->poll_requested_ = true;
+      }
       void set_test_server_url(const std::string &url) { this->test_server_url_ = url; }
       bool get_test_mode() const { return this->test_mode_; }
       const std::string &get_test_server_url() const { return this->test_server_url_; }
@@ -50,41 +104,127 @@ class SoccerTracker : public Component {
     float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
     
     void draw_match();
+    // Draws into it instead, e.g. a display_compositor zone, laid out for its size
+    void draw_match(display::Display &it);
+
+    // millis() instant at which the output of draw_match() next changes
+    uint32_t get_next_frame_at() const { return next_frame_at_; }
     
     void set_display(display::Display *display) { display_ = display; }
     void set_font(font::Font *font) { font_ = font; }
     void set_small_font(font::Font *font) { small_font_ = font; }
     void set_rtc(time::RealTimeClock *rtc) { rtc_ = rtc; }
-    void set_http_request(http_request::HttpRequestComponent *http_request) { http_request_ = http_request; }
+    void set_connection_manager(connection_manager::ConnectionManager *connection_manager) {
+      connection_manager_ = connection_manager;
+    }
     
     void set_api_key(const std::string &api_key) { api_key_ = api_key; }
     void set_favorite_team(const std::string &team) { favorite_team_ = team; }
     void set_team_id(int team_id) { team_id_ = team_id; }
+    // Further teams to follow besides team_id; see fetch_match_data_() for how they are batched
+    void add_team(int team_id) { extra_team_ids_.push_back(team_id); }
+    void set_league_id(int league_id) { league_id_ = league_id; }
+    void set_season(int season) { season_ = season; }
+    void set_rotate_interval(uint32_t interval) { rotate_interval_ = interval; }
+    void set_season_cache(bool enabled) { season_cache_enabled_ = enabled; }
+    void set_scheduled_interval(uint32_t interval) { scheduled_interval_ = interval; }
+    void set_pending_interval(uint32_t interval) { pending_interval_ = interval; }
+    void set_live_interval(uint32_t interval) { live_interval_ = interval; }
+#ifdef USE_SOCCER_PUSH
+    void set_push_url(const std::string &push_url) { push_url_ = push_url; }
+#endif
     
+#ifdef MATRIX_RENDER_HAS_IMAGE
+    // Adds a team's logo to the logo index, overriding the built-in atlas
     void register_team_logo(const std::string &team_name, image::Image *logo) {
-      team_logos_[team_name] = logo;
+      TeamLogo entry;
+      entry.image = logo;
+      this->register_logo_(team_name, entry);
     }
+#endif
     
   protected:
-    void fetch_match_data_();
-    void parse_match_response_(const std::string &response);
-    void update_match_state_();
+    void poll_();
+    void schedule_poll_(uint32_t delay);
+    uint32_t next_poll_interval_(bool last_fetch_ok);
+
+    // Starts a background fetch, returning false if none was started. The
+    // result is adopted by finish_fetch_() from loop().
+    bool fetch_match_data_();
+    // scheme://host[:port] of the API, or of the test server in test mode
+    std::string api_server_() const;
+    void fetch_task_(FetchRequest request);
+    void finish_fetch_();
+    // Adds the fixtures of one response to result.fixtures; false if the request failed
+    bool download_fixtures_(const std::string &url, const FetchRequest &request, FetchResult &result);
+    bool parse_fixture_(JsonObject fixture, Match &out);
+    bool multi_team_() const { return this->team_ids_.size() > 1; }
+    int current_season_() const { return this->season_ != 0 ? this->season_ : this->rtc_->now().year; }
+    bool has_next_fixture_(uint32_t team_id) const;
+
+    // The season cache answers "next match" from flash; the API is only asked
+    // about the day's matches, and for the whole season about once a week
+    bool season_cache_active_() const { return this->season_cache_enabled_ && !this->test_mode_; }
+    uint32_t season_cache_key_() const {
+      return SeasonCache::make_key(this->team_ids_, this->league_id_, this->current_season_());
+    }
+    bool season_refresh_due_(time_t now) const;
+    // Fills in each team's next fixture from the cache and drops expired ones
+    void update_from_season_cache_();
+    bool can_skip_fetch_(time_t now) const;
+
+    // Fixtures in the table drive polling by the most urgent of them
+    MatchState most_urgent_state_(time_t now) const;
+    time_t next_kickoff_(time_t now) const;
+    bool is_expired_(const Fixture &fixture, time_t now) const {
+      return fixture.state == FINISHED && now - (time_t) fixture.finish_time > FINISHED_DISPLAY_TIME;
+    }
+    // Copies the fixture on display into current_match_, picking another if it is gone
+    void show_fixture_();
+    void rotate_fixture_();
+    // Loads the fixture into current_match_ and resolves both team logos, so
+    // drawing it never fills the logo cache
+    void load_current_(const Fixture &fixture);
+    // The clock-driven transitions of the current match (local midnight before
+    // kickoff, kickoff, the expected halftime and full-time windows, the end of
+    // the FINISHED display) run from a timer armed for the next one
+    time_t next_transition_at_(const Fixture &fixture, time_t now) const;
+    void arm_transition_timer_();
+    void run_transition_();
+    void request_frame_() { this->next_frame_at_ = millis(); }
+#ifdef USE_SOCCER_PUSH
+    // Score and status events pushed by the server. While the channel is up,
+    // live matches are polled at the match-day rate instead of the live one.
+    void connect_push_();
+    void on_push_message_(websockets::WebsocketsMessage message);
+    void on_push_event_(websockets::WebsocketsEvent event, String data);
+    // Tracks whether heartbeats are arriving, and re-times the poll of a live match when that changes
+    void set_push_live_(bool live);
+    bool push_live_() { return this->last_push_heartbeat_ != 0 && this->push_client_.available(); }
+#endif
+    // The colon pulse follows millis(), so any frame drawn in the same second agrees
+    bool colon_visible_() const { return (millis() / UPDATE_INTERVAL) % 2 == 0; }
     
-    std::string format_team_name_(const std::string &logo_filename);
-    std::string normalize_team_name_(const std::string &team_name);
+    static std::string normalize_team_name_(const std::string &team_name);
     std::string add_spacing_(const std::string &text);
-    std::string clip_team_name_(const std::string &team_name, int max_width_px, font::Font *font);
-    void draw_text_with_spacing_(int x, int y, font::Font *font, Color color,
+    // Writes team_name into out, cut to max_width_px with an ellipsis where it fits
+    void clip_team_name_(const std::string &team_name, int max_width_px, const matrix_render::TextMetrics &metrics,
+                         char *out, size_t out_size);
+    void draw_text_with_spacing_(int x, int y, const matrix_render::TextMetrics &metrics, Color color,
                    const std::string &text, int spacing_px,
                    display::TextAlign align = display::TextAlign::TOP_LEFT);
-    image::Image* get_team_logo_(const std::string &team_name);
+    // Names are normalized once, here, so lookups from the draw modes are a
+    // single hash probe
+    void register_logo_(const std::string &team_name, TeamLogo logo);
+    const TeamLogo *get_team_logo_(const std::string &team_name);
+    const TeamLogo *find_team_logo_(const std::string &key) const;
     
     void draw_scheduled_mode_();
     void draw_today_pending_mode_();
     void draw_in_progress_mode_();
     void draw_finished_mode_();
     
-    void draw_team_row_(int y, const Team &team, bool is_favorite, image::Image *logo);
+    void draw_team_row_(int y, const Team &team, bool is_favorite, const TeamLogo *logo);
     void draw_date_time_(int x, int y, time_t match_time);
     void draw_countdown_(int x, int y, int hours, int minutes);
     void draw_score_(int x, int y, int home_score, int away_score);
@@ -93,32 +233,102 @@ class SoccerTracker : public Component {
     display::Display *display_ = nullptr;
     font::Font *font_ = nullptr;
     font::Font *small_font_ = nullptr;
+    matrix_render::TextMetrics font_metrics_;
+    matrix_render::TextMetrics small_font_metrics_;
     time::RealTimeClock *rtc_ = nullptr;
-    http_request::HttpRequestComponent *http_request_ = nullptr;
+    connection_manager::ConnectionManager *connection_manager_ = nullptr;
     
     std::string api_key_;
     std::string favorite_team_;
     int team_id_ = 0;
+    std::vector<int> extra_team_ids_;
+    std::vector<uint32_t> team_ids_;  // team_id first, then the extra teams without duplicates
+    int league_id_ = 253;  // MLS
+    int season_ = 0;       // 0: the current calendar year
+    uint32_t rotate_interval_ = 10000;
+    bool season_cache_enabled_ = false;
+    SeasonCache season_cache_{SEASON_CACHE_PATH};
     bool test_mode_ = false;
     std::string test_server_url_;
     
-    Match current_match_;
+    FixtureTable fixtures_;
+    Match current_match_;  // The fixture on display
     bool has_match_data_ = false;
+    time_t last_discovery_ = 0;
     bool initial_fetch_done_ = false;
     unsigned long last_fetch_ = 0;
-    unsigned long last_update_ = 0;
-    bool colon_visible_ = true;
+    connection_manager::Backoff fetch_backoff_;  // Delays after failed fetches
+    time_t transition_at_ = 0;  // Instant the transition timer is armed for, 0 if none
+    time_t transition_armed_at_ = 0;  // Clock time the timer was armed at
+    uint32_t next_frame_at_ = 0;
+
+    std::thread fetch_thread_;
+    std::atomic<bool> fetch_in_flight_{false};
+    std::atomic<bool> fetch_complete_{false};
+    std::atomic<bool> poll_requested_{false};
+    FetchResult fetch_result_{};
+
+    uint32_t scheduled_interval_ = 6 * 60 * 60 * 1000;
+    uint32_t pending_interval_ = 10 * 60 * 1000;
+    uint32_t live_interval_ = 30 * 1000;
+
+    // Conditional request validators, only valid for the URL they came from
+    std::string validator_url_;
+    std::string etag_;
+    std::string last_modified_;
+
+    int quota_remaining_ = -1;
+    int quota_limit_ = -1;
+    bool minute_quota_exhausted_ = false;
+
+#ifdef USE_SOCCER_PUSH
+    websockets::WebsocketsClient push_client_{};
+    std::string push_url_;
+    connection_manager::Backoff push_backoff_;
+    unsigned long last_push_heartbeat_ = 0;
+    int64_t push_sent_at_ = 0;  // "sentAt" of the newest score event not drawn yet, 0 if none
+#endif
     
-    std::map<std::string, image::Image*> team_logos_;
-    std::map<std::string, image::Image*> logo_cache_;  // Cache for team name -> logo lookups
+    LogoIndex logo_index_;  // Normalized team name -> logo
+    LogoCache logo_cache_;  // API team name -> logo, nullptr for names with no logo
     
-    // Polling interval: 5 minutes normally, 1 second in test mode
+    // Polling interval against the test server
     #ifdef SOCCER_TEST_MODE
-    static constexpr unsigned long FETCH_INTERVAL = 1000; // 1 second (test)
+    static constexpr uint32_t TEST_POLL_INTERVAL = 1000; // 1 second
     #else
-    static constexpr unsigned long FETCH_INTERVAL = 300000; // 5 minutes
+    static constexpr uint32_t TEST_POLL_INTERVAL = 10000; // 10 seconds
     #endif
+    // Retry delays when nothing could be sent, or nothing came back to show;
+    // failed requests back off under the connection manager's policy instead
+    static constexpr uint32_t PRECONDITION_RETRY_INTERVAL = 2000;
+    static constexpr uint32_t ERROR_RETRY_INTERVAL = 60000;
+    // Daily requests held back for live matches
+    static constexpr int QUOTA_RESERVE = 10;
     static constexpr unsigned long UPDATE_INTERVAL = 1000;   // 1 second
+    static constexpr unsigned long IDLE_FRAME_INTERVAL = 60000;
+    // Expected halftime and full-time windows after kickoff, stoppage time included
+    static constexpr time_t HALFTIME_AFTER = 47 * 60;
+    static constexpr time_t FULLTIME_AFTER = 109 * 60;
+    // How long a finished match stays up before the next one is fetched
+    static constexpr time_t FINISHED_DISPLAY_TIME = 60 * 60;
+    // Longest single wait of the transition timer; it re-arms against the clock
+    // after that, so SNTP corrections never leave it far off
+    static constexpr time_t MAX_TRANSITION_WAIT = 6 * 60 * 60;
+    static constexpr uint32_t FETCH_STACK_SIZE = 10240;
+    // Longest gap allowed between body bytes before the fetch is abandoned
+    static constexpr uint32_t READ_TIMEOUT = 2000;
+    // Fixtures per league request: a couple of rounds, enough to reach every team's next match
+    static constexpr int LEAGUE_LOOKAHEAD = 40;
+    // API-Football accepts up to 20 fixture ids per request
+    static constexpr size_t MAX_IDS_PER_REQUEST = 20;
+    static constexpr const char *SEASON_CACHE_PATH = "/littlefs/soccer_season.bin";
+    // Schedules change rarely, but do change (rescheduled rounds, cup and playoff dates)
+    static constexpr time_t SEASON_REFRESH_INTERVAL = 7 * 24 * 60 * 60;
+    // How often a team with nothing left in the cache is looked up again
+    static constexpr time_t SEASON_RETRY_INTERVAL = 24 * 60 * 60;
+#ifdef USE_SOCCER_PUSH
+    static constexpr unsigned long PUSH_HEARTBEAT_TIMEOUT = 60000;
+#endif
 };
 
 }  // namespace soccer_tracker
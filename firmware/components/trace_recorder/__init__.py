@@ -0,0 +1,38 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, CONF_PATH
+
+# Binary trace events from the trackers, served as Chrome trace JSON. Loaded
+# through AUTO_LOAD; unless enabled, nothing is recorded and every trace
+# point compiles to nothing.
+
+AUTO_LOAD = ["memory_placement", "web_server_base"]
+
+trace_recorder_ns = cg.esphome_ns.namespace("trace_recorder")
+TraceRecorder = trace_recorder_ns.class_("TraceRecorder", cg.Component)
+
+CONF_ENABLED = "enabled"
+CONF_BUFFER_SIZE = "buffer_size"
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(TraceRecorder),
+        cv.Optional(CONF_ENABLED, default=False): cv.boolean,
+        # 16 bytes per event, in the trace_buffer memory category
+        cv.Optional(CONF_BUFFER_SIZE, default=2048): cv.int_range(min=64, max=65536),
+        cv.Optional(CONF_PATH, default="/trace.json"): cv.string,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    if not config[CONF_ENABLED]:
+        return
+
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
+    cg.add(var.set_path(config[CONF_PATH]))
+
+    cg.add_define("USE_TRACE_RECORDER")
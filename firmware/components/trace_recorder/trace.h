@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+
+// Trace points for the trace_recorder component. Without `enabled: true` in
+// its config they expand to nothing, so they can stay in hot paths.
+//
+// Names must be string literals: only the pointer is recorded.
+//
+//   TRACE_SCOPE("render");              // begin here, end at the closing brace
+//   TRACE_BEGIN("parse"); ... TRACE_END("parse");
+//   TRACE_INSTANT("http read", bytes);  // a point in time with a value
+//   TRACE_COUNTER("trips", count);      // a value plotted over time
+
+namespace esphome {
+namespace trace_recorder {
+
+enum Phase : uint8_t {
+  PHASE_BEGIN = 'B',
+  PHASE_END = 'E',
+  PHASE_INSTANT = 'i',
+  PHASE_COUNTER = 'C',
+};
+
+#ifdef USE_TRACE_RECORDER
+void record(Phase phase, const char *name, uint32_t value = 0);
+
+class TraceScope {
+  public:
+    explicit TraceScope(const char *name) : name_(name) { record(PHASE_BEGIN, name); }
+    ~TraceScope() { record(PHASE_END, this->name_); }
+
+  protected:
+    const char *name_;
+};
+#endif
+
+}  // namespace trace_recorder
+}  // namespace esphome
+
+#ifdef USE_TRACE_RECORDER
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_BEGIN(name) ::esphome::trace_recorder::record(::esphome::trace_recorder::PHASE_BEGIN, name)
+#define TRACE_END(name) ::esphome::trace_recorder::record(::esphome::trace_recorder::PHASE_END, name)
+#define TRACE_INSTANT(name, value) \
+  ::esphome::trace_recorder::record(::esphome::trace_recorder::PHASE_INSTANT, name, value)
+#define TRACE_COUNTER(name, value) \
+  ::esphome::trace_recorder::record(::esphome::trace_recorder::PHASE_COUNTER, name, value)
+#define TRACE_SCOPE(name) ::esphome::trace_recorder::TraceScope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_BEGIN(name) \
+  do { \
+  } while (0)
+#define TRACE_END(name) \
+  do { \
+  } while (0)
+#define TRACE_INSTANT(name, value) \
+  do { \
+  } while (0)
+#define TRACE_COUNTER(name, value) \
+  do { \
+  } while (0)
+#define TRACE_SCOPE(name) \
+  do { \
+  } while (0)
+#endif
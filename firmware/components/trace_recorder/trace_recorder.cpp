@@ -0,0 +1,234 @@
+#include "trace_recorder.h"
+
+#ifdef USE_TRACE_RECORDER
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_http_server.h>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/components/memory_placement/placement.h"
+#include "esphome/components/web_server_base/web_server_base.h"
+
+namespace esphome {
+namespace trace_recorder {
+
+static const char *TAG = "trace_recorder";
+
+TraceRecorder *global_trace_recorder = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void record(Phase phase, const char *name, uint32_t value) {
+  TraceRecorder *recorder = global_trace_recorder;
+  if (recorder != nullptr) {
+    recorder->record(phase, name, value);
+  }
+}
+
+TraceRecorder::TraceRecorder() { global_trace_recorder = this; }
+
+void TraceRecorder::setup() {
+  this->events_ = static_cast<Event *>(
+      memory_placement::allocate(memory_placement::CATEGORY_TRACE_BUFFER, this->buffer_size_ * sizeof(Event)));
+  if (this->events_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate %u trace events", (unsigned) this->buffer_size_);
+    this->mark_failed();
+    return;
+  }
+  // An event slot claimed but not yet written reads as empty
+  memset(this->events_, 0, this->buffer_size_ * sizeof(Event));
+
+  if (web_server_base::global_web_server_base == nullptr) {
+    return;
+  }
+  auto server = web_server_base::global_web_server_base->get_server();
+  if (server == nullptr) {
+    return;
+  }
+
+  // GET <path>[?clear=1]
+  class Handler : public AsyncWebHandler {
+   public:
+    explicit Handler(TraceRecorder *recorder) : recorder_(recorder) {}
+    bool canHandle(AsyncWebServerRequest *request) const override { return request->url() == recorder_->path_; }
+    void handleRequest(AsyncWebServerRequest *request) override {
+      // Sent in chunks as it is formatted; the whole trace would be ~80 bytes per event
+      httpd_req_t *req = *request;
+      httpd_resp_set_type(req, "application/json");
+      {
+        Export trace(recorder_);
+        char chunk[1024];
+        size_t length;
+        while ((length = trace.read(chunk, sizeof(chunk))) > 0) {
+          if (httpd_resp_send_chunk(req, chunk, length) != ESP_OK) {
+            ESP_LOGW(TAG, "Trace download aborted");
+            break;
+          }
+        }
+      }
+      httpd_resp_send_chunk(req, nullptr, 0);
+      if (request->hasParam("clear")) {
+        recorder_->clear();
+      }
+    }
+    TraceRecorder *recorder_;
+  };
+  server->addHandler(new Handler(this));  // NOLINT
+}
+
+void TraceRecorder::dump_config() {
+  ESP_LOGCONFIG(TAG, "Trace Recorder:");
+  ESP_LOGCONFIG(TAG, "  Buffer: %u events (%u bytes)", (unsigned) this->buffer_size_,
+                (unsigned) (this->buffer_size_ * sizeof(Event)));
+  ESP_LOGCONFIG(TAG, "  Path: %s", this->path_.c_str());
+}
+
+void TraceRecorder::record(Phase phase, const char *name, uint32_t value) {
+  if (this->events_ == nullptr || this->paused_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  uint32_t index = this->head_.fetch_add(1, std::memory_order_relaxed);
+  Event &event = this->events_[index % this->buffer_size_];
+  event.timestamp = micros();
+  event.name = name;
+  event.value = value;
+  event.phase = phase;
+  event.thread = this->thread_index_();
+}
+
+uint8_t TraceRecorder::thread_index_() {
+  void *handle = xTaskGetCurrentTaskHandle();
+  uint8_t count = this->thread_count_.load(std::memory_order_acquire);
+  for (uint8_t i = 0; i < count; i++) {
+    if (this->threads_[i].handle == handle) {
+      return i;
+    }
+  }
+
+  // A task's first event; threads that come and go (like fetch threads) may
+  // reuse a handle, so the name is the one it had first
+  std::lock_guard<std::mutex> lock(this->threads_mutex_);
+  count = this->thread_count_.load(std::memory_order_relaxed);
+  for (uint8_t i = 0; i < count; i++) {
+    if (this->threads_[i].handle == handle) {
+      return i;
+    }
+  }
+  if (count == MAX_THREADS) {
+    return MAX_THREADS - 1;
+  }
+  Thread &thread = this->threads_[count];
+  thread.handle = handle;
+  strncpy(thread.name, pcTaskGetName(nullptr), sizeof(thread.name) - 1);
+  thread.name[sizeof(thread.name) - 1] = '\0';
+  this->thread_count_.store(count + 1, std::memory_order_release);
+  return count;
+}
+
+TraceRecorder::Export::Export(TraceRecorder *recorder) : recorder_(recorder) {
+  recorder->paused_ = true;
+  // Let an event being written as recording paused land
+  delayMicroseconds(50);
+
+  uint32_t head = recorder->events_ != nullptr ? recorder->head_.load() : 0;
+  this->count_ = std::min<uint32_t>(head, recorder->buffer_size_);
+  this->head_ = head;
+  this->next_ = head - this->count_;
+  this->start_ = this->count_ > 0 ? recorder->events_[this->next_ % recorder->buffer_size_].timestamp : 0;
+}
+
+TraceRecorder::Export::~Export() {
+  this->recorder_->paused_ = false;
+  ESP_LOGD(TAG, "Exported %u trace events (%u bytes)", (unsigned) this->count_, (unsigned) this->bytes_);
+}
+
+size_t TraceRecorder::Export::read(char *buf, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len) {
+    if (this->line_sent_ == this->line_length_) {
+      if (!this->next_line_()) {
+        break;
+      }
+      this->line_sent_ = 0;
+    }
+    size_t n = std::min(max_len - written, this->line_length_ - this->line_sent_);
+    memcpy(buf + written, this->line_ + this->line_sent_, n);
+    this->line_sent_ += n;
+    written += n;
+  }
+  this->bytes_ += written;
+  return written;
+}
+
+bool TraceRecorder::Export::next_line_() {
+  const char *separator = this->separate_ ? ",\n" : "\n";
+  int length = 0;
+  if (!this->opened_) {
+    length = snprintf(this->line_, sizeof(this->line_), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    this->opened_ = true;
+  } else if (this->thread_ < this->recorder_->thread_count_) {
+    length = snprintf(this->line_, sizeof(this->line_),
+                      "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                      separator, this->thread_, this->recorder_->threads_[this->thread_].name);
+    this->thread_++;
+    this->separate_ = true;
+  } else {
+    // Skip slots claimed but never written
+    const Event *event = nullptr;
+    while (this->next_ != this->head_ && event == nullptr) {
+      event = &this->recorder_->events_[this->next_ % this->recorder_->buffer_size_];
+      this->next_++;
+      if (event->name == nullptr) {
+        event = nullptr;
+      }
+    }
+
+    if (event != nullptr) {
+      // Relative to the oldest event, so micros() wrapping doesn't matter
+      uint32_t ts = event->timestamp - this->start_;
+      switch (event->phase) {
+        case PHASE_INSTANT:
+          length = snprintf(this->line_, sizeof(this->line_),
+                            "%s{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%" PRIu32
+                            ",\"pid\":1,\"tid\":%u,\"args\":{\"value\":%" PRIu32 "}}",
+                            separator, event->name, ts, event->thread, event->value);
+          break;
+        case PHASE_COUNTER:
+          length = snprintf(this->line_, sizeof(this->line_),
+                            "%s{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%" PRIu32 ",\"pid\":1,\"args\":{\"value\":%" PRIu32
+                            "}}",
+                            separator, event->name, ts, event->value);
+          break;
+        default:
+          length = snprintf(this->line_, sizeof(this->line_),
+                            "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu32 ",\"pid\":1,\"tid\":%u}", separator,
+                            event->name, (char) event->phase, ts, event->thread);
+          break;
+      }
+      this->separate_ = true;
+    } else if (!this->closed_) {
+      length = snprintf(this->line_, sizeof(this->line_), "\n]}\n");
+      this->closed_ = true;
+    } else {
+      return false;
+    }
+  }
+  this->line_length_ = std::min<size_t>(std::max(length, 0), sizeof(this->line_) - 1);
+  return true;
+}
+
+void TraceRecorder::clear() {
+  this->paused_ = true;
+  this->head_ = 0;
+  this->paused_ = false;
+}
+
+}  // namespace trace_recorder
+}  // namespace esphome
+
+#endif  // USE_TRACE_RECORDER
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "esphome/core/component.h"
+
+#include "trace.h"
+
+namespace esphome {
+namespace trace_recorder {
+
+// A fixed-size ring of binary trace events, recorded from any task without
+// formatting or locking, and served as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev) from the web server. Once full, the oldest events are
+// overwritten, so a download shows the last few seconds before it. The JSON
+// is streamed a line at a time rather than built in memory.
+class TraceRecorder : public Component {
+  public:
+    // 16 bytes
+    struct Event {
+      uint32_t timestamp;  // micros()
+      const char *name;
+      uint32_t value;
+      Phase phase;
+      uint8_t thread;  // Index into threads_
+      uint16_t reserved;
+    };
+
+    TraceRecorder();
+
+    void setup() override;
+    void dump_config() override;
+
+    float get_setup_priority() const override { return setup_priority::WIFI - 1.0f; }
+
+    void set_buffer_size(size_t buffer_size) { buffer_size_ = buffer_size; }
+    void set_path(const std::string &path) { path_ = path; }
+
+    // The recorded events as Chrome trace JSON, oldest first, read out in
+    // pieces of any size. Recording pauses while one exists.
+    class Export {
+      public:
+        explicit Export(TraceRecorder *recorder);
+        ~Export();
+
+        // Copies the next at most max_len bytes of the JSON into buf; 0 at the end
+        size_t read(char *buf, size_t max_len);
+
+      protected:
+        // Formats the next line into line_; false once there are none left
+        bool next_line_();
+
+        TraceRecorder *recorder_;
+        uint32_t next_;  // Next event to format
+        uint32_t head_;
+        uint32_t start_;  // Timestamp the trace starts at
+        uint32_t count_;  // Events in the ring when the export began
+        uint8_t thread_ = 0;  // Next thread name to format
+        bool opened_ = false;
+        bool closed_ = false;
+        bool separate_ = false;
+        size_t bytes_ = 0;
+        char line_[160];
+        size_t line_length_ = 0;
+        size_t line_sent_ = 0;
+    };
+
+    void record(Phase phase, const char *name, uint32_t value);
+    void clear();
+
+    static constexpr size_t MAX_THREADS = 16;
+
+  protected:
+    uint8_t thread_index_();
+
+    size_t buffer_size_ = 2048;
+    std::string path_ = "/trace.json";
+
+    Event *events_ = nullptr;
+    std::atomic<uint32_t> head_{0};  // Events recorded since the last clear()
+    std::atomic<bool> paused_{false};
+
+    struct Thread {
+      void *handle;
+      char name[16];
+    };
+    Thread threads_[MAX_THREADS];
+    std::atomic<uint8_t> thread_count_{0};
+    std::mutex threads_mutex_;  // Only taken the first time a task records
+};
+
+extern TraceRecorder *global_trace_recorder;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace trace_recorder
+}  // namespace esphome
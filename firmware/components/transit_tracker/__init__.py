@@ -1,16 +1,20 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components.http_request import CONF_HTTP_REQUEST_ID, HttpRequestComponent
+import esphome.final_validate as fv
+from esphome.components.connection_manager import CONF_CONNECTION_MANAGER_ID, ConnectionManager
 from esphome.components.display import Display
 from esphome.components.font import Font
 from esphome.components.time import RealTimeClock
 from esphome.components import color
-from esphome.const import CONF_ID, CONF_DISPLAY_ID, CONF_TIME_ID, CONF_SHOW_UNITS, __version__ as ESPHOME_VERSION
+from esphome.const import (
+    CONF_ID, CONF_DISPLAY_ID, CONF_PLATFORM, CONF_TIME_ID, CONF_SHOW_UNITS, __version__ as ESPHOME_VERSION
+)
 
 _MINIMUM_ESPHOME_VERSION = "2025.7.0"
 
 DEPENDENCIES = ["network"]
-AUTO_LOAD = ["json", "watchdog"]
+AUTO_LOAD = ["json", "watchdog", "matrix_render", "memory_placement", "connection_manager", "trace_recorder",
+             "alloc_audit"]
 
 transit_tracker_ns = cg.esphome_ns.namespace("transit_tracker")
 TransitTracker = transit_tracker_ns.class_("TransitTracker", cg.Component)
@@ -34,6 +38,14 @@ CONF_DEFAULT_ROUTE_COLOR = "default_route_color"
 CONF_TIME_DISPLAY = "time_display"
 CONF_LIST_MODE = "list_mode"
 CONF_SCROLL_HEADSIGNS = "scroll_headsigns"
+CONF_PAGE_DWELL_TIME = "page_dwell_time"
+CONF_PAGE_TRANSITION = "page_transition"
+CONF_RENDER_BANDS = "render_bands"
+CONF_TRIP_WINDOW = "trip_window"
+
+# Display platforms whose draw_pixels_at() copies rows rather than falling back
+# to ESPHome's per-pixel loop, so flipping the banded back buffer is cheap
+ROW_COPY_DISPLAY_PLATFORMS = ["ili9xxx", "mipi_spi", "qspi_dbi", "rpi_dpi_rgb", "st7701s"]
 
 
 def validate_ws_url(value):
@@ -61,8 +73,9 @@ CONFIG_SCHEMA = cv.All(
             cv.GenerateID(CONF_DISPLAY_ID): cv.use_id(Display),
             cv.GenerateID(CONF_FONT_ID): cv.use_id(Font),
             cv.GenerateID(CONF_TIME_ID): cv.use_id(RealTimeClock),
+            cv.GenerateID(CONF_CONNECTION_MANAGER_ID): cv.use_id(ConnectionManager),
             cv.Optional(CONF_BASE_URL): validate_ws_url,
-            cv.Optional(CONF_LIMIT, default=3): cv.positive_int,
+            cv.Optional(CONF_LIMIT, default=3): cv.int_range(min=1),
             cv.Optional(CONF_FEED_CODE, default=""): cv.string,
             cv.Optional(CONF_TIME_DISPLAY, default="departure"): cv.one_of(
                 "departure", "arrival"
@@ -71,6 +84,17 @@ CONFIG_SCHEMA = cv.All(
                 "sequential", "nextPerRoute"
             ),
             cv.Optional(CONF_SCROLL_HEADSIGNS, default=False) : cv.boolean,
+            cv.Optional(CONF_PAGE_DWELL_TIME, default="5s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_PAGE_TRANSITION, default="scroll"): cv.one_of(
+                "none", "scroll"
+            ),
+            # Threads rasterizing the schedule into a back buffer. The flip to a HUB75 panel
+            # goes through its per-pixel draw_pixel_at() and costs more than drawing the
+            # schedule directly (host/band_benchmark.cpp), so more than 1 is only accepted
+            # on a display driver that overrides draw_pixels_at().
+            cv.Optional(CONF_RENDER_BANDS, default=1): cv.int_range(min=1, max=8),
+            # Trips (routes, for nextPerRoute) subscribed to, from which the trips shown are picked on the device
+            cv.Optional(CONF_TRIP_WINDOW, default=0): cv.int_range(min=0, max=64),
             cv.Optional(CONF_STOPS, default=[]): cv.ensure_list(
                 cv.Schema(
                     {
@@ -104,6 +128,25 @@ CONFIG_SCHEMA = cv.All(
 )
 
 
+def _final_validate(config):
+    if config[CONF_RENDER_BANDS] == 1:
+        return config
+
+    full_config = fv.full_config.get()
+    display_path = full_config.get_path_for_id(config[CONF_DISPLAY_ID])[:-1]
+    platform = full_config.get_config_for_path(display_path)[CONF_PLATFORM]
+    if platform not in ROW_COPY_DISPLAY_PLATFORMS:
+        raise cv.Invalid(
+            f"The {platform} display draws a pixel at a time, so flipping the bands costs more " +
+            "than rendering them saves; render_bands must be 1",
+            path=[CONF_RENDER_BANDS],
+        )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 def _generate_schedule_string(stops):
     return ";".join(
         [
@@ -126,6 +169,11 @@ async def to_code(config):
     time = await cg.get_variable(config[CONF_TIME_ID])
     cg.add(var.set_rtc(time))
 
+    connection_manager = await cg.get_variable(config[CONF_CONNECTION_MANAGER_ID])
+    cg.add(var.set_connection_manager(connection_manager))
+    # Its sync is what hands the clock over from the servers to the time source
+    cg.add(connection_manager.set_time(time))
+
     if CONF_BASE_URL in config:
         cg.add(var.set_base_url(config[CONF_BASE_URL]))
 
@@ -137,8 +185,12 @@ async def to_code(config):
 
     cg.add(var.set_list_mode(config[CONF_LIST_MODE]))
     cg.add(var.set_scroll_headsigns(config[CONF_SCROLL_HEADSIGNS]))
+    cg.add(var.set_page_dwell_time(config[CONF_PAGE_DWELL_TIME]))
+    cg.add(var.set_page_transition(config[CONF_PAGE_TRANSITION] == "scroll"))
+    cg.add(var.set_render_bands(config[CONF_RENDER_BANDS]))
 
     cg.add(var.set_limit(config[CONF_LIMIT]))
+    cg.add(var.set_trip_window(config[CONF_TRIP_WINDOW]))
 
     cg.add(var.set_unit_display(config[CONF_SHOW_UNITS]))
 
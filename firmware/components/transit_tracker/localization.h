@@ -17,7 +17,7 @@ class Localization {
   public:
     // Inline implementation to ensure availability during linking
     std::string fmt_duration_from_now(time_t unix_timestamp, uint rtc_now) const {
-      long diff = static_cast<long>(unix_timestamp - rtc_now);
+      long diff = static_cast<long>(unix_timestamp - rtc_now) - this->clock_skew_;
 
       if (diff < 30) {
         return this->now_string_;
@@ -66,18 +66,38 @@ class Localization {
       }
     }
 
+    // Seconds until fmt_duration_from_now() returns a different string, or -1 if it won't
+    long seconds_until_change(time_t unix_timestamp, uint rtc_now) const {
+      long diff = static_cast<long>(unix_timestamp - rtc_now) - this->clock_skew_;
+
+      if (diff < 30) {
+        return -1;
+      }
+
+      if (diff < 60) {
+        return diff - 29;
+      }
+
+      return diff % 60 + 1;
+    }
+
     void set_unit_display(UnitDisplay unit_display) { unit_display_ = unit_display; }
     void set_now_string(const std::string &now_string) { now_string_ = now_string; }
     void set_minutes_long_string(const std::string &minutes_long_string) { minutes_long_string_ = minutes_long_string; }
     void set_minutes_short_string(const std::string &minutes_short_string) { minutes_short_string_ = minutes_short_string; }
     void set_hours_short_string(const std::string &hours_short_string) { hours_short_string_ = hours_short_string; }
 
+    // Seconds the server clock is ahead of the local clock; countdowns are computed against server time
+    void set_clock_skew(long clock_skew) { clock_skew_ = clock_skew; }
+    long get_clock_skew() const { return clock_skew_; }
+
   protected:
     UnitDisplay unit_display_ = UNIT_DISPLAY_LONG;
     std::string now_string_ = "Now";
     std::string minutes_long_string_ = "min";
     std::string minutes_short_string_ = "m";
     std::string hours_short_string_ = "h";
+    long clock_skew_ = 0;
 };
 
 }  // namespace transit_tracker
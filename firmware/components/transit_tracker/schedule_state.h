@@ -4,6 +4,7 @@
 #include <mutex>
 
 #include "esphome/components/display/display.h"
+#include "esphome/components/memory_placement/placement.h"
 
 namespace esphome {
 namespace transit_tracker {
@@ -19,10 +20,18 @@ class Trip {
     bool is_realtime;
 };
 
+// Trips read on every frame, in internal RAM by default
+using TripList = memory_placement::PlacementVector<Trip, memory_placement::CATEGORY_SCHEDULE>;
+// Trips only read when the view is rebuilt, in PSRAM by default
+using TripWindow = memory_placement::PlacementVector<Trip, memory_placement::CATEGORY_TIMETABLE>;
+
 class ScheduleState {
   public:
     std::mutex mutex;
-    std::vector<Trip> trips;
+    // The trips shown, in order
+    TripList trips;
+    // With a trip window, every trip the server sent, soonest first; trips is a view over it
+    TripWindow window;
 };
 
 } // namespace transit_tracker
@@ -0,0 +1,60 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    DEVICE_CLASS_DURATION,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+)
+
+from . import TransitTracker
+
+DEPENDENCIES = ["transit_tracker"]
+
+CONF_TRANSIT_TRACKER_ID = "transit_tracker_id"
+CONF_SERVER_LATENCY = "server_latency"
+CONF_RENDER_LATENCY = "render_latency"
+CONF_PING_RTT = "ping_rtt"
+CONF_CLOCK_SKEW = "clock_skew"
+
+_LATENCY_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    accuracy_decimals=0,
+    device_class=DEVICE_CLASS_DURATION,
+    state_class=STATE_CLASS_MEASUREMENT,
+    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(CONF_TRANSIT_TRACKER_ID): cv.use_id(TransitTracker),
+        # Server "sentAt" to parsed schedule, corrected for clock skew
+        cv.Optional(CONF_SERVER_LATENCY): _LATENCY_SCHEMA,
+        # Parsed schedule to first frame drawn with it
+        cv.Optional(CONF_RENDER_LATENCY): _LATENCY_SCHEMA,
+        cv.Optional(CONF_PING_RTT): _LATENCY_SCHEMA,
+        # How far the server clock is ahead of the SNTP clock
+        cv.Optional(CONF_CLOCK_SKEW): _LATENCY_SCHEMA,
+    }
+)
+
+
+async def to_code(config):
+    parent = await cg.get_variable(config[CONF_TRANSIT_TRACKER_ID])
+
+    if server_latency := config.get(CONF_SERVER_LATENCY):
+        sens = await sensor.new_sensor(server_latency)
+        cg.add(parent.set_server_latency_sensor(sens))
+
+    if render_latency := config.get(CONF_RENDER_LATENCY):
+        sens = await sensor.new_sensor(render_latency)
+        cg.add(parent.set_render_latency_sensor(sens))
+
+    if ping_rtt := config.get(CONF_PING_RTT):
+        sens = await sensor.new_sensor(ping_rtt)
+        cg.add(parent.set_ping_rtt_sensor(sens))
+
+    if clock_skew := config.get(CONF_CLOCK_SKEW):
+        sens = await sensor.new_sensor(clock_skew)
+        cg.add(parent.set_clock_skew_sensor(sens))
@@ -1,52 +1,99 @@
 #include "transit_tracker.h"
 #include "string_utils.h"
+#include "trip_view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sys/time.h>
 
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include "esphome/components/json/json_util.h"
 #include "esphome/components/watchdog/watchdog.h"
 #include "esphome/components/network/util.h"
+#include "esphome/components/matrix_render/span_buffer.h"
+#include "esphome/components/alloc_audit/alloc_scope.h"
+#include "esphome/components/trace_recorder/trace.h"
 
 namespace esphome {
 namespace transit_tracker {
 
 static const char *TAG = "transit_tracker.component";
 
+// Wall clock in epoch milliseconds; only meaningful once the RTC has synced
+static int64_t wall_clock_ms() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return static_cast<int64_t>(tv.tv_sec) * 1000 + tv.tv_usec / 1000;
+}
+
 void TransitTracker::setup() {
-  this->ws_client_.onMessage([this](websockets::WebsocketsMessage message) {
-    this->on_ws_message_(message);
-  });
+  this->font_metrics_.build(this->font_);
+  this->backoff_ = this->connection_manager_->make_backoff();
 
-  this->ws_client_.onEvent([this](websockets::WebsocketsEvent event, String data) {
-    this->on_ws_event_(event, data);
-  });
+  if (this->render_bands_ > 1) {
+    this->band_renderer_.reset(new matrix_render::BandedRenderer(this->render_bands_));
+  }
 
+  // The server's name is looked up while SNTP syncs, and the connection is
+  // made the moment the network is ready rather than at the next retry
+  this->connection_manager_->prefetch(this->base_url_);
+  this->connection_manager_->add_on_network_ready_callback([this]() {
+    this->cancel_timeout("reconnect");
+    this->connect_ws_();
+  });
   this->connect_ws_();
 
   this->set_interval("check_stale_trips", 10000, [this]() {
-    if (this->ws_client_.available() && !this->schedule_state_.trips.empty()) {
-      bool has_stale_trips = false;
+    if (!this->ws_client_.available()) {
+      return;
+    }
+    auto now = this->rtc_->now();
+    if (!now.is_valid()) {
+      return;
+    }
+    auto is_stale = [&now](const Trip &trip) { return now.timestamp - trip.departure_time > 60; };
 
+    if (this->trip_window_ > 0) {
+      // Trips a minute past departure leave the window, and the view is backfilled from the
+      // rest; only a window that can no longer fill the view resubscribes
       this->schedule_state_.mutex.lock();
+      TripWindow &window = this->schedule_state_.window;
+      size_t size = window.size();
+      window.erase(std::remove_if(window.begin(), window.end(), is_stale), window.end());
+      bool dropped = window.size() != size;
+      this->schedule_state_.mutex.unlock();
 
-      auto now = this->rtc_->now();
-      if (now.is_valid()) {
-        for (auto &trip : this->schedule_state_.trips) {
-          if (now.timestamp - trip.departure_time > 60) {
-            has_stale_trips = true;
-            break;
-          }
+      if (dropped) {
+        this->update_view_();
+        this->schedule_state_.mutex.lock();
+        bool short_view = (int) this->schedule_state_.trips.size() < this->limit_;
+        this->schedule_state_.mutex.unlock();
+        if (short_view) {
+          ESP_LOGD(TAG, "Too few trips left in the window, resubscribing");
+          this->reconnect();
         }
       }
+      return;
+    }
 
-      this->schedule_state_.mutex.unlock();
+    this->schedule_state_.mutex.lock();
+    const TripList &trips = this->schedule_state_.trips;
+    bool has_stale_trips = std::any_of(trips.begin(), trips.end(), is_stale);
+    this->schedule_state_.mutex.unlock();
 
-      if (has_stale_trips) {
-        ESP_LOGD(TAG, "Stale trips detected, reconnecting");
-        ESP_LOGD(TAG, "  Current RTC time: %d", now.timestamp);
-        ESP_LOGD(TAG, "  Last heartbeat: %d", this->last_heartbeat_);
-        this->reconnect();
-      }
+    if (has_stale_trips) {
+      ESP_LOGD(TAG, "Stale trips detected, reconnecting");
+      ESP_LOGD(TAG, "  Current RTC time: %d", now.timestamp);
+      ESP_LOGD(TAG, "  Last heartbeat: %d", this->last_heartbeat_);
+      this->reconnect();
+    }
+  });
+
+  this->set_interval("ping", ping_interval, [this]() {
+    if (this->ws_client_.available()) {
+      this->ping_sent_at_ = millis();
+      this->ws_client_.ping();
     }
   });
 }
@@ -59,6 +106,24 @@ void TransitTracker::loop() {
     this->reconnect();
     return;
   }
+
+  if (this->trip_window_ > 0) {
+    // A trip shown has departed, or the view settings changed: the view is rebuilt from the window
+    bool expired = this->view_expires_at_ != 0 && this->rtc_->now().is_valid() &&
+                   this->rtc_->now().timestamp + this->localization_.get_clock_skew() >= this->view_expires_at_;
+    if (this->view_changed_ || expired) {
+      this->update_view_();
+    }
+  }
+
+  if (this->settings_changed_) {
+    this->settings_changed_ = false;
+    // Not connected yet, the first subscription has the new settings
+    if (this->ws_client_.available() && (this->trip_window_ == 0 || this->window_short_())) {
+      ESP_LOGD(TAG, "List settings changed, resubscribing");
+      this->reconnect();
+    }
+  }
 }
 
 void TransitTracker::dump_config() {
@@ -68,7 +133,13 @@ void TransitTracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Limit: %d", this->limit_);
   ESP_LOGCONFIG(TAG, "  List mode: %s", this->list_mode_.c_str());
   ESP_LOGCONFIG(TAG, "  Display departure times: %s", this->display_departure_times_ ? "true" : "false");
+  if (this->trip_window_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Trip window: %d (list computed on device)", this->trip_window_);
+  }
   ESP_LOGCONFIG(TAG, "  Scroll Headsigns: %s", this->scroll_headsigns_ ? "true" : "false");
+  ESP_LOGCONFIG(TAG, "  Page dwell time: %ums", this->page_dwell_time_);
+  ESP_LOGCONFIG(TAG, "  Page transition: %s", this->page_transition_ ? "scroll" : "none");
+  ESP_LOGCONFIG(TAG, "  Render bands: %d", this->render_bands_);
 }
 
 void TransitTracker::reconnect() {
@@ -86,13 +157,34 @@ void TransitTracker::close(bool fully) {
 
 void TransitTracker::on_shutdown() {
   this->cancel_interval("check_stale_trips");
+  this->cancel_interval("ping");
   this->close(true);
 }
 
 void TransitTracker::on_ws_message_(websockets::WebsocketsMessage message) {
+  TRACE_INSTANT("ws message", message.rawData().size());
+  TRACE_SCOPE("parse");
+  ALLOC_SCOPE("ws_message");
   ESP_LOGV(TAG, "Received message: %s", message.rawData().c_str());
 
-  bool valid = json::parse_json(message.rawData(), [this](JsonObject root) -> bool {
+  // Stamp arrival before parsing so parse time doesn't count towards clock skew
+  int64_t received_at = this->rtc_->now().is_valid() ? wall_clock_ms() : 0;
+
+  bool valid = json::parse_json(message.rawData(), [this, &received_at](JsonObject root) -> bool {
+    int64_t sent_at = root["sentAt"].isNull() ? 0 : root["sentAt"].as<int64_t>();
+    // Until SNTP syncs, the server's clock sets ours, so the first heartbeat
+    // or schedule is enough to draw departures. Only a server that stamps its
+    // messages with sentAt makes this possible; without it, SNTP sets the clock.
+    if (sent_at > 0 && this->connection_manager_->get_server_clock()->offer(
+                           sent_at, this->ping_rtt_ > 0 ? this->ping_rtt_ / 2 : 0, "the transit server")) {
+      // received_at was read off the clock as it was; the skew starts over on the next message
+      received_at = 0;
+      this->has_clock_skew_ = false;
+    }
+    if (sent_at > 0 && received_at > 0) {
+      this->update_clock_skew_(sent_at, received_at);
+    }
+
     if (root["event"].as<std::string>() == "heartbeat") {
       ESP_LOGD(TAG, "Received heartbeat");
       this->last_heartbeat_ = millis();
@@ -107,7 +199,14 @@ void TransitTracker::on_ws_message_(websockets::WebsocketsMessage message) {
 
     this->schedule_state_.mutex.lock();
 
-    this->schedule_state_.trips.clear();
+    // With a trip window the server's list is the window, and the trips shown are picked from it below
+    TripList &trips = this->schedule_state_.trips;
+    TripWindow &window = this->schedule_state_.window;
+    if (this->trip_window_ > 0) {
+      window.clear();
+    } else {
+      trips.clear();
+    }
 
     auto data = root["data"].as<JsonObject>();
 
@@ -134,18 +233,46 @@ void TransitTracker::on_ws_message_(websockets::WebsocketsMessage message) {
         route_color = Color(std::stoul(trip["routeColor"].as<std::string>(), nullptr, 16));
       }
 
-      this->schedule_state_.trips.push_back({
-        .route_id = route_id,
-        .route_name = route_name,
-        .route_color = route_color,
-        .headsign = headsign,
-        .arrival_time = trip["arrivalTime"].as<time_t>(),
-        .departure_time = trip["departureTime"].as<time_t>(),
-        .is_realtime = trip["isRealtime"].as<bool>(),
-      });
+      Trip parsed{
+          .route_id = route_id,
+          .route_name = route_name,
+          .route_color = route_color,
+          .headsign = headsign,
+          .arrival_time = trip["arrivalTime"].as<time_t>(),
+          .departure_time = trip["departureTime"].as<time_t>(),
+          .is_realtime = trip["isRealtime"].as<bool>(),
+      };
+      if (this->trip_window_ > 0) {
+        window.push_back(std::move(parsed));
+      } else {
+        trips.push_back(std::move(parsed));
+      }
     }
 
+    // A list as long as asked for was cut off there; a shorter one is all the server has
+    this->window_cut_off_ = (int) window.size() >= this->subscribed_limit_;
+    TRACE_COUNTER("trips", this->trip_window_ > 0 ? window.size() : trips.size());
     this->schedule_state_.mutex.unlock();
+    this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_FIRST_DATA);
+
+    if (this->trip_window_ > 0) {
+      this->view_changed_ = true;
+      this->update_view_();
+    }
+
+    if (sent_at > 0 && received_at > 0) {
+      // Server send time expressed on the local clock, using the smoothed skew
+      int64_t latency = wall_clock_ms() - (sent_at - static_cast<int64_t>(this->clock_skew_ms_));
+      ESP_LOGD(TAG, "Schedule is %ldms old after parsing", static_cast<long>(latency));
+#ifdef USE_SENSOR
+      if (this->server_latency_sensor_ != nullptr) {
+        this->server_latency_sensor_->publish_state(latency);
+      }
+#endif
+    }
+
+    this->render_pending_since_ = millis();
+    this->request_frame_();
 
     return true;
   });
@@ -159,6 +286,7 @@ void TransitTracker::on_ws_message_(websockets::WebsocketsMessage message) {
 void TransitTracker::on_ws_event_(websockets::WebsocketsEvent event, String data) {
   if (event == websockets::WebsocketsEvent::ConnectionOpened) {
     ESP_LOGD(TAG, "WebSocket connection opened");
+    this->ping_sent_at_ = 0;
 
     auto message = json::build_json([this](JsonObject root) {
       root["event"] = "schedule:subscribe";
@@ -170,16 +298,22 @@ void TransitTracker::on_ws_event_(websockets::WebsocketsEvent event, String data
       }
 
       data["routeStopPairs"] = this->schedule_string_;
-      data["limit"] = this->limit_;
+      // With a trip window, a superset of the list shown, which is picked from it on the
+      // device: in nextPerRoute, the next trip of every route up to the window, so a route
+      // that runs rarely isn't crowded out by frequent ones
+      data["limit"] = this->trip_window_ > 0 ? std::max(this->trip_window_, this->limit_) : this->limit_;
       data["sortByDeparture"] = this->display_departure_times_;
       data["listMode"] = this->list_mode_;
     });
+    this->subscribed_limit_ = this->trip_window_ > 0 ? std::max(this->trip_window_, this->limit_) : this->limit_;
+    this->subscribed_per_route_ = this->list_mode_ == "nextPerRoute";
 
     ESP_LOGV(TAG, "Sending message: %s", message.c_str());
     this->ws_client_.send(message.c_str());
+    this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_SUBSCRIBED);
   } else if (event == websockets::WebsocketsEvent::ConnectionClosed) {
     ESP_LOGD(TAG, "WebSocket connection closed");
-    if (!this->fully_closed_ && this->connection_attempts_ == 0) {
+    if (!this->fully_closed_ && this->backoff_.get_attempts() == 0) {
       this->defer([this]() {
         this->connect_ws_();
       });
@@ -188,7 +322,92 @@ void TransitTracker::on_ws_event_(websockets::WebsocketsEvent event, String data
     ESP_LOGV(TAG, "Received ping");
   } else if (event == websockets::WebsocketsEvent::GotPong) {
     ESP_LOGV(TAG, "Received pong");
+
+    if (this->ping_sent_at_ != 0) {
+      this->ping_rtt_ = millis() - this->ping_sent_at_;
+      this->ping_sent_at_ = 0;
+      ESP_LOGD(TAG, "WebSocket ping RTT: %ldms", this->ping_rtt_);
+#ifdef USE_SENSOR
+      if (this->ping_rtt_sensor_ != nullptr) {
+        this->ping_rtt_sensor_->publish_state(this->ping_rtt_);
+      }
+#endif
+    }
+  }
+}
+
+void TransitTracker::update_clock_skew_(int64_t sent_at, int64_t received_at) {
+  // Assume the message spent half a round trip in flight; without an RTT yet, assume none
+  int64_t one_way = this->ping_rtt_ > 0 ? this->ping_rtt_ / 2 : 0;
+  float sample = static_cast<float>(sent_at + one_way - received_at);
+
+  if (!this->has_clock_skew_) {
+    this->clock_skew_ms_ = sample;
+    this->has_clock_skew_ = true;
+  } else {
+    this->clock_skew_ms_ += (sample - this->clock_skew_ms_) / 8.0f;
+  }
+
+  long clock_skew = lroundf(this->clock_skew_ms_ / 1000.0f);
+  if (clock_skew != this->localization_.get_clock_skew()) {
+    ESP_LOGI(TAG, "Server clock is %ldms ahead of local clock, adjusting countdowns by %lds",
+             static_cast<long>(this->clock_skew_ms_), clock_skew);
+    this->localization_.set_clock_skew(clock_skew);
+    this->request_frame_();
+  }
+
+#ifdef USE_SENSOR
+  if (this->clock_skew_sensor_ != nullptr) {
+    this->clock_skew_sensor_->publish_state(this->clock_skew_ms_);
   }
+#endif
+}
+
+void TransitTracker::update_view_() {
+  // Server time, so a trip leaves the list as the server would drop it
+  time_t now = 0;
+  if (this->rtc_->now().is_valid()) {
+    now = this->rtc_->now().timestamp + this->localization_.get_clock_skew();
+  }
+
+  this->schedule_state_.mutex.lock();
+
+  if (this->view_changed_) {
+    sort_window(this->schedule_state_.window, this->display_departure_times_);
+  }
+  this->view_expires_at_ = build_view(this->schedule_state_.window, this->schedule_state_.trips, this->limit_,
+                                      this->list_mode_ == "nextPerRoute", now);
+
+  ESP_LOGV(TAG, "Showing %u of %u trips in the window", (unsigned) this->schedule_state_.trips.size(),
+           (unsigned) this->schedule_state_.window.size());
+  this->schedule_state_.mutex.unlock();
+
+  this->view_changed_ = false;
+  this->request_frame_();
+}
+
+bool TransitTracker::window_short_() {
+  if (this->limit_ > this->subscribed_limit_) {
+    return true;
+  }
+  this->schedule_state_.mutex.lock();
+  bool short_view = (int) this->schedule_state_.trips.size() < this->limit_;
+  this->schedule_state_.mutex.unlock();
+  // A window of one trip per route can't fill a sequential list
+  return short_view && (this->window_cut_off_ || (this->subscribed_per_route_ && this->list_mode_ != "nextPerRoute"));
+}
+
+void TransitTracker::setup_ws_client_() {
+  this->ws_client_ = connection_manager::make_websocket_client(this->connection_manager_, this->base_url_);
+  this->ws_client_url_ = this->base_url_;
+
+  this->ws_client_.onMessage([this](websockets::WebsocketsMessage message) {
+    this->on_ws_message_(message);
+  });
+
+  this->ws_client_.onEvent([this](websockets::WebsocketsEvent event, String data) {
+    this->on_ws_event_(event, data);
+  });
 }
 
 void TransitTracker::connect_ws_() {
@@ -207,42 +426,59 @@ void TransitTracker::connect_ws_() {
     return;
   }
 
+  if (!this->connection_manager_->is_network_ready()) {
+    // Not a failed attempt: the network-ready callback connects
+    ESP_LOGD(TAG, "Network not ready, connecting once it is");
+    return;
+  }
+
+  // The base URL can change at runtime, and a wss:// one needs a client whose
+  // connections resume TLS sessions
+  if (this->ws_client_url_ != this->base_url_) {
+    this->setup_ws_client_();
+  }
+
+  // Another component's TLS handshake is under way; this one waits its turn
+  auto handshake = this->connection_manager_->try_acquire_handshake();
+  if (!handshake.owns_lock()) {
+    this->set_timeout("reconnect", connection_manager::ConnectionManager::HANDSHAKE_RETRY_INTERVAL, [this]() {
+      this->connect_ws_();
+    });
+    return;
+  }
+
   watchdog::WatchdogManager wdm(20000);
+  TRACE_SCOPE("ws connect");
 
   this->last_heartbeat_ = 0;
 
-  ESP_LOGD(TAG, "Connecting to WebSocket server (attempt %d): %s", this->connection_attempts_, this->base_url_.c_str());
+  ESP_LOGD(TAG, "Connecting to WebSocket server (attempt %d): %s", this->backoff_.get_attempts(), this->base_url_.c_str());
 
-  bool connection_success = false;
-  if (esphome::network::is_connected()) {
-    connection_success = this->ws_client_.connect(this->base_url_.c_str());
-  } else {
-    ESP_LOGW(TAG, "Not connected to network; skipping connection attempt");
-  }
+  bool connection_success = connection_manager::connect_websocket(this->ws_client_, this->base_url_);
 
   if (!connection_success) {
-    this->connection_attempts_++;
+    uint32_t timeout = this->backoff_.next_delay();
 
-    if (this->connection_attempts_ >= 3) {
+    if (this->backoff_.get_attempts() >= 3) {
       this->status_set_error("Failed to connect to WebSocket server");
     }
 
-    if (this->connection_attempts_ >= 15) {
+    if (this->backoff_.get_attempts() >= 15) {
       ESP_LOGE(TAG, "Could not connect to WebSocket server within 15 attempts.");
       ESP_LOGE(TAG, "It's likely that the network is not truly connected; rebooting the device to try to recover.");
       App.reboot();
     }
 
-    auto timeout = std::min(15000, this->connection_attempts_ * 5000);
-    ESP_LOGW(TAG, "Failed to connect, retrying in %ds", timeout / 1000);
+    ESP_LOGW(TAG, "Failed to connect, retrying in %.1fs", timeout / 1000.0f);
 
     this->set_timeout("reconnect", timeout, [this]() {
       this->connect_ws_();
     });
   } else {
     this->has_ever_connected_ = true;
-    this->connection_attempts_ = 0;
+    this->backoff_.reset();
     this->status_clear_error();
+    this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_CONNECTED);
   }
 }
 
@@ -293,7 +529,29 @@ const uint8_t realtime_icon[6][6] = {
   {3, 0, 2, 0, 1, 1}
 };
 
-void HOT TransitTracker::draw_realtime_icon_(int bottom_right_x, int bottom_right_y, unsigned long uptime) {
+// Each icon row goes out as a span; segment 0 is left uncovered so the background
+// shows through. Kept out of draw_realtime_icon_() so the SpanBuffer is only on the
+// stack for displays that copy rows.
+template<typename IsLit>
+static void __attribute__((noinline)) draw_realtime_icon_spans(display::Display &it, int left_x, int top_y,
+                                                               IsLit is_segment_lit, uint16_t lit_color,
+                                                               uint16_t unlit_color) {
+  matrix_render::SpanBuffer span;
+  for (uint8_t i = 0; i < 6; ++i) {
+    span.begin(left_x, 6);
+    for (uint8_t j = 0; j < 6; ++j) {
+      uint8_t segment_number = realtime_icon[i][j];
+      if (segment_number == 0) {
+        continue;
+      }
+
+      span.set_rgb565(left_x + j, is_segment_lit(segment_number) ? lit_color : unlit_color);
+    }
+    span.flush(&it, top_y + i);
+  }
+}
+
+void HOT TransitTracker::draw_realtime_icon_(display::Display &it, int bottom_right_x, int bottom_right_y, unsigned long uptime) {
   const int num_frames = 6;
   const int idle_frame_duration = 3000;
   const int anim_frame_duration = 200;
@@ -304,8 +562,10 @@ void HOT TransitTracker::draw_realtime_icon_(int bottom_right_x, int bottom_righ
   int frame;
   if (cycle_time < idle_frame_duration) {
     frame = 0;
+    this->schedule_frame_(uptime + (idle_frame_duration - cycle_time));
   } else {
     frame = 1 + (cycle_time - idle_frame_duration) / anim_frame_duration;
+    this->schedule_frame_(uptime + (anim_frame_duration - (cycle_time - idle_frame_duration) % anim_frame_duration));
   }
 
   auto is_segment_lit = [frame](uint8_t segment) {
@@ -320,6 +580,13 @@ void HOT TransitTracker::draw_realtime_icon_(int bottom_right_x, int bottom_righ
   const Color lit_color = Color(0x20FF00);
   const Color unlit_color = Color(0x00A700);
 
+  if (matrix_render::copies_rows(&it)) {
+    draw_realtime_icon_spans(it, bottom_right_x - 5, bottom_right_y - 5, is_segment_lit,
+                             matrix_render::SpanBuffer::to_rgb565(lit_color),
+                             matrix_render::SpanBuffer::to_rgb565(unlit_color));
+    return;
+  }
+
   for (uint8_t i = 0; i < 6; ++i) {
     for (uint8_t j = 0; j < 6; ++j) {
       uint8_t segment_number = realtime_icon[i][j];
@@ -328,53 +595,58 @@ void HOT TransitTracker::draw_realtime_icon_(int bottom_right_x, int bottom_righ
       }
 
       Color icon_color = is_segment_lit(segment_number) ? lit_color : unlit_color;
-      this->display_->draw_pixel_at(bottom_right_x - (5 - j), bottom_right_y - (5 - i), icon_color);
+      it.draw_pixel_at(bottom_right_x - (5 - j), bottom_right_y - (5 - i), icon_color);
     }
   }
 }
 
 void TransitTracker::draw_trip(
-    const Trip &trip, int y_offset, int font_height, unsigned long uptime, uint rtc_now,
-    bool no_draw, int *headsign_overflow_out, int scroll_cycle_duration
+    display::Display &it, const Trip &trip, int y_offset, int font_height, unsigned long uptime, uint rtc_now,
+    bool no_draw, int *headsign_overflow_out, int scroll_cycle_duration, unsigned long scroll_started_at
 ) {
     if (!no_draw) {
-      this->display_->print(0, y_offset, this->font_, trip.route_color, display::TextAlign::TOP_LEFT, trip.route_name.c_str());
+      it.print(0, y_offset, this->font_, trip.route_color, display::TextAlign::TOP_LEFT, trip.route_name.c_str());
     }
 
-    int route_width, _;
-    this->font_->measure(trip.route_name.c_str(), &route_width, &_, &_, &_);
+    int route_width = this->font_metrics_.width(trip.route_name);
 
     auto time_display = this->localization_.fmt_duration_from_now(
       this->display_departure_times_ ? trip.departure_time : trip.arrival_time,
       rtc_now
     );
 
-    int time_width;
-    this->font_->measure(time_display.c_str(), &time_width, &_, &_, &_);
+    int time_width = this->font_metrics_.width(time_display);
 
     int headsign_clipping_start = route_width + 3;
-    int headsign_clipping_end = this->display_->get_width() - time_width - 2;
+    int headsign_clipping_end = it.get_width() - time_width - 2;
 
     if (!no_draw) {
       Color time_color = trip.is_realtime ? Color(0x20FF00) : Color(0xa7a7a7);
-      this->display_->print(this->display_->get_width() + 1, y_offset, this->font_, time_color, display::TextAlign::TOP_RIGHT, time_display.c_str());
+      it.print(it.get_width() + 1, y_offset, this->font_, time_color, display::TextAlign::TOP_RIGHT, time_display.c_str());
+
+      long seconds_until_change = this->localization_.seconds_until_change(
+        this->display_departure_times_ ? trip.departure_time : trip.arrival_time,
+        rtc_now
+      );
+      if (seconds_until_change > 0) {
+        this->schedule_frame_(uptime + seconds_until_change * 1000);
+      }
     }
 
     if (trip.is_realtime) {
       headsign_clipping_end -= 8;
 
       if(!no_draw) {
-        int icon_bottom_right_x = this->display_->get_width() - time_width - 2;
+        int icon_bottom_right_x = it.get_width() - time_width - 2;
         int icon_bottom_right_y = y_offset + font_height - 6;
 
-        this->draw_realtime_icon_(icon_bottom_right_x, icon_bottom_right_y, uptime);
+        this->draw_realtime_icon_(it, icon_bottom_right_x, icon_bottom_right_y, uptime);
       }
     }
 
     int headsign_max_width = headsign_clipping_end - headsign_clipping_start;
 
-    int headsign_actual_width;
-    this->font_->measure(trip.headsign.c_str(), &headsign_actual_width, &_, &_, &_);
+    int headsign_actual_width = this->font_metrics_.width(trip.headsign);
 
     int headsign_overflow = headsign_actual_width - headsign_max_width;
     if (headsign_overflow_out) {
@@ -387,28 +659,56 @@ void TransitTracker::draw_trip(
 
     int scroll_offset = 0;
     if (headsign_overflow > 0 && scroll_cycle_duration > 0) {
+      const int scroll_step_time = 1000 / scroll_speed;
       int scroll_time = headsign_overflow * 1000 / scroll_speed;
-      int scroll_cycle_time = uptime % scroll_cycle_duration;
+      int scroll_cycle_time = (uptime - scroll_started_at) % scroll_cycle_duration;
 
       if(scroll_cycle_time < idle_time_left) {
+        this->schedule_frame_(uptime + (idle_time_left - scroll_cycle_time));
       } else if (scroll_cycle_time < idle_time_left + scroll_time) {
         int time_since_scroll_start = scroll_cycle_time - idle_time_left;
         scroll_offset = time_since_scroll_start * scroll_speed / 1000;
+        this->schedule_frame_(uptime + (scroll_step_time - time_since_scroll_start % scroll_step_time));
       } else if (scroll_cycle_time < idle_time_left + scroll_time + idle_time_right) {
         scroll_offset = headsign_overflow;
+        this->schedule_frame_(uptime + (idle_time_left + scroll_time + idle_time_right - scroll_cycle_time));
       } else if (scroll_cycle_time < idle_time_left + 2 * scroll_time + idle_time_right){
         int time_since_scroll_start = scroll_cycle_time - (idle_time_left + scroll_time + idle_time_right);
         scroll_offset = headsign_overflow - (time_since_scroll_start * scroll_speed / 1000);
+        this->schedule_frame_(uptime + (scroll_step_time - time_since_scroll_start % scroll_step_time));
       } else {
+        this->schedule_frame_(uptime + (scroll_cycle_duration - scroll_cycle_time));
       }
     }
 
-    this->display_->start_clipping(headsign_clipping_start, 0, headsign_clipping_end, this->display_->get_height());
-    this->display_->print(headsign_clipping_start - scroll_offset, y_offset, this->font_, trip.headsign.c_str());
-    this->display_->end_clipping();
+    it.start_clipping(headsign_clipping_start, 0, headsign_clipping_end, it.get_height());
+    it.print(headsign_clipping_start - scroll_offset, y_offset, this->font_, trip.headsign.c_str());
+    it.end_clipping();
+}
+
+void TransitTracker::schedule_frame_(unsigned long at) {
+  // Bands may be rasterized concurrently, so keep the earliest deadline without locking
+  uint32_t current = this->next_frame_at_.load();
+  while (static_cast<int32_t>(at - current) < 0 && !this->next_frame_at_.compare_exchange_weak(current, at)) {
+  }
+}
+
+void TransitTracker::draw_schedule(display::Display &it) {
+  // Drawing only happens on the main loop, so the target can be swapped for the call
+  display::Display *display = this->display_;
+  this->display_ = &it;
+  this->draw_schedule();
+  this->display_ = display;
 }
 
 void HOT TransitTracker::draw_schedule() {
+  TRACE_SCOPE("render");
+  ALLOC_SCOPE("draw_schedule");
+  unsigned long uptime = millis();
+
+  // Status screens below are static; state changes are picked up by the scheduler's idle refresh
+  this->next_frame_at_ = uptime + idle_frame_interval;
+
   if (this->display_ == nullptr) {
     ESP_LOGW(TAG, "No display attached, cannot draw schedule");
     return;
@@ -449,33 +749,164 @@ void HOT TransitTracker::draw_schedule() {
     return;
   }
 
+  this->connection_manager_->get_boot_timeline()->mark(connection_manager::BOOT_FIRST_CONTENT);
   this->schedule_state_.mutex.lock();
 
   int nominal_font_height = this->font_->get_ascender() + this->font_->get_descender();
-  unsigned long uptime = millis();
   uint rtc_now = this->rtc_->now().timestamp;
 
-  int scroll_cycle_duration = 0;
-  if (this->scroll_headsigns_) {
+  const int num_trips = this->schedule_state_.trips.size();
+  const int display_height = this->display_->get_height();
+
+  int rows_that_fit = std::max(1, (display_height + this->font_->get_descender()) / nominal_font_height);
+  int page_rows = std::max(1, std::min(std::min(this->limit_, rows_that_fit), max_page_rows));
+  int page_count = (num_trips + page_rows - 1) / page_rows;
+
+  int max_trips_height = (page_rows * this->font_->get_ascender()) + ((page_rows - 1) * this->font_->get_descender());
+  int list_top = (display_height % max_trips_height) / 2;
+  int list_bottom = std::min(display_height, list_top + page_rows * nominal_font_height);
+
+  // One headsign scroll cycle of a page: long enough for its longest headsign
+  // to scroll out and back, 0 if every headsign fits
+  auto page_scroll_cycle = [&](int page) {
+    if (!this->scroll_headsigns_) {
+      return 0;
+    }
     int largest_headsign_overflow = 0;
-    for (const Trip &trip : this->schedule_state_.trips) {
+    for (int trip_index = page * page_rows; trip_index < std::min(num_trips, (page + 1) * page_rows); trip_index++) {
       int headsign_overflow;
-      this->draw_trip(trip, 0, nominal_font_height, uptime, rtc_now, true, &headsign_overflow);
+      this->draw_trip(*this->display_, this->schedule_state_.trips[trip_index], 0, nominal_font_height, uptime, rtc_now,
+                      true, &headsign_overflow);
       largest_headsign_overflow = max(largest_headsign_overflow, headsign_overflow);
     }
+    if (largest_headsign_overflow <= 0) {
+      return 0;
+    }
+    int longest_scroll_time = largest_headsign_overflow * 1000 / scroll_speed;
+    return idle_time_left + idle_time_right + 2 * longest_scroll_time;
+  };
+  // Whole scroll cycles only, so a page never leaves mid-scroll
+  auto page_dwell = [&](int scroll_cycle_duration) -> unsigned long {
+    if (scroll_cycle_duration <= 0) {
+      return this->page_dwell_time_;
+    }
+    unsigned long cycles = (this->page_dwell_time_ + scroll_cycle_duration - 1) / scroll_cycle_duration;
+    return std::max<unsigned long>(1, cycles) * scroll_cycle_duration;
+  };
+
+  // Pick the page to show, and how far it has slid towards the next one. The
+  // scroll phase runs from when the page appeared, so every page starts with
+  // its headsigns at rest.
+  if (page_count <= 1 && this->page_index_ != 0) {
+    this->page_index_ = 0;
+    this->page_started_at_ = uptime;
+  } else if (this->page_index_ >= page_count) {
+    this->page_index_ = 0;
+    this->page_started_at_ = uptime;
+  }
+  int scroll_cycle_duration = page_scroll_cycle(this->page_index_);
+  this->current_page_dwell_ = page_dwell(scroll_cycle_duration);
+
+  int slide_offset = 0;
+  if (page_count > 1) {
+    int page_height = page_rows * nominal_font_height;
+    int transition_time = this->page_transition_ ? page_height * 1000 / page_scroll_speed : 0;
+
+    unsigned long page_time = uptime - this->page_started_at_;
+    if (page_time >= this->current_page_dwell_ + transition_time) {
+      this->page_index_ = (this->page_index_ + 1) % page_count;
+      this->page_started_at_ = uptime;
+      page_time = 0;
+      scroll_cycle_duration = page_scroll_cycle(this->page_index_);
+      this->current_page_dwell_ = page_dwell(scroll_cycle_duration);
+    }
+
+    if (page_time < this->current_page_dwell_) {
+      this->schedule_frame_(this->page_started_at_ + this->current_page_dwell_);
+    } else {
+      const int slide_step_time = 1000 / page_scroll_speed;
+      int time_since_slide_start = page_time - this->current_page_dwell_;
+      slide_offset = std::min(page_height, time_since_slide_start * page_scroll_speed / 1000);
+      this->schedule_frame_(uptime + (slide_step_time - time_since_slide_start % slide_step_time));
+    }
+  }
+
+  // Cull to the rows that intersect the list area; only these are measured or drawn
+  int visible_trips[2 * max_page_rows];
+  int visible_y[2 * max_page_rows];
+  int num_visible = 0;
+
+  int first_trip = this->page_index_ * page_rows;
+  int next_first_trip = ((this->page_index_ + 1) % std::max(1, page_count)) * page_rows;
+  int num_rows = slide_offset > 0 ? 2 * page_rows : page_rows;
+
+  for (int row = 0; row < num_rows; row++) {
+    int trip_index = row < page_rows ? first_trip + row : next_first_trip + (row - page_rows);
+    if (trip_index >= num_trips) {
+      continue;
+    }
 
-    if (largest_headsign_overflow > 0) {
-      int longest_scroll_time = largest_headsign_overflow * 1000 / scroll_speed;
-      scroll_cycle_duration = idle_time_left + idle_time_right + 2*longest_scroll_time;
+    int y_offset = list_top + row * nominal_font_height - slide_offset;
+    if (y_offset + nominal_font_height <= list_top || y_offset >= list_bottom) {
+      continue;
     }
+
+    visible_trips[num_visible] = trip_index;
+    visible_y[num_visible] = y_offset;
+    num_visible++;
   }
 
-  int max_trips_height = (this->limit_ * this->font_->get_ascender()) + ((this->limit_ - 1) * this->font_->get_descender());
-  int y_offset = (this->display_->get_height() % max_trips_height) / 2;
+  auto draw_rows = [&](display::Display &it) {
+    // When rendering a band, the band is the clipping rectangle; skip rows outside it
+    int band_top = 0, band_bottom = it.get_height();
+    if (it.is_clipping()) {
+      display::Rect band = it.get_clipping();
+      band_top = band.y;
+      band_bottom = band.y2();
+    }
+
+    if (slide_offset > 0) {
+      it.start_clipping(0, list_top, it.get_width(), list_bottom);
+    } else if (page_count > 1) {
+      // ESPHome's clipping stack is a vector that grows the first time it gets
+      // deeper. A slide nests the headsign clip inside the list clip, so that
+      // depth is reached on the first frame rather than the first slide.
+      it.start_clipping(0, list_top, it.get_width(), list_bottom);
+      it.start_clipping(0, list_top, it.get_width(), list_bottom);
+      it.end_clipping();
+      it.end_clipping();
+    }
+
+    for (int i = 0; i < num_visible; i++) {
+      if (visible_y[i] + nominal_font_height <= band_top || visible_y[i] >= band_bottom) {
+        continue;
+      }
 
-  for (const Trip &trip : this->schedule_state_.trips) {
-    this->draw_trip(trip, y_offset, nominal_font_height, uptime, rtc_now, false, nullptr, scroll_cycle_duration);
-    y_offset += nominal_font_height;
+      this->draw_trip(it, this->schedule_state_.trips[visible_trips[i]], visible_y[i], nominal_font_height, uptime,
+                      rtc_now, false, nullptr, scroll_cycle_duration, this->page_started_at_);
+    }
+
+    if (slide_offset > 0) {
+      it.end_clipping();
+    }
+  };
+
+  if (this->band_renderer_ != nullptr) {
+    // Only the list area is flipped, so anything drawn around it is kept
+    this->band_renderer_->render(this->display_, draw_rows, list_top, list_bottom);
+  } else {
+    draw_rows(*this->display_);
+  }
+
+  if (this->render_pending_since_ != 0) {
+    unsigned long render_latency = millis() - this->render_pending_since_;
+    this->render_pending_since_ = 0;
+    ESP_LOGV(TAG, "Schedule drawn %lums after parsing", render_latency);
+#ifdef USE_SENSOR
+    if (this->render_latency_sensor_ != nullptr) {
+      this->render_latency_sensor_->publish_state(render_latency);
+    }
+#endif
   }
 
   this->schedule_state_.mutex.unlock();
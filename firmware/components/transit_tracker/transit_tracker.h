@@ -1,12 +1,23 @@
 #pragma once
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <ArduinoWebsockets.h>
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/components/display/display.h"
 #include "esphome/components/font/font.h"
 #include "esphome/components/time/real_time_clock.h"
+#include "esphome/components/connection_manager/connection_manager.h"
+#include "esphome/components/connection_manager/websocket_transport.h"
+#include "esphome/components/matrix_render/banded_renderer.h"
+#include "esphome/components/matrix_render/text_metrics.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
 
 #include "schedule_state.h"
 #include "localization.h"
@@ -32,20 +43,47 @@ class TransitTracker : public Component {
     void close(bool fully = false);
 
     void draw_schedule();
+    // Draws into it instead, e.g. a display_compositor zone, laid out for its size
+    void draw_schedule(display::Display &it);
+
+    // millis() instant at which the output of draw_schedule() next changes
+    uint32_t get_next_frame_at() const { return next_frame_at_.load(); }
 
     Localization* get_localization() { return &this->localization_; }
 
     void set_display(display::Display *display) { display_ = display; }
     void set_font(font::Font *font) { font_ = font; }
     void set_rtc(time::RealTimeClock *rtc) { rtc_ = rtc; }
+    void set_connection_manager(connection_manager::ConnectionManager *connection_manager) {
+      connection_manager_ = connection_manager;
+    }
 
     void set_base_url(const std::string &base_url) { base_url_ = base_url; }
     void set_feed_code(const std::string &feed_code) { feed_code_ = feed_code; }
-    void set_display_departure_times(bool display_departure_times) { display_departure_times_ = display_departure_times; }
+    // The subscription asks for these. With a trip window, changing one
+    // rebuilds the view from the window at the next loop(), and only
+    // resubscribes if the window can't fill it; without one, it resubscribes.
+    void set_display_departure_times(bool display_departure_times) {
+      settings_changed_ |= display_departure_times != display_departure_times_;
+      display_departure_times_ = display_departure_times;
+      view_changed_ = true;
+    }
     void set_schedule_string(const std::string &schedule_string) { schedule_string_ = schedule_string; }
-    void set_list_mode(const std::string &list_mode) { list_mode_ = list_mode; }
-    void set_limit(int limit) { limit_ = limit; }
+    void set_list_mode(const std::string &list_mode) {
+      settings_changed_ |= list_mode != list_mode_;
+      list_mode_ = list_mode;
+      view_changed_ = true;
+    }
+    void set_limit(int limit) {
+      settings_changed_ |= limit != limit_;
+      limit_ = limit;
+      view_changed_ = true;
+    }
+    void set_trip_window(int trip_window) { trip_window_ = trip_window; }
     void set_scroll_headsigns(bool scroll_headsigns) { scroll_headsigns_ = scroll_headsigns; }
+    void set_page_dwell_time(uint32_t page_dwell_time) { page_dwell_time_ = page_dwell_time; }
+    void set_page_transition(bool page_transition) { page_transition_ = page_transition; }
+    void set_render_bands(int render_bands) { render_bands_ = render_bands; }
 
     void set_unit_display(UnitDisplay unit_display) { this->localization_.set_unit_display(unit_display); }
     void add_abbreviation(const std::string &from, const std::string &to) { abbreviations_[from] = to; }
@@ -55,34 +93,67 @@ class TransitTracker : public Component {
     void set_abbreviations_from_text(const std::string &text);
     void set_route_styles_from_text(const std::string &text);
 
+#ifdef USE_SENSOR
+    void set_server_latency_sensor(sensor::Sensor *sensor) { server_latency_sensor_ = sensor; }
+    void set_render_latency_sensor(sensor::Sensor *sensor) { render_latency_sensor_ = sensor; }
+    void set_ping_rtt_sensor(sensor::Sensor *sensor) { ping_rtt_sensor_ = sensor; }
+    void set_clock_skew_sensor(sensor::Sensor *sensor) { clock_skew_sensor_ = sensor; }
+#endif
+
   protected:
     static constexpr int scroll_speed = 10; // pixels/second
     static constexpr int idle_time_left = 5000;
     static constexpr int idle_time_right = 1000;
+    static constexpr int idle_frame_interval = 60000;
+    static constexpr int page_scroll_speed = 30; // pixels/second
+    static constexpr int max_page_rows = 16;
+    static constexpr int ping_interval = 15000;
 
     std::string from_now_(time_t unix_timestamp, uint rtc_now) const;
     void draw_text_centered_(const char *text, Color color);
-    void draw_realtime_icon_(int bottom_right_x, int bottom_right_y, unsigned long now);
+    void draw_realtime_icon_(display::Display &it, int bottom_right_x, int bottom_right_y, unsigned long now);
+
+    void request_frame_() { this->next_frame_at_ = millis(); }
+
+    // Rebuilds schedule_state_.trips from the trip window
+    void update_view_();
+    // The view is short of limit_ trips and a new subscription could fill it
+    bool window_short_();
+    void schedule_frame_(unsigned long at);
 
     void draw_trip(
-      const Trip &trip, int y_offset, int font_height, unsigned long uptime, uint rtc_now,
-      bool no_draw = false, int *headsign_overflow_out = nullptr, int scroll_cycle_duration = 0
+      display::Display &it, const Trip &trip, int y_offset, int font_height, unsigned long uptime, uint rtc_now,
+      bool no_draw = false, int *headsign_overflow_out = nullptr, int scroll_cycle_duration = 0,
+      unsigned long scroll_started_at = 0
     );
 
     Localization localization_{};
     ScheduleState schedule_state_;
+    std::atomic<uint32_t> next_frame_at_{0};
 
     display::Display *display_;
     font::Font *font_;
+    matrix_render::TextMetrics font_metrics_;
     time::RealTimeClock *rtc_;
+    connection_manager::ConnectionManager *connection_manager_;
 
     websockets::WebsocketsClient ws_client_{};
+    std::string ws_client_url_;  // The URL ws_client_ was made for
 
     void on_ws_message_(websockets::WebsocketsMessage message);
     void on_ws_event_(websockets::WebsocketsEvent event, String data);
+    void setup_ws_client_();
     void connect_ws_();
-    int connection_attempts_ = 0;
+    connection_manager::Backoff backoff_;
     unsigned long last_heartbeat_ = 0;
+
+    // Freshness telemetry, driven by the optional "sentAt" (epoch ms) on server messages
+    void update_clock_skew_(int64_t sent_at, int64_t received_at);
+    unsigned long ping_sent_at_ = 0;
+    long ping_rtt_ = -1;
+    float clock_skew_ms_ = 0.0f;
+    bool has_clock_skew_ = false;
+    unsigned long render_pending_since_ = 0;
     bool has_ever_connected_ = false;
     bool fully_closed_ = false;
 
@@ -91,12 +162,41 @@ class TransitTracker : public Component {
     std::string schedule_string_;
     std::string list_mode_;
     bool display_departure_times_ = true;
-    int limit_;
+    int limit_ = 0;
+
+    // Subscribe to this many trips (or, for nextPerRoute, the next trip of this
+    // many routes) and pick the ones shown on the device; 0 leaves the list to
+    // the server
+    int trip_window_ = 0;
+    bool settings_changed_ = false;
+    bool view_changed_ = false;
+    // What the current subscription asked for, and whether the server's list
+    // filled it, so there are more trips than the window holds
+    int subscribed_limit_ = 0;
+    bool subscribed_per_route_ = false;
+    bool window_cut_off_ = false;
+    time_t view_expires_at_ = 0;  // Server time at which a trip shown departs
 
     std::map<std::string, std::string> abbreviations_;
     Color default_route_color_ = Color(0x028e51);
     std::map<std::string, RouteStyle> route_styles_;
     bool scroll_headsigns_ = false;
+
+    uint32_t page_dwell_time_ = 5000;
+    bool page_transition_ = true;
+    int page_index_ = 0;
+    unsigned long page_started_at_ = 0;
+    unsigned long current_page_dwell_ = 5000;
+
+    int render_bands_ = 1;
+    std::unique_ptr<matrix_render::BandedRenderer> band_renderer_;
+
+#ifdef USE_SENSOR
+    sensor::Sensor *server_latency_sensor_{nullptr};
+    sensor::Sensor *render_latency_sensor_{nullptr};
+    sensor::Sensor *ping_rtt_sensor_{nullptr};
+    sensor::Sensor *clock_skew_sensor_{nullptr};
+#endif
 };
 
 
@@ -0,0 +1,50 @@
+#include "trip_view.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace esphome {
+namespace transit_tracker {
+
+void sort_window(TripWindow &window, bool by_departure) {
+  std::stable_sort(window.begin(), window.end(), [by_departure](const Trip &a, const Trip &b) {
+    return by_departure ? a.departure_time < b.departure_time : a.arrival_time < b.arrival_time;
+  });
+}
+
+time_t build_view(const TripWindow &window, TripList &view, size_t limit, bool next_per_route, time_t now) {
+  view.clear();
+  time_t expires_at = 0;
+
+  // A handful of routes at most, so a linear scan beats a set
+  std::vector<const std::string *> routes;
+
+  for (const auto &trip : window) {
+    if (view.size() >= limit) {
+      break;
+    }
+
+    if (trip.departure_time <= now) {
+      continue;
+    }
+
+    if (next_per_route) {
+      auto seen = std::find_if(routes.begin(), routes.end(),
+                               [&trip](const std::string *route_id) { return *route_id == trip.route_id; });
+      if (seen != routes.end()) {
+        continue;
+      }
+      routes.push_back(&trip.route_id);
+    }
+
+    view.push_back(trip);
+    if (expires_at == 0 || trip.departure_time < expires_at) {
+      expires_at = trip.departure_time;
+    }
+  }
+
+  return expires_at;
+}
+
+}  // namespace transit_tracker
+}  // namespace esphome
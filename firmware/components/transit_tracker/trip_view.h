@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <ctime>
+
+#include "schedule_state.h"
+
+namespace esphome {
+namespace transit_tracker {
+
+// Orders a window soonest first by the time shown. Stable, so trips due at
+// the same time keep the server's order.
+void sort_window(TripWindow &window, bool by_departure);
+
+// Fills view with the first `limit` trips of a sorted window that haven't
+// departed by now (server time), keeping only the first trip of each route
+// when next_per_route. Returns the instant the view next changes, the
+// earliest departure among the trips shown, or 0 if it won't.
+time_t build_view(const TripWindow &window, TripList &view, size_t limit, bool next_per_route, time_t now);
+
+}  // namespace transit_tracker
+}  // namespace esphome
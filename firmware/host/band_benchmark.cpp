@@ -0,0 +1,131 @@
+// Host benchmark for matrix_render::BandedRenderer, built and run by
+// `python run_host.py band_benchmark`.
+//
+// Draws a departure list (four rows of text drawn a pixel at a time, the way
+// ESPHome fonts are, each behind a route badge drawn in spans) straight onto
+// the panel, then through the band renderer with 1 to 4 bands, for 2 to 8
+// chained panels. The flip is timed on its own by rendering an empty frame.
+// Each is measured on a display that only implements draw_pixel_at(), like the
+// HUB75 driver, where the flip falls back to ESPHome's per-pixel
+// draw_pixels_at(), and on one that copies RGB565 rows. Checks the banded
+// frames match the direct ones, and that rendering only some rows leaves the
+// rest of the panel alone.
+//
+// The host has more cores than the ESP32-S3's two, so bands beyond two show
+// what the work would split into, not what the device gains.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "esphome/components/matrix_render/banded_renderer.h"
+#include "panels.h"
+
+using esphome::matrix_render::BandedRenderer;
+
+static constexpr int ROW_HEIGHT = 8;
+static constexpr int GLYPH_WIDTH = 6;
+
+// A lit pixel of a made-up 5x7 glyph, roughly as dense as the real font
+static bool glyph_lit(int glyph, int x, int y) {
+  uint32_t h = (glyph * 2654435761u) ^ (x * 40503u) ^ (y * 9973u);
+  return x < 5 && y < 7 && (h >> 7) % 5 < 2;
+}
+
+// Rows are culled against the band like TransitTracker::draw_schedule() does
+static void draw_departures(Display &it) {
+  int band_top = 0, band_bottom = it.get_height();
+  if (it.is_clipping()) {
+    esphome::display::Rect band = it.get_clipping();
+    band_top = band.y;
+    band_bottom = band.y2();
+  }
+
+  const int width = it.get_width();
+  const Color color(0xFF, 0xC0, 0x40);
+  for (int row = 0; row < HEIGHT / ROW_HEIGHT; row++) {
+    int y0 = row * ROW_HEIGHT;
+    if (y0 + ROW_HEIGHT <= band_top || y0 >= band_bottom) {
+      continue;
+    }
+
+    SpanBuffer badge;
+    for (int y = y0; y < y0 + ROW_HEIGHT - 1; y++) {
+      badge.begin(0, 14);
+      badge.fill_rgb565(y == y0 ? 1 : 0, y == y0 ? 13 : 14, 0x0439 + row * 0x1000);
+      badge.flush(&it, y);
+    }
+    for (int x0 = 16; x0 + GLYPH_WIDTH <= width; x0 += GLYPH_WIDTH) {
+      int glyph = row * 97 + x0;
+      for (int y = 0; y < ROW_HEIGHT; y++) {
+        for (int x = 0; x < GLYPH_WIDTH; x++) {
+          if (glyph_lit(glyph, x, y))
+            it.draw_pixel_at(x0 + x, y0 + y, color);
+        }
+      }
+    }
+  }
+}
+
+static void draw_nothing(Display &) {}
+
+template<typename F> static double us_per_frame(int frames, F &&frame) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; i++)
+    frame();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() / frames;
+}
+
+template<typename P> static bool measure(int width, int frames) {
+  const BandedRenderer::BandFunc draw = draw_departures;
+  const BandedRenderer::BandFunc empty = draw_nothing;
+
+  P direct(width);
+  double direct_us = us_per_frame(frames, [&] {
+    direct.clear();
+    draw_departures(direct);
+  });
+  printf("    direct                  %8.1f us\n", direct_us);
+
+  bool ok = true;
+  for (int bands = 1; bands <= 4; bands++) {
+    BandedRenderer renderer(bands);
+    P panel(width);
+    double flip_us = us_per_frame(frames, [&] { renderer.render(&panel, empty); });
+    double frame_us = us_per_frame(frames, [&] { renderer.render(&panel, draw); });
+    printf("    %d band%s                 %8.1f us, of which %6.1f us clearing and flipping\n", bands,
+           bands == 1 ? " " : "s", frame_us, flip_us);
+    ok &= panel.frame() == direct.frame();
+  }
+
+  // Everything but the first row of departures, over a panel already drawn on
+  BandedRenderer renderer(2);
+  P panel(width);
+  panel.fill(Color(0x20, 0x40, 0x80));
+  renderer.render(&panel, draw, ROW_HEIGHT, HEIGHT);
+  std::vector<uint16_t> expected = direct.frame();
+  std::fill_n(expected.begin(), ROW_HEIGHT * width, SpanBuffer::to_rgb565(Color(0x20, 0x40, 0x80)));
+  if (panel.frame() != expected) {
+    printf("    rendering rows %d to %d changed the rest of the panel\n", ROW_HEIGHT, HEIGHT);
+    ok = false;
+  }
+  return ok;
+}
+
+int main() {
+  bool ok = true;
+  for (int panels : {2, 4, 8}) {
+    int width = panels * 64;
+    const int frames = 4000 / panels;
+    printf("%d panels, %dx%d\n", panels, width, HEIGHT);
+    printf("  per-pixel driver (HUB75)\n");
+    ok &= measure<PerPixelPanel>(width, frames);
+    printf("  row-copy driver\n");
+    ok &= measure<RowCopyPanel>(width, frames);
+  }
+  if (!ok) {
+    printf("Banded frames differ from the ones drawn directly\n");
+  }
+  return ok ? 0 : 1;
+}
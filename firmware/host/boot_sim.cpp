@@ -0,0 +1,301 @@
+// Host simulation of the boot timeline, built and run by
+// `python run_host.py boot_sim`.
+//
+// Boots the real connection manager, with its ServerClock and BootTimeline,
+// on the simulated clock: the link comes up, the DNS prefetch thread's lookup
+// is answered by a resolver that takes as long as the scenario says, and SNTP
+// syncs the time source when it says. A client stands in for the transit
+// tracker: it connects once the network is ready, subscribes, offers the
+// first message's sentAt to the server clock if the server stamps one, and
+// draws once it has data and the clock is valid. Each scenario checks the
+// order the stages are reached in, that the lookup starts as soon as there is
+// an address rather than after SNTP, and that first content comes within
+// boot_check.py's default budget of DHCP.
+//
+// The system clock ServerClock sets is wrapped by the linker, so the host's
+// own clock is never touched.
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <lwip/netdb.h>
+
+#include "esphome/components/connection_manager/connection_manager.h"
+#include "esphome/components/network/util.h"
+
+using namespace esphome::connection_manager;
+using esphome::time::RealTimeClock;
+
+static constexpr int64_t NOW_MS = 1767268800000LL;  // 2026-01-01 12:00:00 UTC
+static constexpr uint32_t TICK = 10;
+static constexpr uint32_t RUN_TIME = 15000;
+// boot_check.py's default --budget, from DHCP to first content
+static constexpr uint32_t BUDGET = 5000;
+static constexpr uint32_t NEVER = UINT32_MAX;
+
+// The device's system clock: millis() since boot until something sets it, so it reads 1970
+static int64_t clock_offset_ms = 0;
+static RealTimeClock *rtc = nullptr;
+
+static int64_t clock_ms() { return clock_offset_ms + esphome::millis(); }
+
+extern "C" {
+int __wrap_gettimeofday(struct timeval *tv, void *tz) {
+  int64_t ms = clock_ms();
+  tv->tv_sec = static_cast<time_t>(ms / 1000);
+  tv->tv_usec = static_cast<suseconds_t>(ms % 1000 * 1000);
+  return 0;
+}
+int __wrap_settimeofday(const struct timeval *tv, const void *tz) {
+  clock_offset_ms = static_cast<int64_t>(tv->tv_sec) * 1000 + tv->tv_usec / 1000 - esphome::millis();
+  rtc->set_epoch(tv->tv_sec);
+  return 0;
+}
+}
+
+// Answers the prefetch thread's lookups from the main loop, once they have
+// taken as long as the scenario says. The thread only reads the simulated
+// clock while the main loop waits for it (see wait_for_prefetch()).
+class Resolver {
+  public:
+    // On the prefetch thread: blocks until answered
+    bool resolve(const char *name) {
+      std::unique_lock<std::mutex> lock(this->mutex_);
+      this->started_ = esphome::millis();
+      if (this->first_lookup_ == NEVER) {
+        this->first_lookup_ = this->started_;
+      }
+      this->state_ = WAITING;
+      this->answered_.wait(lock, [this] { return this->state_ == ANSWERED; });
+      this->state_ = IDLE;
+      return true;
+    }
+
+    // Answers a waiting lookup once it has taken answer_time
+    void step(uint32_t answer_time) {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      if (this->state_ == WAITING && answer_time != NEVER && esphome::millis() - this->started_ >= answer_time) {
+        this->state_ = ANSWERED;
+        this->resolved_ = true;
+        this->answered_.notify_one();
+      }
+    }
+    // Lets a lookup still waiting at the end go
+    void release() {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      if (this->state_ == WAITING) {
+        this->state_ = ANSWERED;
+        this->answered_.notify_one();
+      }
+    }
+
+    bool waiting() {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      return this->state_ == WAITING;
+    }
+    bool resolved() {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      return this->resolved_;
+    }
+    uint32_t first_lookup() {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      return this->first_lookup_;
+    }
+
+  protected:
+    enum State { IDLE, WAITING, ANSWERED };
+
+    std::mutex mutex_;
+    std::condition_variable answered_;
+    State state_ = IDLE;
+    uint32_t started_ = 0;
+    uint32_t first_lookup_ = NEVER;
+    bool resolved_ = false;
+};
+
+class SimManager : public ConnectionManager {
+  public:
+    // No prefetch thread, or one that has finished and only waits to be joined
+    bool prefetch_idle() const { return !this->prefetch_thread_.joinable() || this->prefetch_complete_; }
+};
+
+struct Scenario {
+  const char *name;
+  uint32_t link_up;         // Associated and addressed, since boot
+  uint32_t dns_time;        // How long a lookup takes
+  uint32_t sntp_at;         // When SNTP syncs, since boot
+  uint32_t handshake_time;  // Connection and TLS handshake
+  uint32_t data_time;       // From subscribing to the first schedule message
+  bool sent_at;             // The server stamps its messages with sentAt
+  std::vector<BootStage> order;  // The stages reached, in the order reached
+};
+
+// Stands in for the transit tracker's boot stages
+class Client {
+  public:
+    Client(const Scenario &scenario, SimManager *manager, Resolver *resolver)
+        : scenario_(scenario), manager_(manager), resolver_(resolver) {
+      manager->add_on_network_ready_callback([this]() { this->connect_ = true; });
+    }
+
+    void loop() {
+      BootTimeline *timeline = this->manager_->get_boot_timeline();
+      uint32_t now = esphome::millis();
+      // Its own lookup finds the prefetched answer
+      if (this->connect_ && this->resolver_->resolved() && this->connecting_since_ == 0) {
+        this->connecting_since_ = now;
+      }
+      if (this->connecting_since_ != 0 && !timeline->has(BOOT_CONNECTED) &&
+          now - this->connecting_since_ >= this->scenario_.handshake_time) {
+        timeline->mark(BOOT_CONNECTED);
+        timeline->mark(BOOT_SUBSCRIBED);
+      }
+      if (timeline->has(BOOT_SUBSCRIBED) && !timeline->has(BOOT_FIRST_DATA) &&
+          now - timeline->get(BOOT_SUBSCRIBED) >= this->scenario_.data_time) {
+        if (this->scenario_.sent_at) {
+          this->manager_->get_server_clock()->offer(NOW_MS + now, 0, "the transit server");
+        }
+        timeline->mark(BOOT_FIRST_DATA);
+      }
+      if (timeline->has(BOOT_FIRST_DATA) && rtc->now().is_valid()) {
+        timeline->mark(BOOT_FIRST_CONTENT);
+      }
+    }
+
+  protected:
+    const Scenario &scenario_;
+    SimManager *manager_;
+    Resolver *resolver_;
+    bool connect_ = false;
+    uint32_t connecting_since_ = 0;
+};
+
+// Until the prefetch thread is blocked in a lookup or done, so only one thread uses the clock
+static void wait_for_prefetch(SimManager &manager, Resolver &resolver) {
+  while (!resolver.waiting() && !manager.prefetch_idle()) {
+    std::this_thread::yield();
+  }
+}
+
+static bool run(const Scenario &scenario) {
+  printf("%s\n", scenario.name);
+  esphome::host::reboot();
+  clock_offset_ms = 0;
+  esphome::network::host_connected = false;
+
+  RealTimeClock time_source;
+  rtc = &time_source;
+  Resolver resolver;
+  esphome::host::resolver = [&resolver](const char *name) { return resolver.resolve(name); };
+  SimManager manager;
+  manager.set_time(&time_source);
+  manager.setup();
+  manager.prefetch("wss://tt.horner.tj/");
+  Client client(scenario, &manager, &resolver);
+
+  // Until first content, and SNTP if it comes at all, since it may come after
+  BootTimeline *timeline = manager.get_boot_timeline();
+  auto done = [&]() {
+    return timeline->has(BOOT_FIRST_CONTENT) && (timeline->has(BOOT_SNTP) || scenario.sntp_at == NEVER);
+  };
+  while (esphome::millis() < RUN_TIME && !done()) {
+    uint32_t now = esphome::millis();
+    esphome::network::host_connected = now >= scenario.link_up;
+    if (now >= scenario.sntp_at && !timeline->has(BOOT_SNTP)) {
+      clock_offset_ms = NOW_MS;
+      time_source.synchronize_epoch(clock_ms() / 1000);
+    }
+    resolver.step(scenario.dns_time);
+    wait_for_prefetch(manager, resolver);
+    manager.loop();
+    client.loop();
+    wait_for_prefetch(manager, resolver);
+    esphome::host::advance(TICK);
+  }
+  resolver.release();
+  wait_for_prefetch(manager, resolver);
+  manager.loop();
+
+  // As boot_check.py shows it
+  uint32_t previous = 0;
+  std::vector<BootStage> reached;
+  for (int i = 0; i < esphome::connection_manager::BOOT_STAGE_COUNT; i++) {
+    if (timeline->has(static_cast<BootStage>(i)))
+      reached.push_back(static_cast<BootStage>(i));
+  }
+  std::stable_sort(reached.begin(), reached.end(),
+                   [timeline](BootStage a, BootStage b) { return timeline->get(a) < timeline->get(b); });
+  for (BootStage stage : reached) {
+    uint32_t at = timeline->get(stage);
+    printf("  %-14s %7ums  +%ums\n", BootTimeline::stage_name(stage), at, at - previous);
+    previous = at;
+  }
+
+  bool ok = true;
+  if (reached.size() != scenario.order.size()) {
+    printf("  reached %zu stages, expected %zu\n", reached.size(), scenario.order.size());
+    ok = false;
+  }
+  for (size_t i = 0; i + 1 < scenario.order.size(); i++) {
+    BootStage stage = scenario.order[i], next = scenario.order[i + 1];
+    if (!timeline->has(stage) || !timeline->has(next) || timeline->get(stage) > timeline->get(next)) {
+      printf("  expected %s before %s\n", BootTimeline::stage_name(stage), BootTimeline::stage_name(next));
+      ok = false;
+    }
+  }
+  // The lookup runs alongside SNTP, not after it
+  if (resolver.first_lookup() != timeline->get(BOOT_DHCP)) {
+    printf("  the first lookup started at %ums, not with DHCP at %ums\n", resolver.first_lookup(),
+           timeline->get(BOOT_DHCP));
+    ok = false;
+  }
+  if (!timeline->has(BOOT_FIRST_CONTENT) ||
+      timeline->get(BOOT_FIRST_CONTENT) - timeline->get(BOOT_DHCP) > BUDGET) {
+    printf("  no first content within %ums of DHCP\n", BUDGET);
+    ok = false;
+  }
+  esphome::host::resolver = nullptr;
+  return ok;
+}
+
+int main() {
+  setenv("TZ", "UTC0", 1);
+  tzset();
+
+  const Scenario scenarios[] = {
+      // SNTP is slow, so the first heartbeat's sentAt sets the clock and
+      // departures are drawn well before SNTP answers
+      {"slow SNTP, server stamps sentAt", 800, 110, 5000, 700, 300, true,
+       {BOOT_WIFI_ASSOCIATED, BOOT_DHCP, BOOT_DNS, BOOT_NETWORK_READY, BOOT_CONNECTED, BOOT_SUBSCRIBED,
+        BOOT_SERVER_CLOCK, BOOT_FIRST_DATA, BOOT_FIRST_CONTENT, BOOT_SNTP}},
+      // SNTP answers while the connection is being made; the servers' clocks
+      // never come into it
+      {"fast SNTP", 800, 110, 1300, 700, 300, true,
+       {BOOT_WIFI_ASSOCIATED, BOOT_DHCP, BOOT_DNS, BOOT_NETWORK_READY, BOOT_SNTP, BOOT_CONNECTED, BOOT_SUBSCRIBED,
+        BOOT_FIRST_DATA, BOOT_FIRST_CONTENT}},
+      // Without sentAt, the departures are in but wait for SNTP to be drawn
+      {"slow SNTP, no sentAt", 800, 110, 4000, 700, 300, false,
+       {BOOT_WIFI_ASSOCIATED, BOOT_DHCP, BOOT_DNS, BOOT_NETWORK_READY, BOOT_CONNECTED, BOOT_SUBSCRIBED,
+        BOOT_FIRST_DATA, BOOT_SNTP, BOOT_FIRST_CONTENT}},
+      // The network is called ready after NETWORK_SETTLE_TIME without an answer
+      {"slow DNS", 800, 1600, 5000, 700, 300, true,
+       {BOOT_WIFI_ASSOCIATED, BOOT_DHCP, BOOT_NETWORK_READY, BOOT_DNS, BOOT_CONNECTED, BOOT_SUBSCRIBED,
+        BOOT_SERVER_CLOCK, BOOT_FIRST_DATA, BOOT_FIRST_CONTENT, BOOT_SNTP}},
+  };
+
+  int failures = 0;
+  for (const auto &scenario : scenarios) {
+    failures += !run(scenario);
+  }
+  if (failures > 0) {
+    printf("%d boot scenarios failed\n", failures);
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// Host test for soccer_tracker::ChunkedReader, built and run by
+// `python run_host.py chunked_reader_test`.
+//
+// Feeds responses through a container that hands the wire bytes over a few
+// at a time and then, like a kept-alive connection, has nothing more to read
+// rather than an end. Checks the decoded body, and that reading it and
+// draining the rest consumes the whole response without waiting for more, so
+// the connection can be reused.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "esphome/components/soccer_tracker/chunked_reader.h"
+
+using esphome::soccer_tracker::ChunkedReader;
+
+class WireContainer : public esphome::http_request::HttpContainer {
+  public:
+    WireContainer(const std::string &wire, size_t content_length, size_t read_size)
+        : wire_(wire), read_size_(read_size) {
+      this->content_length = content_length;
+      this->status_code = 200;
+    }
+
+    // Like a socket on a kept-alive connection: 0 when nothing has arrived yet, never the end
+    int read(uint8_t *buf, size_t max_len) override {
+      if (this->pos_ == this->wire_.size()) {
+        this->reads_past_end++;
+        return 0;
+      }
+      size_t n = std::min({max_len, this->read_size_, this->wire_.size() - this->pos_});
+      memcpy(buf, this->wire_.data() + this->pos_, n);
+      this->pos_ += n;
+      return n;
+    }
+    void end() override {}
+
+    std::string left_on_wire() const { return this->wire_.substr(this->pos_); }
+
+    int reads_past_end = 0;
+
+  protected:
+    std::string wire_;
+    size_t read_size_;
+    size_t pos_ = 0;
+};
+
+struct Case {
+  const char *name;
+  std::string wire;
+  size_t content_length;
+  std::string body;
+};
+
+static bool run(const Case &test, size_t read_size, size_t body_bytes_read) {
+  WireContainer container(test.wire, test.content_length, read_size);
+  ChunkedReader reader(&container, 100);
+
+  std::string body;
+  char buffer[5];
+  while (body.size() < body_bytes_read) {
+    size_t n = reader.readBytes(buffer, std::min(sizeof(buffer), body_bytes_read - body.size()));
+    if (n == 0) {
+      break;
+    }
+    body.append(buffer, n);
+  }
+  // Whatever the parser left unread, as download_fixtures_() does before end()
+  reader.drain();
+
+  bool ok = true;
+  std::string expected = test.body.substr(0, body_bytes_read);
+  if (body != expected) {
+    printf("  %s, %zu-byte reads: read \"%s\", expected \"%s\"\n", test.name, read_size, body.c_str(),
+           expected.c_str());
+    ok = false;
+  }
+  if (!container.left_on_wire().empty()) {
+    printf("  %s, %zu-byte reads, %zu body bytes: \"%s\" left on the wire\n", test.name, read_size,
+           body_bytes_read, container.left_on_wire().c_str());
+    ok = false;
+  }
+  if (container.reads_past_end > 0) {
+    printf("  %s, %zu-byte reads, %zu body bytes: waited for bytes after the end of the response\n", test.name,
+           read_size, body_bytes_read);
+    ok = false;
+  }
+  return ok;
+}
+
+int main() {
+  const Case cases[] = {
+      {"identity", "{\"fixture\":1}", 13, "{\"fixture\":1}"},
+      {"one chunk", "d\r\n{\"fixture\":1}\r\n0\r\n\r\n", 0, "{\"fixture\":1}"},
+      {"chunks", "4\r\n{\"fi\r\n9\r\nxture\":1}\r\n0\r\n\r\n", 0, "{\"fixture\":1}"},
+      {"extensions", "D;name=value\r\n{\"fixture\":1}\r\n0;last\r\n\r\n", 0, "{\"fixture\":1}"},
+      {"trailers", "d\r\n{\"fixture\":1}\r\n0\r\nX-Checksum: 1a2b\r\nX-Cache: hit\r\n\r\n", 0, "{\"fixture\":1}"},
+      {"bare LF", "d\n{\"fixture\":1}\n0\nX-Cache: hit\n\n", 0, "{\"fixture\":1}"},
+  };
+
+  int failures = 0, runs = 0;
+  for (const auto &test : cases) {
+    for (size_t read_size : {1, 3, 256}) {
+      for (size_t body_bytes_read : {test.body.size(), size_t(4), size_t(0)}) {
+        runs++;
+        failures += !run(test, read_size, body_bytes_read);
+      }
+    }
+  }
+  printf("%d of %d chunked reader runs passed\n", runs - failures, runs);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+// Host test for allocations in the draw paths, built and run by
+// `python run_host.py draw_alloc_test`.
+//
+// Builds the transit and soccer trackers against the display and font
+// stand-ins, statically and with malloc, calloc and realloc wrapped by the
+// linker the way alloc_audit wraps them on the device, so operator new and
+// std::string are counted too. After alloc_audit's warm-up runs, every frame
+// of draw_schedule() (draw_trip(), the times from
+// Localization::fmt_duration_from_now(), the realtime icon, scrolling and
+// paging), every call of fmt_duration_from_now() and every frame of
+// draw_match() (dates, countdowns, scores and the match clock) must not
+// allocate, as their budgets of 0 require. That includes the first frame of a
+// fixture the multi-team rotation moves to, with teams never drawn before.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "esphome/components/alloc_audit/alloc_audit.h"
+#include "esphome/components/connection_manager/connection_manager.h"
+#include "esphome/components/soccer_tracker/soccer_tracker.h"
+#include "esphome/components/transit_tracker/transit_tracker.h"
+#include "panels.h"
+
+using esphome::alloc_audit::AllocAudit;
+using esphome::connection_manager::ConnectionManager;
+using esphome::font::Font;
+using esphome::soccer_tracker::Match;
+using esphome::soccer_tracker::MatchState;
+using esphome::soccer_tracker::SoccerTracker;
+using esphome::time::RealTimeClock;
+using esphome::transit_tracker::Localization;
+using esphome::transit_tracker::TransitTracker;
+using esphome::transit_tracker::Trip;
+using esphome::transit_tracker::UnitDisplay;
+
+// Counted on the drawing thread only, as an alloc_audit scope counts its own task
+static thread_local bool counting = false;
+static std::atomic<uint32_t> allocations{0};
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  if (counting)
+    allocations++;
+  return __real_malloc(size);
+}
+void *__wrap_calloc(size_t count, size_t size) {
+  if (counting)
+    allocations++;
+  return __real_calloc(count, size);
+}
+void *__wrap_realloc(void *ptr, size_t size) {
+  if (counting)
+    allocations++;
+  return __real_realloc(ptr, size);
+}
+}
+
+// Allocations made by f()
+template<typename F> static uint32_t count_allocations(F &&f) {
+  uint32_t before = allocations;
+  counting = true;
+  f();
+  counting = false;
+  return allocations - before;
+}
+
+static constexpr time_t NOW = 1767268800;  // 2026-01-01 12:00:00 UTC
+static constexpr uint32_t FRAME_INTERVAL = 100;
+static constexpr int WARMUP_RUNS = AllocAudit::WARMUP_RUNS;
+
+struct Scope {
+  const char *name;
+  uint32_t runs = 0;
+  uint32_t allocations = 0;
+  uint32_t over_budget = 0;
+
+  // Counts f() against the scope, once past the warm-up runs
+  template<typename F> void run(F &&f) {
+    uint32_t n = count_allocations(f);
+    if (++this->runs > WARMUP_RUNS) {
+      this->allocations += n;
+      this->over_budget += n > 0;
+    }
+  }
+  bool report() const {
+    printf("  %-28s %5u runs, %3u allocations after warm-up, over budget in %u\n", this->name, this->runs,
+           this->allocations, this->over_budget);
+    return this->allocations == 0;
+  }
+};
+
+class TransitTest : public TransitTracker {
+  public:
+    void add_trip(const char *route, uint32_t color, const char *headsign, time_t departs_in, bool realtime) {
+      Trip trip;
+      trip.route_id = route;
+      trip.route_name = route;
+      trip.route_color = esphome::Color(color);
+      trip.headsign = headsign;
+      trip.arrival_time = NOW + departs_in;
+      trip.departure_time = NOW + departs_in;
+      trip.is_realtime = realtime;
+      this->schedule_state_.trips.push_back(trip);
+    }
+    void set_connected() { this->has_ever_connected_ = true; }
+};
+
+class SoccerTest : public SoccerTracker {
+  public:
+    void add_fixture(uint32_t id, uint32_t home_id, const char *home, uint32_t away_id, const char *away,
+                     time_t kickoff, MatchState state, int home_score, int away_score) {
+      Match match;
+      match.fixture_id = id;
+      match.home_team = {home_id, home, home_score};
+      match.away_team = {away_id, away, away_score};
+      match.match_time = kickoff;
+      match.state = state;
+      this->fixtures_.store(match);
+      this->has_match_data_ = true;
+    }
+    void show() { this->show_fixture_(); }
+    void rotate() { this->rotate_fixture_(); }
+    uint32_t current_fixture() const { return this->current_match_.fixture_id; }
+};
+
+static bool test_transit(ConnectionManager *manager, RealTimeClock *rtc, Font *font) {
+  printf("transit_tracker\n");
+  RowCopyPanel panel(128);
+  TransitTest tracker;
+  tracker.set_connection_manager(manager);
+  tracker.set_rtc(rtc);
+  tracker.set_font(font);
+  tracker.set_base_url("wss://tt.example.com/");
+  tracker.set_limit(3);
+  tracker.set_scroll_headsigns(true);
+  tracker.setup();
+  tracker.set_connected();
+
+  // Every way a time can read: now, under a minute, minutes, hours and minutes
+  tracker.add_trip("14", 0x0055A5, "Downtown Seattle via 3rd Ave and Pike Street", 20, true);
+  tracker.add_trip("E Line", 0xC80F2E, "Aurora Village Transit Center", 45, false);
+  tracker.add_trip("1 Line", 0x28813F, "Angle Lake", 7 * 60, true);
+  tracker.add_trip("522", 0x0055A5, "Roosevelt Station", 75 * 60, false);
+  tracker.add_trip("Ferry", 0x007A87, "Bainbridge Island", 11 * 3600 + 5 * 60, false);
+
+  // Long enough to page through the list and scroll every headsign
+  Scope draw_schedule{"draw_schedule"};
+  for (int frame = 0; frame < 600; frame++) {
+    draw_schedule.run([&] {
+      panel.clear();
+      tracker.draw_schedule(panel);
+    });
+    esphome::host::advance(FRAME_INTERVAL);
+  }
+
+  Scope fmt_duration{"fmt_duration_from_now"};
+  for (UnitDisplay unit_display : {esphome::transit_tracker::UNIT_DISPLAY_LONG,
+                                   esphome::transit_tracker::UNIT_DISPLAY_SHORT,
+                                   esphome::transit_tracker::UNIT_DISPLAY_NONE}) {
+    Localization localization;
+    localization.set_unit_display(unit_display);
+    for (time_t departs_in : {0, 20, 45, 7 * 60, 59 * 60, 75 * 60, 11 * 3600 + 5 * 60}) {
+      fmt_duration.run([&] {
+        std::string text = localization.fmt_duration_from_now(NOW + departs_in, NOW);
+        if (text.empty())
+          abort();
+      });
+    }
+  }
+
+  bool ok = draw_schedule.report();
+  ok &= fmt_duration.report();
+  return ok;
+}
+
+// Draws each fixture the rotation shows for a while, from the first frame after the rotation; the number shown
+static int rotate_through(SoccerTest &tracker, Display &panel, Scope &scope) {
+  uint32_t first_fixture = tracker.current_fixture();
+  int fixtures_shown = 0;
+  do {
+    for (int frame = 0; frame < 50; frame++) {
+      scope.run([&] {
+        panel.clear();
+        tracker.draw_match(panel);
+      });
+      esphome::host::advance(FRAME_INTERVAL);
+    }
+    tracker.rotate();
+    fixtures_shown++;
+  } while (tracker.current_fixture() != first_fixture && fixtures_shown < 10);
+  return fixtures_shown;
+}
+
+static void setup_soccer(SoccerTest &tracker, ConnectionManager *manager, RealTimeClock *rtc, Font *font,
+                         Font *small_font) {
+  tracker.set_connection_manager(manager);
+  tracker.set_rtc(rtc);
+  tracker.set_font(font);
+  tracker.set_small_font(small_font);
+  tracker.set_favorite_team("Seattle Sounders FC");
+  tracker.set_team_id(1595);
+  tracker.add_team(1600);
+  tracker.add_team(1602);
+  tracker.setup();
+}
+
+static bool test_soccer(ConnectionManager *manager, RealTimeClock *rtc, Font *font, Font *small_font) {
+  printf("soccer_tracker\n");
+  RowCopyPanel panel(128);
+  Scope draw_match{"draw_match"};
+  bool ok = true;
+
+  // A match under way and one later today, between teams the other doesn't
+  // involve: the rotation goes back and forth between the two
+  SoccerTest match_day;
+  setup_soccer(match_day, manager, rtc, font, small_font);
+  match_day.add_fixture(1, 1595, "Seattle Sounders FC", 1596, "Portland Timbers", NOW - 37 * 60,
+                        esphome::soccer_tracker::IN_PROGRESS, 2, 1);
+  match_day.add_fixture(2, 1600, "Inter Miami CF", 1601, "Orlando City SC", NOW + 5 * 3600,
+                        esphome::soccer_tracker::TODAY_PENDING, 0, 0);
+  match_day.show();
+  int shown = rotate_through(match_day, panel, draw_match);
+  if (shown != 2) {
+    printf("  match day: rotated through %d fixtures, expected 2\n", shown);
+    ok = false;
+  }
+
+  // Nothing today: every team's next fixture in turn, one of them against a
+  // team with no logo
+  SoccerTest off_day;
+  setup_soccer(off_day, manager, rtc, font, small_font);
+  off_day.add_fixture(3, 1595, "Seattle Sounders FC", 1599, "Sporting Kansas City", NOW + 3 * 86400,
+                      esphome::soccer_tracker::SCHEDULED, 0, 0);
+  off_day.add_fixture(4, 1600, "Inter Miami CF", 1598, "New York City FC", NOW + 5 * 86400,
+                      esphome::soccer_tracker::SCHEDULED, 0, 0);
+  off_day.add_fixture(5, 1602, "LA Galaxy", 1603, "Sporting Wanderers", NOW + 7 * 86400,
+                      esphome::soccer_tracker::SCHEDULED, 0, 0);
+  off_day.show();
+  shown = rotate_through(off_day, panel, draw_match);
+  if (shown != 3) {
+    printf("  off day: rotated through %d fixtures, expected 3\n", shown);
+    ok = false;
+  }
+
+  ok &= draw_match.report();
+  return ok;
+}
+
+int main() {
+  setenv("TZ", "UTC0", 1);
+  tzset();
+
+  RealTimeClock rtc;
+  rtc.set_epoch(NOW);
+  ConnectionManager manager;
+  manager.setup();
+  Font font, small_font;
+
+  bool ok = test_transit(&manager, &rtc, &font);
+  ok &= test_soccer(&manager, &rtc, &font, &small_font);
+  if (!ok) {
+    printf("A draw path allocated after warming up\n");
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+// Panel displays shared by the host benchmarks, 32 rows high and any number of
+// 64px panels wide
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "esphome/components/display/display.h"
+#include "esphome/components/matrix_render/span_buffer.h"
+
+using esphome::Color;
+using esphome::display::ColorBitness;
+using esphome::display::ColorOrder;
+using esphome::display::Display;
+using esphome::display::DisplayType;
+using esphome::matrix_render::SpanBuffer;
+
+static constexpr int HEIGHT = 32;
+
+// Stores RGB565 like a panel driver's frame buffer, checking bounds and the
+// clipping rectangle on every pixel
+class PanelDisplay : public Display {
+  public:
+    explicit PanelDisplay(int width) : width_(width), frame_(width * HEIGHT) {}
+
+    void __attribute__((noinline)) draw_pixel_at(int x, int y, Color color) override {
+      this->pixel_calls++;
+      if (x < 0 || x >= this->width_ || y < 0 || y >= HEIGHT || !this->get_clipping().inside(x, y)) {
+        return;
+      }
+      this->frame_[y * this->width_ + x] = SpanBuffer::to_rgb565(color);
+    }
+    void fill(Color color) override {
+      std::fill(this->frame_.begin(), this->frame_.end(), SpanBuffer::to_rgb565(color));
+    }
+    DisplayType get_display_type() override { return DisplayType::DISPLAY_TYPE_COLOR; }
+
+    const std::vector<uint16_t> &frame() const { return this->frame_; }
+
+    uint64_t pixel_calls = 0;
+    uint64_t span_calls = 0;
+
+  protected:
+    int get_width_internal() override { return this->width_; }
+    int get_height_internal() override { return HEIGHT; }
+
+    int width_;
+    std::vector<uint16_t> frame_;
+};
+
+// A panel driver that hands draw_pixels_at() to the per-pixel fallback
+class PerPixelPanel : public PanelDisplay {
+  public:
+    using PanelDisplay::PanelDisplay;
+    using Display::draw_pixels_at;
+    void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                        ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override {
+      this->span_calls++;
+      Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset, x_pad);
+    }
+};
+
+// A driver that copies little-endian RGB565 rows straight into its frame,
+// registered so the blits take the span path
+class RowCopyPanel : public PanelDisplay {
+  public:
+    explicit RowCopyPanel(int width) : PanelDisplay(width) { esphome::matrix_render::register_row_copy(this); }
+    RowCopyPanel(const RowCopyPanel &) = delete;
+    ~RowCopyPanel() override { esphome::matrix_render::unregister_row_copy(this); }
+    using Display::draw_pixels_at;
+    void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                        ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) override {
+      this->span_calls++;
+      const uint16_t *src = reinterpret_cast<const uint16_t *>(ptr);
+      for (int row = 0; row < h; row++) {
+        memcpy(&this->frame_[(y_start + row) * this->width_ + x_start],
+               src + (y_offset + row) * (x_offset + w + x_pad) + x_offset, w * sizeof(uint16_t));
+      }
+    }
+};
+
+static Color from_rgb565(uint16_t rgb565) {
+  return Color(((rgb565 >> 11) & 0x1F) * 255 / 31, ((rgb565 >> 5) & 0x3F) * 255 / 63, (rgb565 & 0x1F) * 255 / 31);
+}
@@ -0,0 +1,135 @@
+"""Builds and runs the host benchmarks and tests.
+
+Each program is compiled with the host C++ compiler against the components in
+../components and the stand-ins for ESPHome headers in stubs/, then run. The
+exit status is non-zero if any program fails to build or fails its checks.
+
+Usage:
+    python run_host.py [<program> ...]
+
+    <program>  one or more of the programs below (default: all of them)
+"""
+
+import argparse
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+HERE = Path(__file__).resolve().parent
+COMPONENTS_DIR = HERE.parent / "components"
+STUBS_DIR = HERE / "stubs"
+
+# Program name: sources besides <name>.cpp, relative to the components directory or stubs/
+PROGRAMS = {
+    "span_benchmark": [
+        "matrix_render/span_buffer.cpp",
+        "stubs:esphome/components/display/display.cpp",
+    ],
+    "band_benchmark": [
+        "matrix_render/banded_renderer.cpp",
+        "matrix_render/span_buffer.cpp",
+        "stubs:esphome/components/display/display.cpp",
+        "stubs:esphome/core/hal.cpp",
+    ],
+    "chunked_reader_test": [
+        "soccer_tracker/chunked_reader.cpp",
+        "stubs:esphome/core/hal.cpp",
+    ],
+    "draw_alloc_test": [
+        "transit_tracker/transit_tracker.cpp",
+        "transit_tracker/trip_view.cpp",
+        "transit_tracker/string_utils.cpp",
+        "soccer_tracker/soccer_tracker.cpp",
+        "soccer_tracker/fixture_table.cpp",
+        "soccer_tracker/season_cache.cpp",
+        "soccer_tracker/chunked_reader.cpp",
+        "connection_manager/connection_manager.cpp",
+        "connection_manager/boot_timeline.cpp",
+        "connection_manager/server_clock.cpp",
+        "connection_manager/tls_session_cache.cpp",
+        "matrix_render/text_metrics.cpp",
+        "matrix_render/span_buffer.cpp",
+        "matrix_render/banded_renderer.cpp",
+        "memory_placement/placement.cpp",
+        "stubs:esphome/components/connection_manager/tls_client.cpp",
+        "stubs:esphome/components/display/display.cpp",
+        "stubs:esphome/components/font/font.cpp",
+        "stubs:esphome/core/hal.cpp",
+    ],
+    "boot_sim": [
+        "connection_manager/connection_manager.cpp",
+        "connection_manager/boot_timeline.cpp",
+        "connection_manager/server_clock.cpp",
+        "connection_manager/tls_session_cache.cpp",
+        "stubs:esphome/components/connection_manager/tls_client.cpp",
+        "stubs:esphome/core/hal.cpp",
+    ],
+    "tls_handshake_test": [
+        "connection_manager/tls_client.cpp",
+        "connection_manager/tls_session_cache.cpp",
+        "stubs:mbedtls/ssl.cpp",
+        "stubs:esphome/core/hal.cpp",
+    ],
+}
+
+# Program name: extra compiler and linker flags
+FLAGS = {
+    # Static, so the wraps also catch the allocations inside libstdc++ (operator new)
+    "draw_alloc_test": ["-static", "-Wl,--wrap=malloc", "-Wl,--wrap=calloc", "-Wl,--wrap=realloc"],
+    # The server clock sets a simulated system clock rather than the host's
+    "boot_sim": ["-Wl,--wrap=gettimeofday", "-Wl,--wrap=settimeofday"],
+    # mbedtls stands in on the host's OpenSSL
+    "tls_handshake_test": ["-lssl", "-lcrypto"],
+}
+
+
+def source_path(source: str) -> Path:
+    if source.startswith("stubs:"):
+        return STUBS_DIR / source[len("stubs:"):]
+    return COMPONENTS_DIR / source
+
+
+def build_and_run(compiler: str, name: str, tmp_path: Path) -> int:
+    binary = tmp_path / name
+    sources = [HERE / f"{name}.cpp"] + [source_path(source) for source in PROGRAMS[name]]
+    cmd = [compiler, "-O2", "-std=gnu++17", "-pthread", f"-I{STUBS_DIR}", f"-I{tmp_path}"]
+    cmd += [str(source) for source in sources] + FLAGS.get(name, []) + ["-o", str(binary)]
+    print(f"== {name}")
+    if subprocess.run(cmd).returncode != 0:
+        return 1
+    return subprocess.run([str(binary)]).returncode
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("programs", nargs="*", metavar="program", help=", ".join(PROGRAMS))
+    args = parser.parse_args()
+    unknown = [name for name in args.programs if name not in PROGRAMS]
+    if unknown:
+        parser.error(f"unknown program {', '.join(unknown)}; choose from {', '.join(PROGRAMS)}")
+
+    compiler = shutil.which("c++") or shutil.which("g++") or shutil.which("clang++")
+    if compiler is None:
+        print("Error: needs a host C++ compiler (c++, g++ or clang++)")
+        sys.exit(1)
+
+    failed = []
+    with tempfile.TemporaryDirectory() as tmp:
+        tmp_path = Path(tmp)
+        # Mirror the "esphome/components/..." include layout of an ESPHome build;
+        # stubs/ comes first on the include path, so its headers win
+        (tmp_path / "esphome").mkdir()
+        (tmp_path / "esphome" / "components").symlink_to(COMPONENTS_DIR, target_is_directory=True)
+        for name in args.programs or PROGRAMS:
+            if build_and_run(compiler, name, tmp_path) != 0:
+                failed.append(name)
+
+    if failed:
+        print(f"Failed: {', '.join(failed)}")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+// Host benchmark for matrix_render::SpanBuffer, built and run by
+// `python run_host.py span_benchmark`.
+//
+// Draws the same content twice, once a pixel at a time through
+// Display::draw_pixel_at() the way display::Display::image() does, and once
+// through the span path (blit_image() and SpanBuffer::flush()). Each is drawn
+// on two displays: one that only implements draw_pixel_at(), like the HUB75
+// driver, so a flushed span falls back to ESPHome's per-pixel
+// draw_pixels_at(); and one that copies RGB565 rows in draw_pixels_at(), like
+// BandCanvas. blit_image() only takes the span path on the second, since the
+// fallback is slower than drawing the pixels directly; the full rows are
+// flushed as spans on both to show what that costs. Reports the time per
+// frame and the calls into the display, and checks both paths leave the same
+// pixels behind.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "esphome/components/matrix_render/span_buffer.h"
+#include "esphome/components/matrix_render/logo_atlas.h"
+#include "panels.h"
+
+using esphome::matrix_render::RleImage;
+using esphome::matrix_render::LOGO_ATLAS;
+
+static constexpr int LOGO_COUNT = sizeof(LOGO_ATLAS) / sizeof(LOGO_ATLAS[0]);
+
+// The logos tiled across the panel, as the soccer tracker draws them
+static void logos_per_pixel(Display &display) {
+  int width = display.get_width();
+  for (int i = 0; i < LOGO_COUNT; i++) {
+    const RleImage &image = LOGO_ATLAS[i].image;
+    int x0 = (i * 16) % width, y0 = (i * 16 / width) % 2 * 16;
+    const uint8_t *runs = image.runs;
+    for (int y = 0; y < image.height; y++) {
+      runs = esphome::matrix_render::rle_decode_row(image, runs, [&](int col, int length, uint8_t index) {
+        if (index != esphome::matrix_render::RLE_TRANSPARENT) {
+          for (int x = col; x < col + length; x++)
+            display.draw_pixel_at(x0 + x, y0 + y, from_rgb565(image.palette[index]));
+        }
+      });
+    }
+  }
+}
+
+static void logos_spans(Display &display) {
+  int width = display.get_width();
+  for (int i = 0; i < LOGO_COUNT; i++) {
+    int x0 = (i * 16) % width, y0 = (i * 16 / width) % 2 * 16;
+    esphome::matrix_render::blit_image(&display, x0, y0, LOGO_ATLAS[i].image);
+  }
+}
+
+// Every row of the panel, fully covered, as a full-width background would be
+static uint16_t row_color(int x, int y) { return ((x * 7 + y * 3) & 0x1F) << 11 | ((x + y) & 0x3F) << 5; }
+
+static void rows_per_pixel(Display &display) {
+  int width = display.get_width();
+  for (int y = 0; y < HEIGHT; y++) {
+    for (int x = 0; x < width; x++)
+      display.draw_pixel_at(x, y, from_rgb565(row_color(x, y)));
+  }
+}
+
+static void rows_spans(Display &display) {
+  static SpanBuffer span;
+  int width = display.get_width();
+  for (int y = 0; y < HEIGHT; y++) {
+    span.begin(0, width);
+    for (int x = 0; x < width; x++)
+      span.set_rgb565(x, row_color(x, y));
+    span.flush(&display, y);
+  }
+}
+
+struct Result {
+  double us_per_frame;
+  double pixel_calls;
+  double span_calls;
+};
+
+template<typename P, typename F> static Result measure(int width, int frames, F &&draw) {
+  P panel(width);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < frames; i++)
+    draw(panel);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return {std::chrono::duration<double, std::micro>(elapsed).count() / frames, double(panel.pixel_calls) / frames,
+          double(panel.span_calls) / frames};
+}
+
+template<typename F, typename G> static bool same_pixels(int width, F &&per_pixel, G &&spans) {
+  PerPixelPanel a(width), b(width);
+  RowCopyPanel c(width);
+  per_pixel(a);
+  spans(b);
+  spans(c);
+  return a.frame() == b.frame() && a.frame() == c.frame();
+}
+
+static void report(const char *name, const Result &result) {
+  printf("    %-28s %8.1f us  %7.0f draw_pixel_at  %5.0f draw_pixels_at\n", name, result.us_per_frame,
+         result.pixel_calls, result.span_calls);
+}
+
+int main() {
+  bool ok = true;
+  printf("sizeof(SpanBuffer) = %zu B, on the stack of every span blit\n", sizeof(SpanBuffer));
+
+  for (int panels : {2, 4, 8}) {
+    int width = panels * 64;
+    const int frames = 2000 / panels;
+    printf("%d panels, %dx%d\n", panels, width, HEIGHT);
+
+    printf("  %d logos\n", LOGO_COUNT);
+    report("per pixel", measure<PerPixelPanel>(width, frames, logos_per_pixel));
+    report("blit_image, per pixel", measure<PerPixelPanel>(width, frames, logos_spans));
+    report("blit_image, row copy", measure<RowCopyPanel>(width, frames, logos_spans));
+    if (!same_pixels(width, logos_per_pixel, logos_spans)) {
+      printf("  logos differ between the per-pixel and span paths\n");
+      ok = false;
+    }
+
+    printf("  full rows\n");
+    report("per pixel", measure<PerPixelPanel>(width, frames, rows_per_pixel));
+    report("spans, per-pixel fallback", measure<PerPixelPanel>(width, frames, rows_spans));
+    report("spans, row copy", measure<RowCopyPanel>(width, frames, rows_spans));
+    if (!same_pixels(width, rows_per_pixel, rows_spans)) {
+      printf("  rows differ between the per-pixel and span paths\n");
+      ok = false;
+    }
+  }
+  return ok ? 0 : 1;
+}
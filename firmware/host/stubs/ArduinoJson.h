@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Host stand-in for ArduinoJson 7: the types the trackers name, holding
+// nothing. Every document reads as empty and every parse fails, so message
+// and response handling compiles but is not exercised on the host.
+
+#define ARDUINOJSON_VERSION_MAJOR 7
+
+namespace ArduinoJson {
+class Allocator {
+  public:
+    virtual void *allocate(size_t size) = 0;
+    virtual void deallocate(void *ptr) = 0;
+    virtual void *reallocate(void *ptr, size_t new_size) = 0;
+
+  protected:
+    ~Allocator() = default;
+};
+}  // namespace ArduinoJson
+
+class JsonObject;
+class JsonArray;
+
+class JsonVariant {
+  public:
+    template<typename T> T as() const { return T(); }
+    template<typename T> bool is() const { return false; }
+    template<typename T> T to() { return T(); }
+    template<typename T> operator T() const { return T(); }
+    template<typename T> JsonVariant &operator=(const T &value) { return *this; }
+    template<typename T> bool set(const T &value) { return false; }
+    template<typename T> bool add(const T &value) { return false; }
+
+    JsonVariant operator[](const char *key) const { return {}; }
+    JsonVariant operator[](const std::string &key) const { return {}; }
+    JsonVariant operator[](int index) const { return {}; }
+
+    bool isNull() const { return true; }
+    bool containsKey(const char *key) const { return false; }
+    size_t size() const { return 0; }
+    JsonObject createNestedObject(const char *key);
+    JsonArray createNestedArray(const char *key);
+
+    // Iterating an object or array visits nothing
+    const JsonVariant *begin() const { return nullptr; }
+    const JsonVariant *end() const { return nullptr; }
+};
+
+class JsonObject : public JsonVariant {};
+class JsonArray : public JsonVariant {};
+
+inline JsonObject JsonVariant::createNestedObject(const char *key) { return {}; }
+inline JsonArray JsonVariant::createNestedArray(const char *key) { return {}; }
+
+class JsonDocument : public JsonVariant {
+  public:
+    JsonDocument() = default;
+    explicit JsonDocument(ArduinoJson::Allocator *allocator) {}
+    void clear() {}
+    bool overflowed() const { return false; }
+};
+
+class DeserializationError {
+  public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+
+    DeserializationError(Code code = Ok) : code_(code) {}
+    explicit operator bool() const { return this->code_ != Ok; }
+    Code code() const { return this->code_; }
+    const char *c_str() const { return this->code_ == Ok ? "Ok" : "InvalidInput"; }
+
+  protected:
+    Code code_;
+};
+
+namespace DeserializationOption {
+class Filter {
+  public:
+    explicit Filter(const JsonDocument &filter) {}
+};
+}  // namespace DeserializationOption
+
+template<typename Input> DeserializationError deserializeJson(JsonDocument &doc, Input &&input) {
+  return DeserializationError::InvalidInput;
+}
+template<typename Input>
+DeserializationError deserializeJson(JsonDocument &doc, Input &&input, DeserializationOption::Filter filter) {
+  return DeserializationError::InvalidInput;
+}
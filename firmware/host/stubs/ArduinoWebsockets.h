@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "WString.h"
+
+// Host stand-in for ArduinoWebsockets: a client that never connects, so the
+// trackers build and their drawing can be driven without a server
+
+namespace websockets {
+
+namespace network {
+class TcpClient {
+  public:
+    virtual ~TcpClient() = default;
+};
+template<class WifiClientImpl> class GenericEspTcpClient : public TcpClient {
+  protected:
+    WifiClientImpl client;
+};
+}  // namespace network
+
+enum class WebsocketsEvent { ConnectionOpened, ConnectionClosed, GotPing, GotPong };
+
+class WebsocketsMessage {
+  public:
+    const std::string &rawData() const { return this->data_; }
+    std::string data() const { return this->data_; }
+
+  protected:
+    std::string data_;
+};
+
+class WebsocketsClient {
+  public:
+    WebsocketsClient() = default;
+    explicit WebsocketsClient(std::shared_ptr<network::TcpClient> client) {}
+
+    void onMessage(std::function<void(WebsocketsMessage)> callback) {}
+    void onEvent(std::function<void(WebsocketsEvent, String)> callback) {}
+
+    bool connect(const String &url) { return false; }
+    bool connect(const String &host, int port, const String &path) { return false; }
+    bool available(bool active_test = false) { return false; }
+    bool poll() { return false; }
+    bool send(const std::string &data) { return false; }
+    bool ping(const std::string &data = "") { return false; }
+    void close() {}
+};
+
+}  // namespace websockets
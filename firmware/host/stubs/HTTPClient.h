@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "WString.h"
+#include "WiFiClient.h"
+
+// Host stand-in for Arduino's HTTPClient.h: every request fails to connect
+
+static const int HTTPC_ERROR_CONNECTION_REFUSED = -1;
+
+class HTTPClient {
+  public:
+    bool begin(WiFiClient &client, const char *url) { return true; }
+    void end() {}
+    void setReuse(bool reuse) {}
+    void setTimeout(uint16_t timeout) {}
+    void addHeader(const char *name, const char *value) {}
+    void collectHeaders(const char *header_keys[], size_t header_keys_count) {}
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int getSize() { return -1; }
+    String header(const char *name) { return String(); }
+    WiFiClient *getStreamPtr() { return nullptr; }
+    static String errorToString(int error) { return String("connection refused"); }
+};
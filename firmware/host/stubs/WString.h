@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+// Host stand-in for Arduino's WString.h: enough of String to pass text around
+
+class String {
+  public:
+    String() = default;
+    String(const char *str) : str_(str) {}
+    String(const std::string &str) : str_(str) {}
+
+    const char *c_str() const { return this->str_.c_str(); }
+    unsigned int length() const { return this->str_.size(); }
+
+  protected:
+    std::string str_;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "WString.h"
+
+// Host stand-in for Arduino's WiFiClient.h: a client that never connects
+
+class IPAddress {
+  public:
+    String toString() const { return String("0.0.0.0"); }
+};
+
+class WiFiClient {
+  public:
+    virtual ~WiFiClient() = default;
+
+    virtual int connect(IPAddress ip, uint16_t port) { return 0; }
+    virtual int connect(IPAddress ip, uint16_t port, int32_t timeout) { return 0; }
+    virtual int connect(const char *host, uint16_t port) { return 0; }
+    virtual int connect(const char *host, uint16_t port, int32_t timeout) { return 0; }
+    virtual size_t write(uint8_t data) { return 0; }
+    virtual size_t write(const uint8_t *buf, size_t size) { return 0; }
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int read(uint8_t *buf, size_t size) { return -1; }
+    virtual int peek() { return -1; }
+    virtual void flush() {}
+    virtual void stop() {}
+    virtual uint8_t connected() { return 0; }
+
+    size_t readBytes(uint8_t *buf, size_t length) {
+      int n = this->read(buf, length);
+      return n < 0 ? 0 : n;
+    }
+    void setNoDelay(bool nodelay) {}
+};
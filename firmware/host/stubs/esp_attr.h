@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for ESP-IDF's esp_attr.h: there is no RTC memory, so
+// "surviving a reboot" is just surviving
+
+#define RTC_NOINIT_ATTR
+#define IRAM_ATTR
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <sys/random.h>
+
+#include <cstddef>
+
+// Host stand-in for ESP-IDF's esp_random.h, from the host's random source
+
+inline void esp_fill_random(void *buf, size_t len) {
+  auto *out = static_cast<unsigned char *>(buf);
+  while (len > 0) {
+    ssize_t filled = getrandom(out, len, 0);
+    if (filled > 0) {
+      out += filled;
+      len -= filled;
+    }
+  }
+}
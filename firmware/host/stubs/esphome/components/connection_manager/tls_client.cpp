@@ -0,0 +1,28 @@
+#include "esphome/components/connection_manager/tls_client.h"
+
+// Host stand-in for tls_client.cpp, which drives mbedtls over lwIP sockets:
+// a TLS client that never connects, like the host WiFiClient
+
+namespace esphome {
+namespace connection_manager {
+
+struct TlsClient::Context {};
+
+TlsClient::TlsClient() = default;
+TlsClient::~TlsClient() = default;
+
+int TlsClient::connect(IPAddress ip, uint16_t port) { return 0; }
+int TlsClient::connect(IPAddress ip, uint16_t port, int32_t timeout) { return 0; }
+int TlsClient::connect(const char *host, uint16_t port) { return 0; }
+int TlsClient::connect(const char *host, uint16_t port, int32_t timeout) { return 0; }
+size_t TlsClient::write(uint8_t data) { return 0; }
+size_t TlsClient::write(const uint8_t *buf, size_t size) { return 0; }
+int TlsClient::available() { return 0; }
+int TlsClient::read() { return -1; }
+int TlsClient::read(uint8_t *buf, size_t size) { return -1; }
+int TlsClient::peek() { return -1; }
+void TlsClient::stop() {}
+uint8_t TlsClient::connected() { return 0; }
+
+}  // namespace connection_manager
+}  // namespace esphome
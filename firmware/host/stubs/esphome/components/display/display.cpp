@@ -0,0 +1,182 @@
+#include "display.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace esphome {
+namespace display {
+
+void Rect::shrink(Rect rect) {
+  if (!this->is_set()) {
+    *this = rect;
+    return;
+  }
+  if (!rect.is_set()) {
+    return;
+  }
+  int16_t x1 = std::max(this->x, rect.x);
+  int16_t y1 = std::max(this->y, rect.y);
+  int16_t x2 = std::min(this->x2(), rect.x2());
+  int16_t y2 = std::min(this->y2(), rect.y2());
+  this->x = x1;
+  this->y = y1;
+  this->w = std::max<int16_t>(0, x2 - x1);
+  this->h = std::max<int16_t>(0, y2 - y1);
+}
+
+static Color to_color(uint32_t value, ColorOrder order, ColorBitness bitness) {
+  uint8_t first, second, third;
+  switch (bitness) {
+    case COLOR_BITNESS_565:
+      first = ((value >> 11) & 0x1F) * 255 / 31;
+      second = ((value >> 5) & 0x3F) * 255 / 63;
+      third = (value & 0x1F) * 255 / 31;
+      break;
+    case COLOR_BITNESS_332:
+      first = ((value >> 5) & 0x07) * 255 / 7;
+      second = ((value >> 2) & 0x07) * 255 / 7;
+      third = (value & 0x03) * 255 / 3;
+      break;
+    default:
+      first = (value >> 16) & 0xFF;
+      second = (value >> 8) & 0xFF;
+      third = value & 0xFF;
+      break;
+  }
+  switch (order) {
+    case COLOR_ORDER_BGR:
+      return Color(third, second, first);
+    case COLOR_ORDER_GRB:
+      return Color(second, first, third);
+    default:
+      return Color(first, second, third);
+  }
+}
+
+void Display::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                             ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad) {
+  size_t line_stride = x_offset + w + x_pad;
+  for (int y = 0; y != h; y++) {
+    size_t source_idx = (y_offset + y) * line_stride + x_offset;
+    for (int x = 0; x != w; x++, source_idx++) {
+      uint32_t value;
+      switch (bitness) {
+        case COLOR_BITNESS_565: {
+          const uint8_t *p = ptr + source_idx * 2;
+          value = big_endian ? (p[0] << 8) | p[1] : p[0] | (p[1] << 8);
+          break;
+        }
+        case COLOR_BITNESS_888: {
+          const uint8_t *p = ptr + source_idx * 3;
+          value = big_endian ? (p[0] << 16) | (p[1] << 8) | p[2] : p[0] | (p[1] << 8) | (p[2] << 16);
+          break;
+        }
+        default:
+          value = ptr[source_idx];
+          break;
+      }
+      this->draw_pixel_at(x + x_start, y + y_start, to_color(value, order, bitness));
+    }
+  }
+}
+
+void Display::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
+
+void Display::filled_rectangle(int x1, int y1, int width, int height, Color color) {
+  for (int y = y1; y < y1 + height; y++) {
+    this->horizontal_line(x1, y, width, color);
+  }
+}
+
+void Display::horizontal_line(int x, int y, int width, Color color) {
+  for (int i = x; i < x + width; i++) {
+    this->draw_pixel_at(i, y, color);
+  }
+}
+
+void Display::print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text, Color background) {
+  int x_start, y_start;
+  int width, height;
+  this->get_text_bounds(x, y, text, font, align, &x_start, &y_start, &width, &height);
+  font->print(x_start, y_start, this, color, text, background);
+}
+
+void Display::vprintf_(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, va_list arg) {
+  char buffer[256];
+  int ret = vsnprintf(buffer, sizeof(buffer), format, arg);
+  if (ret > 0) {
+    this->print(x, y, font, color, align, buffer);
+  }
+}
+
+void Display::printf(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  this->vprintf_(x, y, font, color, align, format, arg);
+  va_end(arg);
+}
+
+void Display::printf(int x, int y, BaseFont *font, Color color, const char *format, ...) {
+  va_list arg;
+  va_start(arg, format);
+  this->vprintf_(x, y, font, color, TextAlign::TOP_LEFT, format, arg);
+  va_end(arg);
+}
+
+void Display::get_text_bounds(int x, int y, const char *text, BaseFont *font, TextAlign align, int *x1, int *y1,
+                              int *width, int *height) {
+  int x_offset, baseline;
+  font->measure(text, width, &x_offset, &baseline, height);
+
+  auto x_align = TextAlign(int(align) & 0x18);
+  auto y_align = TextAlign(int(align) & 0x07);
+
+  switch (x_align) {
+    case TextAlign::RIGHT:
+      *x1 = x - *width;
+      break;
+    case TextAlign::CENTER_HORIZONTAL:
+      *x1 = x - (*width) / 2;
+      break;
+    default:
+      *x1 = x;
+      break;
+  }
+  switch (y_align) {
+    case TextAlign::BOTTOM:
+      *y1 = y - *height;
+      break;
+    case TextAlign::BASELINE:
+      *y1 = y - baseline;
+      break;
+    case TextAlign::CENTER_VERTICAL:
+      *y1 = y - (*height) / 2;
+      break;
+    default:
+      *y1 = y;
+      break;
+  }
+}
+
+void Display::start_clipping(Rect rect) {
+  if (!this->clipping_rectangle_.empty()) {
+    rect.shrink(this->clipping_rectangle_.back());
+  }
+  this->clipping_rectangle_.push_back(rect);
+}
+
+void Display::end_clipping() {
+  if (!this->clipping_rectangle_.empty()) {
+    this->clipping_rectangle_.pop_back();
+  }
+}
+
+Rect Display::get_clipping() const {
+  if (this->clipping_rectangle_.empty()) {
+    return Rect();
+  }
+  return this->clipping_rectangle_.back();
+}
+
+}  // namespace display
+}  // namespace esphome
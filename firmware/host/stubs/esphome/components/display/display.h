@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstdint>
+#include <vector>
+
+#include "esphome/core/color.h"
+
+// Host stand-in for esphome/components/display/display.h: the drawing entry
+// points the matrix renderer and the trackers use, with ESPHome's per-pixel
+// fallback for draw_pixels_at(), its clipping stack and its text alignment.
+// Rotation is not modelled.
+
+namespace esphome {
+namespace display {
+
+enum ColorOrder : uint8_t { COLOR_ORDER_RGB = 0, COLOR_ORDER_BGR = 1, COLOR_ORDER_GRB = 2 };
+enum ColorBitness : uint8_t { COLOR_BITNESS_888 = 0, COLOR_BITNESS_565 = 1, COLOR_BITNESS_332 = 2 };
+enum class DisplayType { DISPLAY_TYPE_BINARY = 1, DISPLAY_TYPE_GRAYSCALE = 2, DISPLAY_TYPE_COLOR = 3 };
+
+enum class TextAlign {
+  TOP = 0x00,
+  CENTER_VERTICAL = 0x01,
+  BASELINE = 0x02,
+  BOTTOM = 0x04,
+
+  LEFT = 0x00,
+  CENTER_HORIZONTAL = 0x08,
+  RIGHT = 0x10,
+
+  TOP_LEFT = TOP | LEFT,
+  TOP_CENTER = TOP | CENTER_HORIZONTAL,
+  TOP_RIGHT = TOP | RIGHT,
+
+  CENTER_LEFT = CENTER_VERTICAL | LEFT,
+  CENTER = CENTER_VERTICAL | CENTER_HORIZONTAL,
+  CENTER_RIGHT = CENTER_VERTICAL | RIGHT,
+
+  BASELINE_LEFT = BASELINE | LEFT,
+  BASELINE_CENTER = BASELINE | CENTER_HORIZONTAL,
+  BASELINE_RIGHT = BASELINE | RIGHT,
+
+  BOTTOM_LEFT = BOTTOM | LEFT,
+  BOTTOM_CENTER = BOTTOM | CENTER_HORIZONTAL,
+  BOTTOM_RIGHT = BOTTOM | RIGHT,
+};
+
+static const int16_t VALUE_NO_SET = 32766;
+
+struct Rect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+
+  Rect() : x(VALUE_NO_SET), y(VALUE_NO_SET), w(VALUE_NO_SET), h(VALUE_NO_SET) {}
+  Rect(int16_t x, int16_t y, int16_t w, int16_t h) : x(x), y(y), w(w), h(h) {}
+  int16_t x2() const { return this->x + this->w; }
+  int16_t y2() const { return this->y + this->h; }
+  bool is_set() const { return this->h != VALUE_NO_SET && this->w != VALUE_NO_SET; }
+  bool inside(int16_t test_x, int16_t test_y) const {
+    return !this->is_set() || (test_x >= this->x && test_x < this->x2() && test_y >= this->y && test_y < this->y2());
+  }
+  void shrink(Rect rect);
+};
+
+class Display;
+
+class BaseFont {
+  public:
+    virtual ~BaseFont() = default;
+    virtual void print(int x, int y, Display *display, Color color, const char *text, Color background) = 0;
+    virtual void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) = 0;
+};
+
+class Display {
+  public:
+    virtual ~Display() = default;
+
+    virtual void draw_pixel_at(int x, int y, Color color) = 0;
+    void draw_pixel_at(int x, int y) { this->draw_pixel_at(x, y, COLOR_WHITE); }
+
+    // Converts every pixel and hands it to draw_pixel_at(), as ESPHome does
+    // for drivers that don't override it
+    virtual void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                                ColorBitness bitness, bool big_endian, int x_offset, int y_offset, int x_pad);
+    void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, ColorOrder order,
+                        ColorBitness bitness, bool big_endian) {
+      this->draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, 0, 0, 0);
+    }
+
+    virtual void fill(Color color);
+    void clear() { this->fill(COLOR_BLACK); }
+    void filled_rectangle(int x1, int y1, int width, int height, Color color = COLOR_WHITE);
+    void horizontal_line(int x, int y, int width, Color color = COLOR_WHITE);
+
+    // Text is placed by its bounding box, as ESPHome does, and drawn by the font
+    void print(int x, int y, BaseFont *font, Color color, TextAlign align, const char *text,
+               Color background = COLOR_OFF);
+    void print(int x, int y, BaseFont *font, Color color, const char *text, Color background = COLOR_OFF) {
+      this->print(x, y, font, color, TextAlign::TOP_LEFT, text, background);
+    }
+    void print(int x, int y, BaseFont *font, const char *text) {
+      this->print(x, y, font, COLOR_WHITE, TextAlign::TOP_LEFT, text);
+    }
+    // Formatted into a 256-byte buffer on the stack, as ESPHome does
+    void printf(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, ...)
+        __attribute__((format(printf, 7, 8)));
+    void printf(int x, int y, BaseFont *font, Color color, const char *format, ...)
+        __attribute__((format(printf, 6, 7)));
+    void get_text_bounds(int x, int y, const char *text, BaseFont *font, TextAlign align, int *x1, int *y1,
+                         int *width, int *height);
+
+    int get_width() { return this->get_width_internal(); }
+    int get_height() { return this->get_height_internal(); }
+
+    virtual DisplayType get_display_type() = 0;
+    virtual void update() {}
+
+    void start_clipping(Rect rect);
+    void start_clipping(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+      this->start_clipping(Rect(left, top, right - left, bottom - top));
+    }
+    void end_clipping();
+    Rect get_clipping() const;
+    bool is_clipping() const { return !this->clipping_rectangle_.empty(); }
+
+  protected:
+    void vprintf_(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, va_list arg);
+
+    virtual int get_width_internal() = 0;
+    virtual int get_height_internal() = 0;
+
+    std::vector<Rect> clipping_rectangle_;
+};
+
+}  // namespace display
+}  // namespace esphome
@@ -0,0 +1,38 @@
+#include "font.h"
+
+namespace esphome {
+namespace font {
+
+static bool is_glyph(char c) { return c >= 0x20 && c < 0x7F; }
+
+void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text,
+                 Color background) {
+  int x = x_start;
+  for (const char *c = text; *c != '\0'; c++) {
+    if (!is_glyph(*c)) {
+      x += UNKNOWN_ADVANCE;
+      continue;
+    }
+    if (*c != ' ') {
+      for (int y = 0; y < 7; y++) {
+        for (int i = 0; i < 5; i++) {
+          display->draw_pixel_at(x + i, y_start + this->get_baseline() - 7 + y, color);
+        }
+      }
+    }
+    x += GLYPH_ADVANCE;
+  }
+}
+
+void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
+  *width = 0;
+  for (const char *c = str; *c != '\0'; c++) {
+    *width += is_glyph(*c) ? GLYPH_ADVANCE : UNKNOWN_ADVANCE;
+  }
+  *x_offset = 0;
+  *baseline = this->get_baseline();
+  *height = this->get_height();
+}
+
+}  // namespace font
+}  // namespace esphome
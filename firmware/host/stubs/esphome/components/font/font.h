@@ -0,0 +1,28 @@
+#pragma once
+
+#include "esphome/components/display/display.h"
+
+// Host stand-in for esphome/components/font/font.h: a fixed-pitch font of
+// 5x7 boxes. Printable ASCII are glyphs; any other byte is skipped with a
+// narrower advance, as ESPHome's fonts do for bytes they have no glyph for.
+
+namespace esphome {
+namespace font {
+
+class Font : public display::BaseFont {
+  public:
+    static constexpr int GLYPH_ADVANCE = 6;
+    static constexpr int UNKNOWN_ADVANCE = 3;
+
+    void print(int x_start, int y_start, display::Display *display, Color color, const char *text,
+               Color background) override;
+    void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) override;
+
+    int get_baseline() { return this->get_ascender(); }
+    int get_height() { return this->get_ascender() + this->get_descender(); }
+    int get_ascender() { return 12; }
+    int get_descender() { return 4; }
+};
+
+}  // namespace font
+}  // namespace esphome
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+
+// Host stand-in for esphome/components/http_request/http_request.h: the
+// response container the connection manager's responses derive from
+
+namespace esphome {
+namespace http_request {
+
+struct Header {
+  std::string name;
+  std::string value;
+};
+
+class HttpContainer {
+  public:
+    virtual ~HttpContainer() = default;
+
+    size_t content_length;
+    int status_code;
+    uint32_t duration_ms;
+
+    // Bytes read into buf, 0 if none are available yet, negative at the end
+    virtual int read(uint8_t *buf, size_t max_len) = 0;
+    virtual void end() = 0;
+
+    virtual std::string get_response_header(const std::string &header_name) {
+      auto it = this->response_headers_.find(header_name);
+      return it == this->response_headers_.end() || it->second.empty() ? "" : it->second.front();
+    }
+    size_t get_bytes_read() const { return this->bytes_read_; }
+
+  protected:
+    size_t bytes_read_{0};
+    std::map<std::string, std::list<std::string>> response_headers_{};
+};
+
+}  // namespace http_request
+}  // namespace esphome
@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in for esphome/components/network/util.h: connected unless a
+// program says otherwise
+
+namespace esphome {
+namespace network {
+
+inline bool host_connected = true;
+
+inline bool is_connected() { return host_connected; }
+
+}  // namespace network
+}  // namespace esphome
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <ctime>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "esphome/core/component.h"
+#include "esphome/core/time.h"
+
+// Host stand-in for esphome/components/time/real_time_clock.h: a clock a
+// program sets, which reads as invalid (1970) until it does
+
+namespace esphome {
+namespace time {
+
+class RealTimeClock : public Component {
+  public:
+    ESPTime now() { return ESPTime::from_epoch_local(this->now_); }
+    ESPTime utcnow() { return ESPTime::from_epoch_utc(this->now_); }
+
+    void add_on_time_sync_callback(std::function<void()> &&callback) {
+      this->time_sync_callbacks_.push_back(std::move(callback));
+    }
+
+    // As a time source syncing the clock: sets it and runs the sync callbacks
+    void synchronize_epoch(time_t epoch) {
+      this->now_ = epoch;
+      for (auto &callback : this->time_sync_callbacks_) {
+        callback();
+      }
+    }
+    void set_epoch(time_t epoch) { this->now_ = epoch; }
+
+  protected:
+    time_t now_ = 0;
+    std::vector<std::function<void()>> time_sync_callbacks_;
+};
+
+}  // namespace time
+}  // namespace esphome
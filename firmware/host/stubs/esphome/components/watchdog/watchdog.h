@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Host stand-in for esphome/components/watchdog/watchdog.h: there is no task
+// watchdog to stretch
+
+namespace esphome {
+namespace watchdog {
+
+class WatchdogManager {
+  public:
+    explicit WatchdogManager(uint32_t timeout_ms) {}
+};
+
+}  // namespace watchdog
+}  // namespace esphome
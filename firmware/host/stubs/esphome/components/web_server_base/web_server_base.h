@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+
+// Host stand-in for esphome/components/web_server_base/web_server_base.h:
+// the request handler interface, and no server to register handlers with
+
+class AsyncWebParameter {
+  public:
+    const std::string &value() const { return this->value_; }
+
+  protected:
+    std::string value_;
+};
+
+class AsyncWebServerResponse {};
+
+class AsyncWebServerRequest {
+  public:
+    std::string url() const { return this->url_; }
+    bool hasParam(const std::string &name) { return false; }
+    AsyncWebParameter *getParam(const std::string &name) { return nullptr; }
+    AsyncWebServerResponse *beginResponse(int code, const char *content_type, const std::string &content) {
+      return nullptr;
+    }
+    void send(AsyncWebServerResponse *response) {}
+
+  protected:
+    std::string url_;
+};
+
+class AsyncWebHandler {
+  public:
+    virtual ~AsyncWebHandler() = default;
+    virtual bool canHandle(AsyncWebServerRequest *request) const { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *request) {}
+};
+
+class AsyncWebServer {
+  public:
+    void addHandler(AsyncWebHandler *handler) {}
+};
+
+namespace esphome {
+namespace web_server_base {
+
+class WebServerBase {
+  public:
+    AsyncWebServer *get_server() { return nullptr; }
+};
+
+inline WebServerBase *global_web_server_base = nullptr;
+
+}  // namespace web_server_base
+}  // namespace esphome
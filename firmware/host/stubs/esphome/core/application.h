@@ -0,0 +1,19 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+// Host stand-in for esphome/core/application.h
+
+namespace esphome {
+
+class Application {
+  public:
+    void feed_wdt() {}
+    void reboot() {}
+    void safe_reboot() {}
+};
+
+inline Application App;
+
+}  // namespace esphome
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+// Host stand-in for esphome/core/color.h
+
+namespace esphome {
+
+struct Color {
+  union {
+    struct {
+      uint8_t r;
+      uint8_t g;
+      uint8_t b;
+      uint8_t w;
+    };
+    uint32_t raw_32;
+  };
+
+  constexpr Color() : r(0), g(0), b(0), w(0) {}
+  constexpr Color(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue), w(0) {}
+  constexpr Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) : r(red), g(green), b(blue), w(white) {}
+  constexpr Color(uint32_t colorcode)
+      : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF), w((colorcode >> 24) & 0xFF) {}
+
+  bool operator==(const Color &rhs) const { return this->raw_32 == rhs.raw_32; }
+  bool operator!=(const Color &rhs) const { return this->raw_32 != rhs.raw_32; }
+};
+
+static const Color COLOR_BLACK(0, 0, 0, 0);
+static const Color COLOR_OFF(0, 0, 0, 0);
+static const Color COLOR_WHITE(255, 255, 255, 255);
+
+}  // namespace esphome
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "esphome/core/hal.h"
+
+// Host stand-in for esphome/core/component.h. Timeouts, intervals and
+// deferred calls are dropped: a program drives the component itself.
+
+namespace esphome {
+
+namespace setup_priority {
+static const float BUS = 1000.0f;
+static const float HARDWARE = 800.0f;
+static const float DATA = 600.0f;
+static const float PROCESSOR = 400.0f;
+static const float WIFI = 250.0f;
+static const float AFTER_WIFI = 200.0f;
+static const float AFTER_CONNECTION = 100.0f;
+static const float LATE = -100.0f;
+}  // namespace setup_priority
+
+class Component {
+  public:
+    virtual ~Component() = default;
+
+    virtual void setup() {}
+    virtual void loop() {}
+    virtual void dump_config() {}
+    virtual void on_shutdown() {}
+    virtual float get_setup_priority() const { return setup_priority::DATA; }
+
+    void mark_failed() { this->failed_ = true; }
+    bool is_failed() const { return this->failed_; }
+
+    void status_set_error(const char *message = nullptr) { this->error_ = true; }
+    void status_clear_error() { this->error_ = false; }
+    bool status_has_error() const { return this->error_; }
+    void status_set_warning(const char *message = nullptr) { this->warning_ = true; }
+    void status_clear_warning() { this->warning_ = false; }
+    bool status_has_warning() const { return this->warning_; }
+
+  protected:
+    void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f) {}
+    bool cancel_interval(const std::string &name) { return false; }
+    void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {}
+    bool cancel_timeout(const std::string &name) { return false; }
+    void defer(std::function<void()> &&f) {}
+    void defer(const std::string &name, std::function<void()> &&f) {}
+
+    bool failed_ = false;
+    bool error_ = false;
+    bool warning_ = false;
+};
+
+class PollingComponent : public Component {
+  public:
+    PollingComponent() = default;
+    explicit PollingComponent(uint32_t update_interval) : update_interval_(update_interval) {}
+
+    virtual void update() = 0;
+    void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+    uint32_t get_update_interval() const { return this->update_interval_; }
+
+  protected:
+    uint32_t update_interval_ = 0;
+};
+
+}  // namespace esphome
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host stand-in for the generated esphome/core/defines.h: no optional
+// components are enabled unless a program defines them on the command line
@@ -0,0 +1,43 @@
+#include "hal.h"
+
+#include <chrono>
+#include <thread>
+
+namespace esphome {
+
+static uint64_t now_us = 0;
+// Set once a program switches to the host's clock; time then counts from here
+static bool real_time = false;
+static std::chrono::steady_clock::time_point booted_at;
+
+static uint64_t uptime_us() {
+  if (!real_time) {
+    return now_us;
+  }
+  auto uptime = std::chrono::steady_clock::now() - booted_at;
+  return std::chrono::duration_cast<std::chrono::microseconds>(uptime).count();
+}
+
+uint32_t millis() { return static_cast<uint32_t>(uptime_us() / 1000); }
+uint32_t micros() { return static_cast<uint32_t>(uptime_us()); }
+void delay(uint32_t ms) { host::advance(ms); }
+
+namespace host {
+void advance(uint32_t ms) {
+  if (real_time) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  } else {
+    now_us += static_cast<uint64_t>(ms) * 1000;
+  }
+}
+void reboot() {
+  now_us = 0;
+  booted_at = std::chrono::steady_clock::now();
+}
+void use_real_time() {
+  real_time = true;
+  booted_at = std::chrono::steady_clock::now();
+}
+}  // namespace host
+
+}  // namespace esphome
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Host stand-in for esphome/core/hal.h. Time is simulated: it only moves when a
+// program calls delay() or host::advance(), so runs are repeatable. A program
+// that talks to real servers can have it follow the host's clock instead.
+
+namespace esphome {
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+namespace host {
+void advance(uint32_t ms);
+// Back to 0, as after a reboot
+void reboot();
+// From now on, time is the host's monotonic clock and delay() sleeps
+void use_real_time();
+}  // namespace host
+
+}  // namespace esphome
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Host stand-in for esphome/core/helpers.h: only what the components under test use
+
+#define HOT __attribute__((hot))
+#define ALWAYS_INLINE __attribute__((always_inline))
+
+// Arduino.h, which the Arduino framework puts in front of every file, brings these in
+using std::max;
+using std::min;
+
+namespace esphome {
+
+// Seeded the same every run, so runs are repeatable
+inline uint32_t random_uint32() {
+  static std::mt19937 generator;
+  return generator();
+}
+
+template<typename... Ts> class CallbackManager;
+
+template<typename... Ts> class CallbackManager<void(Ts...)> {
+  public:
+    void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+    void call(Ts... args) {
+      for (auto &callback : this->callbacks_) {
+        callback(args...);
+      }
+    }
+    size_t size() const { return this->callbacks_.size(); }
+
+  protected:
+    std::vector<std::function<void(Ts...)>> callbacks_;
+};
+
+}  // namespace esphome
@@ -0,0 +1,12 @@
+#pragma once
+
+// Host stand-in for esphome/core/log.h. Logging compiles to nothing, so a
+// benchmark or test measures the code and not printf.
+
+#define ESP_LOGE(tag, ...) ((void) (tag))
+#define ESP_LOGW(tag, ...) ((void) (tag))
+#define ESP_LOGI(tag, ...) ((void) (tag))
+#define ESP_LOGD(tag, ...) ((void) (tag))
+#define ESP_LOGV(tag, ...) ((void) (tag))
+#define ESP_LOGVV(tag, ...) ((void) (tag))
+#define ESP_LOGCONFIG(tag, ...) ((void) (tag))
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+// Host stand-in for esphome/core/time.h: the fields the trackers read
+
+namespace esphome {
+
+struct ESPTime {
+  uint8_t second;
+  uint8_t minute;
+  uint8_t hour;
+  uint8_t day_of_week;
+  uint8_t day_of_month;
+  uint16_t day_of_year;
+  uint8_t month;
+  uint16_t year;
+  bool is_dst;
+  time_t timestamp;
+
+  // As ESPHome's: from 2019 on
+  bool is_valid() const { return this->year >= 2019; }
+
+  static ESPTime from_c_tm(struct tm *c_tm, time_t c_time) {
+    ESPTime res{};
+    res.second = c_tm->tm_sec;
+    res.minute = c_tm->tm_min;
+    res.hour = c_tm->tm_hour;
+    res.day_of_week = c_tm->tm_wday + 1;
+    res.day_of_month = c_tm->tm_mday;
+    res.day_of_year = c_tm->tm_yday + 1;
+    res.month = c_tm->tm_mon + 1;
+    res.year = c_tm->tm_year + 1900;
+    res.is_dst = c_tm->tm_isdst;
+    res.timestamp = c_time;
+    return res;
+  }
+  static ESPTime from_epoch_local(time_t epoch) {
+    struct tm c_tm;
+    localtime_r(&epoch, &c_tm);
+    return from_c_tm(&c_tm, epoch);
+  }
+  static ESPTime from_epoch_utc(time_t epoch) {
+    struct tm c_tm;
+    gmtime_r(&epoch, &c_tm);
+    return from_c_tm(&c_tm, epoch);
+  }
+};
+
+}  // namespace esphome
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+
+#include <cstdlib>
+#include <functional>
+
+// Host stand-in for lwIP's netdb.h. Names are looked up by the resolver a
+// program installs, which may take as long as it likes; without one, every
+// lookup fails. Every name that resolves is the host's loopback address.
+
+namespace esphome {
+namespace host {
+// True if the name resolves
+inline std::function<bool(const char *name)> resolver;
+}  // namespace host
+}  // namespace esphome
+
+inline int lwip_getaddrinfo(const char *nodename, const char *servname, const struct addrinfo *hints,
+                            struct addrinfo **res) {
+  *res = nullptr;
+  if (!esphome::host::resolver || !esphome::host::resolver(nodename)) {
+    return EAI_FAIL;
+  }
+  auto *address = new sockaddr_in{};
+  address->sin_family = AF_INET;
+  address->sin_port = htons(servname != nullptr ? atoi(servname) : 0);
+  address->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  *res = new addrinfo{};
+  (*res)->ai_family = AF_INET;
+  (*res)->ai_socktype = hints != nullptr ? hints->ai_socktype : SOCK_STREAM;
+  (*res)->ai_addr = reinterpret_cast<sockaddr *>(address);
+  (*res)->ai_addrlen = sizeof(*address);
+  return 0;
+}
+
+inline void lwip_freeaddrinfo(struct addrinfo *ai) {
+  delete reinterpret_cast<sockaddr_in *>(ai->ai_addr);
+  delete ai;
+}
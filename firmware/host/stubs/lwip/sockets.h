@@ -0,0 +1,29 @@
+#pragma once
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Host stand-in for lwIP's sockets.h: the lwip_ calls are the host's own
+
+inline int lwip_socket(int domain, int type, int protocol) { return socket(domain, type, protocol); }
+inline int lwip_connect(int s, const struct sockaddr *name, socklen_t namelen) { return connect(s, name, namelen); }
+inline int lwip_fcntl(int s, int cmd, int val) { return fcntl(s, cmd, val); }
+inline int lwip_getsockopt(int s, int level, int optname, void *optval, socklen_t *optlen) {
+  return getsockopt(s, level, optname, optval, optlen);
+}
+inline int lwip_setsockopt(int s, int level, int optname, const void *optval, socklen_t optlen) {
+  return setsockopt(s, level, optname, optval, optlen);
+}
+inline int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset, struct timeval *timeout) {
+  return select(maxfdp1, readset, writeset, exceptset, timeout);
+}
+// MSG_NOSIGNAL, so a peer that hung up fails the send rather than killing the program
+inline ssize_t lwip_send(int s, const void *data, size_t size, int flags) {
+  return send(s, data, size, flags | MSG_NOSIGNAL);
+}
+inline ssize_t lwip_recv(int s, void *mem, size_t len, int flags) { return recv(s, mem, len, flags); }
+inline int lwip_close(int s) { return close(s); }
@@ -0,0 +1,7 @@
+#pragma once
+
+// Host stand-in for mbedtls/net_sockets.h: only its error codes
+
+#define MBEDTLS_ERR_NET_SEND_FAILED -0x004E
+#define MBEDTLS_ERR_NET_RECV_FAILED -0x004C
+#define MBEDTLS_ERR_NET_CONN_RESET -0x0050
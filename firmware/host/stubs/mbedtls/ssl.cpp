@@ -0,0 +1,230 @@
+#include "ssl.h"
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+// Host stand-in for mbedtls's TLS client, on OpenSSL. The socket I/O goes
+// through the callbacks given to mbedtls_ssl_set_bio(), via a BIO that calls
+// them; the random numbers are OpenSSL's own.
+
+static int bio_write(BIO *bio, const char *buf, int len) {
+  auto *ssl = static_cast<mbedtls_ssl_context *>(BIO_get_data(bio));
+  BIO_clear_retry_flags(bio);
+  int result = ssl->f_send(ssl->p_bio, reinterpret_cast<const unsigned char *>(buf), len);
+  if (result == MBEDTLS_ERR_SSL_WANT_READ || result == MBEDTLS_ERR_SSL_WANT_WRITE) {
+    BIO_set_retry_write(bio);
+    return -1;
+  }
+  if (result < 0) {
+    ssl->bio_error = result;
+    return -1;
+  }
+  return result;
+}
+
+static int bio_read(BIO *bio, char *buf, int len) {
+  auto *ssl = static_cast<mbedtls_ssl_context *>(BIO_get_data(bio));
+  BIO_clear_retry_flags(bio);
+  int result = ssl->f_recv(ssl->p_bio, reinterpret_cast<unsigned char *>(buf), len);
+  if (result == MBEDTLS_ERR_SSL_WANT_READ || result == MBEDTLS_ERR_SSL_WANT_WRITE) {
+    BIO_set_retry_read(bio);
+    return -1;
+  }
+  if (result < 0) {
+    ssl->bio_error = result;
+    return -1;
+  }
+  return result;
+}
+
+static long bio_ctrl(BIO *, int cmd, long, void *) { return cmd == BIO_CTRL_FLUSH ? 1 : 0; }
+
+static int bio_create(BIO *bio) {
+  BIO_set_init(bio, 1);
+  return 1;
+}
+
+static BIO_METHOD *bio_method() {
+  static BIO_METHOD *method = [] {
+    BIO_METHOD *method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "mbedtls callbacks");
+    BIO_meth_set_write(method, bio_write);
+    BIO_meth_set_read(method, bio_read);
+    BIO_meth_set_ctrl(method, bio_ctrl);
+    BIO_meth_set_create(method, bio_create);
+    return method;
+  }();
+  return method;
+}
+
+// The mbedtls return value for an OpenSSL call that returned result
+static int ssl_error(mbedtls_ssl_context *ssl, int result) {
+  int error = SSL_get_error(ssl->ssl, result);
+  ERR_clear_error();
+  switch (error) {
+    case SSL_ERROR_WANT_READ:
+      return MBEDTLS_ERR_SSL_WANT_READ;
+    case SSL_ERROR_WANT_WRITE:
+      return MBEDTLS_ERR_SSL_WANT_WRITE;
+    case SSL_ERROR_ZERO_RETURN:
+      return MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY;
+    default:
+      return ssl->bio_error != 0 ? ssl->bio_error : MBEDTLS_ERR_SSL_HANDSHAKE_FAILURE;
+  }
+}
+
+void mbedtls_ssl_config_init(mbedtls_ssl_config *conf) { conf->ctx = nullptr; }
+
+void mbedtls_ssl_config_free(mbedtls_ssl_config *conf) {
+  SSL_CTX_free(conf->ctx);
+  conf->ctx = nullptr;
+}
+
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config *conf, int endpoint, int transport, int preset) {
+  if (endpoint != MBEDTLS_SSL_IS_CLIENT || transport != MBEDTLS_SSL_TRANSPORT_STREAM) {
+    return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  }
+  conf->ctx = SSL_CTX_new(TLS_client_method());
+  return conf->ctx != nullptr ? 0 : MBEDTLS_ERR_SSL_ALLOC_FAILED;
+}
+
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config *conf, int authmode) {
+  SSL_CTX_set_verify(conf->ctx, SSL_VERIFY_NONE, nullptr);
+}
+
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config *, int (*)(void *, unsigned char *, size_t), void *) {}
+
+void mbedtls_ssl_conf_max_tls_version(mbedtls_ssl_config *conf, mbedtls_ssl_protocol_version tls_version) {
+  SSL_CTX_set_max_proto_version(conf->ctx, tls_version == MBEDTLS_SSL_VERSION_TLS1_2 ? TLS1_2_VERSION : 0);
+}
+
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config *conf, int use_tickets) {
+  if (use_tickets == MBEDTLS_SSL_SESSION_TICKETS_DISABLED) {
+    SSL_CTX_set_options(conf->ctx, SSL_OP_NO_TICKET);
+  } else {
+    SSL_CTX_clear_options(conf->ctx, SSL_OP_NO_TICKET);
+  }
+}
+
+void mbedtls_ssl_init(mbedtls_ssl_context *ssl) { *ssl = mbedtls_ssl_context{}; }
+
+void mbedtls_ssl_free(mbedtls_ssl_context *ssl) {
+  SSL_free(ssl->ssl);  // And the BIO
+  *ssl = mbedtls_ssl_context{};
+}
+
+int mbedtls_ssl_setup(mbedtls_ssl_context *ssl, const mbedtls_ssl_config *conf) {
+  ssl->ssl = SSL_new(conf->ctx);
+  if (ssl->ssl == nullptr) {
+    return MBEDTLS_ERR_SSL_ALLOC_FAILED;
+  }
+  SSL_set_connect_state(ssl->ssl);
+  return 0;
+}
+
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context *ssl, const char *hostname) {
+  return SSL_set_tlsext_host_name(ssl->ssl, hostname) == 1 ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+}
+
+void mbedtls_ssl_set_bio(mbedtls_ssl_context *ssl, void *p_bio, mbedtls_ssl_send_t *f_send,
+                         mbedtls_ssl_recv_t *f_recv, mbedtls_ssl_recv_timeout_t *) {
+  ssl->p_bio = p_bio;
+  ssl->f_send = f_send;
+  ssl->f_recv = f_recv;
+  BIO *bio = BIO_new(bio_method());
+  BIO_set_data(bio, ssl);
+  SSL_set_bio(ssl->ssl, bio, bio);
+}
+
+void mbedtls_ssl_set_export_keys_cb(mbedtls_ssl_context *ssl, mbedtls_ssl_export_keys_t *f_export_keys,
+                                    void *p_export_keys) {
+  ssl->f_export_keys = f_export_keys;
+  ssl->p_export_keys = p_export_keys;
+}
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session) { session->session = nullptr; }
+
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session) {
+  SSL_SESSION_free(session->session);
+  session->session = nullptr;
+}
+
+int mbedtls_ssl_session_load(mbedtls_ssl_session *session, const unsigned char *buf, size_t len) {
+  SSL_SESSION_free(session->session);
+  session->session = d2i_SSL_SESSION(nullptr, &buf, len);
+  return session->session != nullptr ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+}
+
+int mbedtls_ssl_session_save(const mbedtls_ssl_session *session, unsigned char *buf, size_t buf_len, size_t *olen) {
+  int size = i2d_SSL_SESSION(session->session, nullptr);
+  if (size <= 0) {
+    return MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+  }
+  *olen = size;
+  if (buf == nullptr || buf_len < (size_t) size) {
+    return MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL;
+  }
+  i2d_SSL_SESSION(session->session, &buf);
+  return 0;
+}
+
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session) {
+  return SSL_set_session(ssl->ssl, session->session) == 1 ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+}
+
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session) {
+  SSL_SESSION_free(session->session);
+  session->session = SSL_get1_session(ssl->ssl);
+  return session->session != nullptr ? 0 : MBEDTLS_ERR_SSL_BAD_INPUT_DATA;
+}
+
+int mbedtls_ssl_handshake(mbedtls_ssl_context *ssl) {
+  ssl->bio_error = 0;
+  ERR_clear_error();
+  int result = SSL_do_handshake(ssl->ssl);
+  if (result != 1) {
+    return ssl_error(ssl, result);
+  }
+
+  // mbedtls exports the master secret of every TLS 1.2 handshake, a resumed
+  // one's being the session's
+  if (ssl->f_export_keys != nullptr && SSL_version(ssl->ssl) == TLS1_2_VERSION) {
+    unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+    unsigned char client_random[32], server_random[32];
+    size_t master_len = SSL_SESSION_get_master_key(SSL_get_session(ssl->ssl), master, sizeof(master));
+    SSL_get_client_random(ssl->ssl, client_random, sizeof(client_random));
+    SSL_get_server_random(ssl->ssl, server_random, sizeof(server_random));
+    ssl->f_export_keys(ssl->p_export_keys, MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET, master, master_len,
+                       client_random, server_random, MBEDTLS_SSL_TLS_PRF_SHA256);
+  }
+  return 0;
+}
+
+int mbedtls_ssl_read(mbedtls_ssl_context *ssl, unsigned char *buf, size_t len) {
+  ssl->bio_error = 0;
+  ERR_clear_error();
+  if (len == 0) {
+    // Reads in a record without consuming it, as mbedtls does
+    unsigned char byte;
+    int result = SSL_peek(ssl->ssl, &byte, 1);
+    return result > 0 ? 0 : ssl_error(ssl, result);
+  }
+  int result = SSL_read(ssl->ssl, buf, len);
+  return result > 0 ? result : ssl_error(ssl, result);
+}
+
+int mbedtls_ssl_write(mbedtls_ssl_context *ssl, const unsigned char *buf, size_t len) {
+  ssl->bio_error = 0;
+  ERR_clear_error();
+  int result = SSL_write(ssl->ssl, buf, len);
+  return result > 0 ? result : ssl_error(ssl, result);
+}
+
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context *ssl) { return SSL_pending(ssl->ssl); }
+
+int mbedtls_ssl_close_notify(mbedtls_ssl_context *ssl) {
+  ssl->bio_error = 0;
+  ERR_clear_error();
+  int result = SSL_shutdown(ssl->ssl);
+  return result >= 0 ? 0 : ssl_error(ssl, result);
+}
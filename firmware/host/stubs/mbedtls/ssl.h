@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Host stand-in for mbedtls 3.x's ssl.h: the part of the API TlsClient uses,
+// implemented on the host's OpenSSL (ssl.cpp). The callbacks behave as they do
+// in mbedtls: the BIO callbacks return MBEDTLS_ERR_SSL_WANT_READ/WRITE, and the
+// key export callback gets the TLS 1.2 master secret on every handshake,
+// resumed ones included.
+
+struct ssl_st;
+struct ssl_ctx_st;
+struct ssl_session_st;
+
+typedef int mbedtls_ssl_send_t(void *ctx, const unsigned char *buf, size_t len);
+typedef int mbedtls_ssl_recv_t(void *ctx, unsigned char *buf, size_t len);
+typedef int mbedtls_ssl_recv_timeout_t(void *ctx, unsigned char *buf, size_t len, uint32_t timeout);
+
+enum mbedtls_ssl_key_export_type {
+  MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET = 0,
+};
+
+enum mbedtls_tls_prf_types {
+  MBEDTLS_SSL_TLS_PRF_NONE,
+  MBEDTLS_SSL_TLS_PRF_SHA384,
+  MBEDTLS_SSL_TLS_PRF_SHA256,
+};
+
+typedef enum {
+  MBEDTLS_SSL_VERSION_UNKNOWN,
+  MBEDTLS_SSL_VERSION_TLS1_2 = 0x0303,
+  MBEDTLS_SSL_VERSION_TLS1_3 = 0x0304,
+} mbedtls_ssl_protocol_version;
+
+typedef void mbedtls_ssl_export_keys_t(void *p_expkey, mbedtls_ssl_key_export_type type, const unsigned char *secret,
+                                       size_t secret_len, const unsigned char client_random[32],
+                                       const unsigned char server_random[32], mbedtls_tls_prf_types tls_prf_type);
+
+#define MBEDTLS_SSL_IS_CLIENT 0
+#define MBEDTLS_SSL_TRANSPORT_STREAM 0
+#define MBEDTLS_SSL_PRESET_DEFAULT 0
+#define MBEDTLS_SSL_VERIFY_NONE 0
+#define MBEDTLS_SSL_SESSION_TICKETS_DISABLED 0
+#define MBEDTLS_SSL_SESSION_TICKETS_ENABLED 1
+
+#define MBEDTLS_ERR_SSL_BAD_INPUT_DATA -0x7100
+#define MBEDTLS_ERR_SSL_BUFFER_TOO_SMALL -0x6A00
+#define MBEDTLS_ERR_SSL_ALLOC_FAILED -0x7F00
+#define MBEDTLS_ERR_SSL_HANDSHAKE_FAILURE -0x6E00
+#define MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY -0x7880
+#define MBEDTLS_ERR_SSL_WANT_READ -0x6900
+#define MBEDTLS_ERR_SSL_WANT_WRITE -0x6880
+
+struct mbedtls_ssl_config {
+  ssl_ctx_st *ctx;
+};
+
+struct mbedtls_ssl_context {
+  ssl_st *ssl;
+  void *p_bio;
+  mbedtls_ssl_send_t *f_send;
+  mbedtls_ssl_recv_t *f_recv;
+  mbedtls_ssl_export_keys_t *f_export_keys;
+  void *p_export_keys;
+  int bio_error;  // The last WANT_READ/WRITE or error a BIO callback returned
+};
+
+struct mbedtls_ssl_session {
+  ssl_session_st *session;
+};
+
+void mbedtls_ssl_config_init(mbedtls_ssl_config *conf);
+void mbedtls_ssl_config_free(mbedtls_ssl_config *conf);
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config *conf, int endpoint, int transport, int preset);
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config *conf, int authmode);
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config *conf, int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+void mbedtls_ssl_conf_max_tls_version(mbedtls_ssl_config *conf, mbedtls_ssl_protocol_version tls_version);
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config *conf, int use_tickets);
+
+void mbedtls_ssl_init(mbedtls_ssl_context *ssl);
+void mbedtls_ssl_free(mbedtls_ssl_context *ssl);
+int mbedtls_ssl_setup(mbedtls_ssl_context *ssl, const mbedtls_ssl_config *conf);
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context *ssl, const char *hostname);
+void mbedtls_ssl_set_bio(mbedtls_ssl_context *ssl, void *p_bio, mbedtls_ssl_send_t *f_send,
+                         mbedtls_ssl_recv_t *f_recv, mbedtls_ssl_recv_timeout_t *f_recv_timeout);
+void mbedtls_ssl_set_export_keys_cb(mbedtls_ssl_context *ssl, mbedtls_ssl_export_keys_t *f_export_keys,
+                                    void *p_export_keys);
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session *session);
+void mbedtls_ssl_session_free(mbedtls_ssl_session *session);
+int mbedtls_ssl_session_load(mbedtls_ssl_session *session, const unsigned char *buf, size_t len);
+int mbedtls_ssl_session_save(const mbedtls_ssl_session *session, unsigned char *buf, size_t buf_len, size_t *olen);
+int mbedtls_ssl_set_session(mbedtls_ssl_context *ssl, const mbedtls_ssl_session *session);
+int mbedtls_ssl_get_session(const mbedtls_ssl_context *ssl, mbedtls_ssl_session *session);
+
+int mbedtls_ssl_handshake(mbedtls_ssl_context *ssl);
+int mbedtls_ssl_read(mbedtls_ssl_context *ssl, unsigned char *buf, size_t len);
+int mbedtls_ssl_write(mbedtls_ssl_context *ssl, const unsigned char *buf, size_t len);
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context *ssl);
+int mbedtls_ssl_close_notify(mbedtls_ssl_context *ssl);
@@ -0,0 +1,203 @@
+// Host test for connection_manager::TlsClient, built and run by
+// `python run_host.py tls_handshake_test`.
+//
+// Builds the real TlsClient and TlsSessionCache, with mbedtls standing in on
+// the host's OpenSSL (stubs/mbedtls), and connects to tools/tls_stand_in.py a
+// few times in a row. The stand-in logs whether it resumed each handshake;
+// the client must agree, which checks that comparing master secret
+// fingerprints tells a resumption from a full handshake. Goes through:
+//  - resuming a session ticket, then a session ID (--no-tickets)
+//  - a reboot, after which the sessions come back from the RTC copy
+//  - a restarted server that no longer knows the session offered, where the
+//    handshake is a full one and must be reported as such
+// Reports the full and resumed handshake times on loopback, so they show what
+// the handshake costs the CPU rather than the network.
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "esphome/components/connection_manager/tls_client.h"
+#include "esphome/components/connection_manager/tls_session_cache.h"
+#include "esphome/core/hal.h"
+#include "lwip/netdb.h"
+
+using esphome::connection_manager::TlsClient;
+using esphome::connection_manager::TlsSessionCache;
+
+static const std::string STAND_IN = std::string(__FILE__).substr(0, std::string(__FILE__).rfind('/')) +
+                                    "/../../tools/tls_stand_in.py";
+
+// tools/tls_stand_in.py in a child process, forwarding to a port nobody listens on
+class StandIn {
+  public:
+    StandIn(int port, bool tickets) {
+      int fds[2];
+      if (pipe(fds) != 0) {
+        return;
+      }
+      std::string listen = std::to_string(port) + ":" + std::to_string(port + 1);
+      this->pid_ = fork();
+      if (this->pid_ == 0) {
+        // A program started in the background ignores SIGINT, and so would the stand-in
+        signal(SIGINT, SIG_DFL);
+        dup2(fds[1], STDOUT_FILENO);
+        freopen("/dev/null", "w", stderr);
+        close(fds[0]);
+        close(fds[1]);
+        if (tickets) {
+          execlp("python3", "python3", "-u", STAND_IN.c_str(), "--listen", listen.c_str(), nullptr);
+        } else {
+          execlp("python3", "python3", "-u", STAND_IN.c_str(), "--listen", listen.c_str(), "--no-tickets", nullptr);
+        }
+        _exit(127);
+      }
+      close(fds[1]);
+      this->output_ = fdopen(fds[0], "r");
+    }
+    ~StandIn() {
+      if (this->pid_ > 0) {
+        // SIGINT, so it removes its certificate on the way out
+        kill(this->pid_, SIGINT);
+        waitpid(this->pid_, nullptr, 0);
+      }
+      if (this->output_ != nullptr) {
+        fclose(this->output_);
+      }
+    }
+
+    // True once it is listening
+    bool ready() { return this->next_line_("TLS :").find("TLS :") == 0; }
+
+    // "full" or "resumed" for the next handshake it logs, empty if it failed
+    std::string next_handshake() {
+      std::string line = this->next_line_("handshake");
+      for (const char *kind : {"full", "resumed"}) {
+        if (line.find(std::string(": ") + kind + " handshake") != std::string::npos) {
+          return kind;
+        }
+      }
+      return "";
+    }
+
+  protected:
+    std::string next_line_(const char *containing) {
+      char line[512];
+      while (this->output_ != nullptr && fgets(line, sizeof(line), this->output_) != nullptr) {
+        if (strstr(line, containing) != nullptr) {
+          return line;
+        }
+      }
+      return "";
+    }
+
+    pid_t pid_ = -1;
+    FILE *output_ = nullptr;
+};
+
+struct Times {
+  int count = 0;
+  double total_ms = 0;
+  void add(double ms) {
+    this->count++;
+    this->total_ms += ms;
+  }
+};
+
+static Times full_times, resumed_times;
+
+// Connects once, expecting the handshake to be resumed or not
+static bool handshake(const char *name, int port, StandIn &stand_in, TlsSessionCache &sessions, bool expect_resumed) {
+  TlsClient client;
+  client.set_session_cache(&sessions);
+  auto started = std::chrono::steady_clock::now();
+  bool connected = client.connect("localhost", port) == 1;
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+  client.stop();
+  if (!connected) {
+    printf("  %-36s could not connect\n", name);
+    return false;
+  }
+
+  std::string server = stand_in.next_handshake();
+  const char *kind = client.was_resumed() ? "resumed" : "full";
+  (client.was_resumed() ? resumed_times : full_times).add(ms);
+  printf("  %-36s %-8s %6.2f ms\n", name, kind, ms);
+  if (server != kind) {
+    printf("    but the server says %s\n", server.empty() ? "it failed" : server.c_str());
+    return false;
+  }
+  if (client.was_resumed() != expect_resumed) {
+    printf("    expected a %s handshake\n", expect_resumed ? "resumed" : "full");
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  esphome::host::use_real_time();
+  esphome::host::resolver = [](const char *) { return true; };
+  // The stand-in takes port + 1 as its upstream, which nothing listens on
+  const int port = 20000 + getpid() % 10000 * 2;
+
+  bool ok = true;
+  TlsSessionCache sessions;
+  sessions.set_persist(true);
+
+  {
+    printf("session tickets\n");
+    StandIn stand_in(port, true);
+    if (!stand_in.ready()) {
+      printf("Could not start %s; it needs python3 and openssl\n", STAND_IN.c_str());
+      return 1;
+    }
+    ok &= handshake("first connection", port, stand_in, sessions, false);
+    for (int i = 0; i < 4; i++) {
+      ok &= handshake("reconnect", port, stand_in, sessions, true);
+    }
+
+    // The sessions in RAM are gone, the ones in RTC memory are not
+    esphome::host::reboot();
+    TlsSessionCache rebooted;
+    rebooted.set_persist(true);
+    rebooted.restore();
+    ok &= handshake("after a reboot", port, stand_in, rebooted, true);
+  }
+
+  {
+    // New ticket keys and no session cache: the session offered is unknown
+    StandIn stand_in(port, true);
+    ok &= stand_in.ready();
+    ok &= handshake("server restarted", port, stand_in, sessions, false);
+    ok &= handshake("reconnect", port, stand_in, sessions, true);
+  }
+
+  {
+    printf("session IDs\n");
+    StandIn stand_in(port, false);
+    ok &= stand_in.ready();
+    TlsSessionCache id_sessions;
+    ok &= handshake("first connection", port, stand_in, id_sessions, false);
+    for (int i = 0; i < 4; i++) {
+      ok &= handshake("reconnect", port, stand_in, id_sessions, true);
+    }
+  }
+
+  TlsSessionCache::Stats full = sessions.get_full_stats(), resumed = sessions.get_resumed_stats();
+  printf("full:    %2d handshakes, %6.2f ms on average\n", full_times.count,
+         full_times.count == 0 ? 0.0 : full_times.total_ms / full_times.count);
+  printf("resumed: %2d handshakes, %6.2f ms on average\n", resumed_times.count,
+         resumed_times.count == 0 ? 0.0 : resumed_times.total_ms / resumed_times.count);
+  if (full.count != 2 || resumed.count != 5) {
+    printf("The session cache recorded %u full and %u resumed handshakes, not 2 and 5\n", (unsigned) full.count,
+           (unsigned) resumed.count);
+    ok = false;
+  }
+  return ok ? 0 : 1;
+}
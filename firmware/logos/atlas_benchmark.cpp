@@ -0,0 +1,133 @@
+// Host benchmark for the logo atlas, built and run by
+// `python build_logo_atlas.py --benchmark`.
+//
+// Decodes every logo into a row buffer shaped like matrix_render::SpanBuffer,
+// once through the atlas (palettized RLE runs) and once the way an ESPHome RGB
+// image with an alpha channel is drawn today (get_pixel() per pixel, alpha
+// test, RGB565 conversion). Reports the time per logo, the storage used by each
+// format, and how many pixels differ after palette reduction.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include ATLAS_HEADER
+#include "reference_logos.h"
+
+using esphome::matrix_render::RleImage;
+using esphome::matrix_render::LOGO_ATLAS;
+using esphome::matrix_render::LOGO_ATLAS_PALETTES;
+using esphome::matrix_render::LOGO_ATLAS_RUNS;
+
+static constexpr int LOGO_COUNT = sizeof(LOGO_ATLAS) / sizeof(LOGO_ATLAS[0]);
+static_assert(LOGO_COUNT == sizeof(REFERENCE_LOGOS) / sizeof(REFERENCE_LOGOS[0]), "atlas and reference differ");
+
+struct Row {
+  uint16_t pixels[256];
+  uint8_t covered[32];
+
+  void begin(int width) { memset(this->covered, 0, (width + 7) / 8); }
+  void set(int x, uint16_t rgb565) {
+    this->pixels[x] = rgb565;
+    this->covered[x >> 3] |= 1 << (x & 7);
+  }
+  bool is_covered(int x) const { return this->covered[x >> 3] & (1 << (x & 7)); }
+};
+
+struct Color {
+  uint8_t r, g, b, w;
+};
+
+// Mirrors image::Image::get_pixel() for IMAGE_TYPE_RGB with an alpha channel
+static Color __attribute__((noinline)) get_pixel(const ReferenceLogo &logo, int x, int y) {
+  if (x < 0 || x >= logo.width || y < 0 || y >= logo.height)
+    return {0, 0, 0, 0};
+  const uint8_t *p = logo.rgba + (x + y * logo.width) * 4;
+  return {p[0], p[1], p[2], p[3]};
+}
+
+static uint16_t to_rgb565(Color color) {
+  return ((color.r & 0xF8) << 8) | ((color.g & 0xFC) << 3) | (color.b >> 3);
+}
+
+template<typename F> static void draw_reference(const ReferenceLogo &logo, F &&flush) {
+  Row row;
+  for (int y = 0; y < logo.height; y++) {
+    row.begin(logo.width);
+    for (int x = 0; x < logo.width; x++) {
+      Color color = get_pixel(logo, x, y);
+      if (color.w >= 0x80)
+        row.set(x, to_rgb565(color));
+    }
+    flush(y, row);
+  }
+}
+
+template<typename F> static void draw_atlas(const RleImage &image, F &&flush) {
+  Row row;
+  const uint8_t *runs = image.runs;
+  for (int y = 0; y < image.height; y++) {
+    row.begin(image.width);
+    runs = esphome::matrix_render::rle_decode_row(image, runs, [&](int col, int length, uint8_t index) {
+      if (index != esphome::matrix_render::RLE_TRANSPARENT) {
+        for (int x = col; x < col + length; x++)
+          row.set(x, image.palette[index]);
+      }
+    });
+    flush(y, row);
+  }
+}
+
+template<typename F> static double time_per_logo(int iterations, F &&draw_all) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    draw_all();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / (double(iterations) * LOGO_COUNT);
+}
+
+int main() {
+  // Accuracy: compare coverage and colors pixel by pixel
+  int pixels = 0, coverage_diffs = 0, color_diffs = 0;
+  for (int i = 0; i < LOGO_COUNT; i++) {
+    static Row expected[256];
+    draw_reference(REFERENCE_LOGOS[i], [&](int y, const Row &row) { expected[y] = row; });
+    draw_atlas(LOGO_ATLAS[i].image, [&](int y, const Row &row) {
+      for (int x = 0; x < LOGO_ATLAS[i].image.width; x++) {
+        pixels++;
+        if (row.is_covered(x) != expected[y].is_covered(x)) {
+          coverage_diffs++;
+        } else if (row.is_covered(x) && row.pixels[x] != expected[y].pixels[x]) {
+          color_diffs++;
+        }
+      }
+    });
+  }
+
+  // Speed: a checksum of every flushed row keeps the work from being optimized out
+  volatile uint32_t sink = 0;
+  auto consume = [&](int y, const Row &row) { sink = sink + row.pixels[y % 16] + row.covered[0]; };
+  const int iterations = 20000;
+  double reference_ns = time_per_logo(iterations, [&] {
+    for (const auto &logo : REFERENCE_LOGOS)
+      draw_reference(logo, consume);
+  });
+  double atlas_ns = time_per_logo(iterations, [&] {
+    for (const auto &logo : LOGO_ATLAS)
+      draw_atlas(logo.image, consume);
+  });
+
+  size_t reference_bytes = 0;
+  for (const auto &logo : REFERENCE_LOGOS)
+    reference_bytes += logo.width * logo.height * 4;
+  size_t atlas_bytes = sizeof(LOGO_ATLAS_PALETTES) + sizeof(LOGO_ATLAS_RUNS);
+
+  printf("%d logos, %d pixels\n", LOGO_COUNT, pixels);
+  printf("  storage  RGB + alpha: %6zu B   atlas: %6zu B  (%.1fx smaller)\n", reference_bytes, atlas_bytes,
+         double(reference_bytes) / atlas_bytes);
+  printf("  decode   get_pixel:   %6.1f ns  atlas: %6.1f ns per logo  (%.1fx faster)\n", reference_ns, atlas_ns,
+         reference_ns / atlas_ns);
+  printf("  accuracy %d coverage and %d color differences from palette reduction\n", coverage_diffs, color_diffs);
+  return coverage_diffs == 0 ? 0 : 1;
+}
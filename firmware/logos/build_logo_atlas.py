@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""
+Logo atlas builder
+
+Packs every logo in a directory into one generated C++ header for the
+soccer_tracker component. Each logo gets its own palette of up to 15 colors
+(index 0 is transparent) and its rows are run-length encoded, one byte per
+run: high nibble = run length - 1, low nibble = palette index. The runtime
+decoder is matrix_render::blit_image(display, x, y, const RleImage &).
+
+Usage:
+    python build_logo_atlas.py [<dir>] [--output <header>] [--benchmark]
+
+    <dir>        directory of logo images (default: teams_resized)
+    --output     header to write
+                 (default: ../components/matrix_render/logo_atlas.h)
+    --benchmark  also build and run the host benchmark (atlas_benchmark.cpp)
+                 comparing the atlas decoder with per-pixel RGBA images
+
+Logo names come from the filenames: "atlanta-united-footballlogos-org_14x14.png"
+is registered as "atlanta united".
+"""
+
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+from collections import Counter
+from pathlib import Path
+from typing import List, Tuple
+
+try:
+    from PIL import Image
+except ImportError:
+    print("Error: PIL (Pillow) is required. Install it with: pip install Pillow")
+    sys.exit(1)
+
+SUPPORTED_EXTS = {".png", ".jpg", ".jpeg", ".bmp", ".gif", ".webp"}
+
+HERE = Path(__file__).resolve().parent
+COMPONENTS_DIR = HERE.parent / "components"
+DEFAULT_INPUT = HERE / "teams_resized"
+DEFAULT_OUTPUT = COMPONENTS_DIR / "matrix_render" / "logo_atlas.h"
+
+MAX_COLORS = 15  # plus the transparent index 0
+MAX_RUN = 16
+ALPHA_THRESHOLD = 0x80  # same cut-off as matrix_render::blit_image()
+
+
+def logo_name(path: Path) -> str:
+    stem = re.sub(r"_\d+x\d+$", "", path.stem)
+    stem = stem.replace("-footballlogos-org", "")
+    return stem.replace("-", " ").replace("_", " ").strip()
+
+
+def to_rgb565(rgb: Tuple[int, int, int]) -> int:
+    r, g, b = rgb
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def load_rgba(path: Path) -> Image.Image:
+    img = Image.open(path)
+    if getattr(img, "is_animated", False):
+        img.seek(0)
+    return img.convert("RGBA")
+
+
+def build_palette(img: Image.Image) -> Tuple[List[int], List[List[int]]]:
+    """Reduce an RGBA image to a palette of RGB565 colors and a 2D index map."""
+    width, height = img.size
+    pixels = img.load()
+    opaque = [pixels[x, y][:3] for y in range(height) for x in range(width) if pixels[x, y][3] >= ALPHA_THRESHOLD]
+
+    colors = sorted({to_rgb565(rgb) for rgb in opaque})
+    if len(colors) <= MAX_COLORS:
+        lookup = {color: i + 1 for i, color in enumerate(colors)}
+        index_of = lambda rgb: lookup[to_rgb565(rgb)]
+    else:
+        # Quantize without dithering; transparent pixels take the most common
+        # opaque color so they don't claim a palette slot
+        fill = Counter(opaque).most_common(1)[0][0]
+        rgb_img = Image.new("RGB", img.size)
+        rgb_img.putdata([pixels[x, y][:3] if pixels[x, y][3] >= ALPHA_THRESHOLD else fill
+                         for y in range(height) for x in range(width)])
+        quantized = rgb_img.quantize(colors=MAX_COLORS, method=Image.Quantize.MEDIANCUT, dither=Image.Dither.NONE)
+        raw = quantized.getpalette()
+        q_pixels = quantized.load()
+        # Merge entries that collapse to the same RGB565 value
+        remap, colors = {}, []
+        for q in sorted({q_pixels[x, y] for y in range(height) for x in range(width)}):
+            color = to_rgb565(tuple(raw[q * 3:q * 3 + 3]))
+            if color not in colors:
+                colors.append(color)
+            remap[q] = colors.index(color) + 1
+        index_at = {(x, y): remap[q_pixels[x, y]] for y in range(height) for x in range(width)}
+        index_of = None
+
+    rows = []
+    for y in range(height):
+        row = []
+        for x in range(width):
+            r, g, b, a = pixels[x, y]
+            if a < ALPHA_THRESHOLD:
+                row.append(0)
+            elif index_of is not None:
+                row.append(index_of((r, g, b)))
+            else:
+                row.append(index_at[(x, y)])
+        rows.append(row)
+
+    return [0] + colors, rows
+
+
+def encode_runs(rows: List[List[int]]) -> List[int]:
+    runs = []
+    for row in rows:
+        x = 0
+        while x < len(row):
+            index = row[x]
+            length = 1
+            while x + length < len(row) and row[x + length] == index and length < MAX_RUN:
+                length += 1
+            runs.append(((length - 1) << 4) | index)
+            x += length
+    return runs
+
+
+def format_array(values: List[int], fmt: str, per_line: int) -> str:
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt.format(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def write_atlas(logos, output: Path, source: Path) -> Tuple[int, int]:
+    palettes, runs, entries = [], [], []
+    for name, path, width, height, palette, logo_runs in logos:
+        entries.append((name, path.name, width, height, len(palettes), len(runs)))
+        palettes.extend(palette)
+        runs.extend(logo_runs)
+
+    try:
+        source_label = source.relative_to(HERE.parent).as_posix()
+    except ValueError:
+        source_label = source.name
+
+    out = [
+        "#pragma once",
+        "",
+        f"// Generated by firmware/logos/build_logo_atlas.py from {source_label}; do not edit.",
+        f"// {len(entries)} logos, {len(palettes) * 2} bytes of palettes, {len(runs)} bytes of runs",
+        "",
+        '#include "esphome/components/matrix_render/rle_image.h"',
+        "",
+        "namespace esphome {",
+        "namespace matrix_render {",
+        "",
+        "struct AtlasLogo {",
+        "  const char *name;",
+        "  RleImage image;",
+        "};",
+        "",
+        "static constexpr uint16_t LOGO_ATLAS_PALETTES[] = {",
+        format_array(palettes, "0x{:04X}", 12),
+        "};",
+        "",
+        "static constexpr uint8_t LOGO_ATLAS_RUNS[] = {",
+        format_array(runs, "0x{:02X}", 16),
+        "};",
+        "",
+        "static constexpr AtlasLogo LOGO_ATLAS[] = {",
+    ]
+    for name, filename, width, height, palette_offset, run_offset in entries:
+        out.append(
+            f'    {{"{name}", {{{width}, {height}, LOGO_ATLAS_PALETTES + {palette_offset}, '
+            f"LOGO_ATLAS_RUNS + {run_offset}}}}},  // {filename}"
+        )
+    out += [
+        "};",
+        "",
+        "}  // namespace matrix_render",
+        "}  // namespace esphome",
+        "",
+    ]
+    output.write_text("\n".join(out), encoding="utf-8")
+    return len(palettes) * 2, len(runs)
+
+
+def write_reference(logos, path: Path) -> None:
+    """RGBA pixels of every logo, laid out like an ESPHome RGB image with an alpha channel."""
+    out = ["#pragma once", "", "#include <cstdint>", "", "struct ReferenceLogo {", "  int width;",
+           "  int height;", "  const uint8_t *rgba;", "};", ""]
+    for i, (_, src, width, height, _, _) in enumerate(logos):
+        data = list(load_rgba(src).tobytes())
+        out += [f"static const uint8_t REFERENCE_RGBA_{i}[] = {{", format_array(data, "{}", 24), "};"]
+    out.append("static const ReferenceLogo REFERENCE_LOGOS[] = {")
+    for i, (_, _, width, height, _, _) in enumerate(logos):
+        out.append(f"    {{{width}, {height}, REFERENCE_RGBA_{i}}},")
+    out += ["};", ""]
+    path.write_text("\n".join(out), encoding="utf-8")
+
+
+def run_benchmark(logos, atlas: Path) -> int:
+    compiler = shutil.which("c++") or shutil.which("g++") or shutil.which("clang++")
+    if compiler is None:
+        print("Error: --benchmark needs a host C++ compiler (c++, g++ or clang++)")
+        return 1
+
+    with tempfile.TemporaryDirectory() as tmp:
+        tmp_path = Path(tmp)
+        # Mirror the "esphome/components/..." include layout of an ESPHome build
+        (tmp_path / "esphome").mkdir()
+        (tmp_path / "esphome" / "components").symlink_to(COMPONENTS_DIR, target_is_directory=True)
+        write_reference(logos, tmp_path / "reference_logos.h")
+        binary = tmp_path / "atlas_benchmark"
+        cmd = [compiler, "-O2", "-std=c++17", f"-I{tmp_path}", f"-I{atlas.parent}",
+               f'-DATLAS_HEADER="{atlas.name}"', str(HERE / "atlas_benchmark.cpp"), "-o", str(binary)]
+        subprocess.run(cmd, check=True)
+        return subprocess.run([str(binary)]).returncode
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack logos into a palettized RLE atlas header")
+    parser.add_argument("dir", nargs="?", type=Path, default=DEFAULT_INPUT)
+    parser.add_argument("--output", type=Path, default=DEFAULT_OUTPUT)
+    parser.add_argument("--benchmark", action="store_true")
+    args = parser.parse_args()
+
+    if not args.dir.is_dir():
+        print(f"Error: '{args.dir}' is not a directory")
+        sys.exit(1)
+
+    images = sorted(p for p in args.dir.iterdir() if p.is_file() and p.suffix.lower() in SUPPORTED_EXTS)
+    if not images:
+        print(f"No image files found in '{args.dir}'")
+        sys.exit(1)
+
+    logos = []
+    rgba_bytes = 0
+    for path in images:
+        img = load_rgba(path)
+        width, height = img.size
+        if width > 255 or height > 255:
+            print(f"Error: {path.name} is {width}x{height}; atlas logos must be at most 255x255")
+            sys.exit(1)
+        palette, rows = build_palette(img)
+        logos.append((logo_name(path), path, width, height, palette, encode_runs(rows)))
+        rgba_bytes += width * height * 4
+
+    palette_bytes, run_bytes = write_atlas(logos, args.output, args.dir.resolve())
+    print(f"Packed {len(logos)} logos into {args.output}")
+    print(f"  palettes {palette_bytes} B + runs {run_bytes} B = {palette_bytes + run_bytes} B "
+          f"(RGB + alpha images: {rgba_bytes} B)")
+
+    if args.benchmark:
+        sys.exit(run_benchmark(logos, args.output))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+"""Polls a device's allocation audit and reports each scope over time.
+
+Reads /allocations.json from the alloc_audit component every interval and
+prints, per scope, the runs and allocations since the last poll:
+
+    python alloc_watch.py 192.168.1.50
+    python alloc_watch.py 192.168.1.50 --interval 10 --duration 3600
+
+Exits with status 1 as soon as a scope goes over its budget, so a soak test
+(or a script that flashes a build and watches it) fails on the first frame
+that starts allocating.
+"""
+
+import argparse
+import json
+import sys
+import time
+import urllib.request
+
+
+def fetch(url: str):
+    with urllib.request.urlopen(url, timeout=10) as response:
+        return json.load(response)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("host", help="device address")
+    parser.add_argument("--path", default="/allocations.json", help="the alloc_audit path")
+    parser.add_argument("--interval", type=float, default=30, help="seconds between polls")
+    parser.add_argument("--duration", type=float, help="stop after this many seconds (default: never)")
+    args = parser.parse_args()
+
+    url = f"http://{args.host}{args.path}"
+    started = time.monotonic()
+    previous = {}
+    while True:
+        report = fetch(url)
+        print(f"uptime {report['uptime'] / 1000:.0f}s")
+        over_budget = []
+        for scope in report["scopes"]:
+            last = previous.get(scope["name"], {"runs": 0, "allocations": 0, "overBudget": 0})
+            runs = scope["runs"] - last["runs"]
+            allocations = scope["allocations"] - last["allocations"]
+            budget = "-" if scope["budget"] is None else scope["budget"]
+            per_run = allocations / runs if runs > 0 else 0
+            print(
+                f"  {scope['name']:<18} {runs:>7} runs {per_run:>8.1f} allocations/run "
+                f"max {scope['max']:>5} budget {budget:>5}"
+            )
+            if scope["overBudget"] > last["overBudget"]:
+                over_budget.append(scope["name"])
+            previous[scope["name"]] = scope
+
+        if over_budget:
+            print(f"Over budget: {', '.join(over_budget)}")
+            sys.exit(1)
+
+        if args.duration is not None and time.monotonic() - started >= args.duration:
+            return
+        time.sleep(args.interval)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,115 @@
+"""Restarts a device and times its boot from the connection manager's timeline.
+
+Reads /boot.json, which holds the uptime at which each boot stage was first
+reached, and prints the stages in order with the time each one added:
+
+    python boot_check.py 192.168.1.50                # the current boot
+    python boot_check.py 192.168.1.50 --restart --runs 5 --budget 4
+
+With --restart, the device is restarted through the web server's restart
+button (`button: - platform: restart` with `name: "Restart"`). Each boot is
+then followed until its first content is drawn. Exits with status 1 if a boot
+takes longer than --budget seconds from network-up (DHCP) to first content,
+or never draws anything, so a script that flashes a build can fail on a slow
+startup.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+import time
+import urllib.error
+import urllib.request
+
+
+def fetch(url: str):
+    with urllib.request.urlopen(url, timeout=5) as response:
+        return json.load(response)
+
+
+def restart(host: str, button: str):
+    request = urllib.request.Request(f"http://{host}/button/{button}/press", data=b"", method="POST")
+    urllib.request.urlopen(request, timeout=5).close()
+
+
+def wait_for_boot(url: str, timeout: float, after_uptime=None):
+    """The timeline once first_content is set, or the last one seen when time runs out."""
+    deadline = time.monotonic() + timeout
+    timeline = None
+    while time.monotonic() < deadline:
+        try:
+            report = fetch(url)
+        except (urllib.error.URLError, OSError, ValueError):
+            # Down while restarting, or not serving yet
+            time.sleep(0.5)
+            continue
+        # Until the uptime drops, this is still the boot before the restart
+        if after_uptime is None or report["uptime"] < after_uptime:
+            timeline = report
+            if report["stages"].get("first_content") is not None:
+                return report
+        time.sleep(0.5)
+    return timeline
+
+
+def show(timeline) -> float | None:
+    """Prints the stages; returns seconds from DHCP to first content, or None."""
+    stages = sorted(
+        ((name, at) for name, at in timeline["stages"].items() if at is not None), key=lambda stage: stage[1]
+    )
+    previous = 0
+    for name, at in stages:
+        print(f"  {name:<14} {at:>7}ms  +{at - previous}ms")
+        previous = at
+    missing = [name for name, at in timeline["stages"].items() if at is None]
+    if missing:
+        print(f"  not reached: {', '.join(missing)}")
+
+    dhcp = timeline["stages"].get("dhcp")
+    first_content = timeline["stages"].get("first_content")
+    if dhcp is None or first_content is None:
+        return None
+    return (first_content - dhcp) / 1000
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("host", help="device address")
+    parser.add_argument("--path", default="/boot.json", help="the connection manager's boot_path")
+    parser.add_argument("--restart", action="store_true", help="restart the device before each run")
+    parser.add_argument("--button", default="restart", help="object id of the restart button")
+    parser.add_argument("--runs", type=int, default=1, help="boots to time, with --restart")
+    parser.add_argument("--budget", type=float, default=5, help="seconds allowed from DHCP to first content")
+    parser.add_argument("--timeout", type=float, default=120, help="seconds to wait for a boot to finish")
+    args = parser.parse_args()
+
+    url = f"http://{args.host}{args.path}"
+    results = []
+    for run in range(args.runs if args.restart else 1):
+        after_uptime = None
+        if args.restart:
+            after_uptime = fetch(url)["uptime"]
+            print(f"Boot {run + 1}: restarting")
+            restart(args.host, args.button)
+        timeline = wait_for_boot(url, args.timeout, after_uptime)
+        if timeline is None:
+            print("  no timeline from the device")
+            sys.exit(1)
+
+        seconds = show(timeline)
+        if seconds is None:
+            print("  nothing drawn yet")
+            sys.exit(1)
+        print(f"  first content {seconds:.2f}s after DHCP")
+        results.append(seconds)
+
+    if len(results) > 1:
+        print(f"median {statistics.median(results):.2f}s, worst {max(results):.2f}s over {len(results)} boots")
+    if max(results) > args.budget:
+        print(f"Over the {args.budget:.1f}s budget")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,6 +1,12 @@
 from datetime import datetime, timedelta, timezone
 from flask import Flask, jsonify, request, render_template_string
+import base64
+import hashlib
+import json
+import socketserver
+import struct
 import threading
+import time
 
 app = Flask(__name__)
 
@@ -39,6 +45,7 @@ TEAMS = [
 
 state = {
     "team_id": 1595,
+    "fixture_id": 1300001,
     "opponent": {
         "name": "Colorado Rapids",
     },
@@ -52,6 +59,17 @@ state = {
     "away_goals": 0,
 }
 
+# Emulated API-Football daily quota (free plan)
+DAILY_LIMIT = 100
+quota = {"day": None, "used": 0}
+
+# WebSocket push channel for live scores (soccer_tracker push_url: ws://<host>:5001)
+PUSH_PORT = 5001
+HEARTBEAT_INTERVAL = 15
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+push_clients = set()
+push_lock = threading.Lock()
+
 HTML = """
 <!doctype html>
 <title>Soccer Tracker Test Server</title>
@@ -146,7 +164,7 @@ def iso(dt: datetime) -> str:
     return dt.astimezone(timezone.utc).strftime("%Y-%m-%dT%H:%M:%S+00:00")
 
 
-def build_fixture_response():
+def api_status():
     # Map the local UI status to API-Football status codes used by firmware
     status_map = {
         "NS": "NS",
@@ -156,7 +174,18 @@ def build_fixture_response():
         "2H": "2H",
         "FT": "FT",
     }
-    status = status_map.get(state["status"], "NS")
+    return status_map.get(state["status"], "NS")
+
+
+def team_id(team) -> int:
+    # The favorite keeps the configured id; anyone else gets a stable stand-in
+    if team is state["favorite"]:
+        return state["team_id"]
+    return 9000 + TEAMS.index(team["name"]) if team["name"] in TEAMS else 9999
+
+
+def build_fixture_response():
+    status = api_status()
 
     # Determine which team is home/away based on flag
     home = state["favorite"] if state["home_is_favorite"] else state["opponent"]
@@ -166,6 +195,7 @@ def build_fixture_response():
         "response": [
             {
                 "fixture": {
+                    "id": state["fixture_id"],
                     "date": iso(state["match_time"]),
                     "status": status,
                 },
@@ -176,10 +206,12 @@ def build_fixture_response():
                 },
                 "teams": {
                     "home": {
+                        "id": team_id(home),
                         "name": home["name"],
                         "goals": state["home_goals"],
                     },
                     "away": {
+                        "id": team_id(away),
                         "name": away["name"],
                         "goals": state["away_goals"],
                     },
@@ -189,6 +221,141 @@ def build_fixture_response():
     }
 
 
+def ws_frame(opcode: int, payload: bytes) -> bytes:
+    # Server frames are never masked (RFC 6455 section 5.1)
+    header = bytes([0x80 | opcode])
+    if len(payload) < 126:
+        header += bytes([len(payload)])
+    elif len(payload) < 1 << 16:
+        header += bytes([126]) + struct.pack("!H", len(payload))
+    else:
+        header += bytes([127]) + struct.pack("!Q", len(payload))
+    return header + payload
+
+
+def ws_read_frame(rfile):
+    """Read one client frame; returns (opcode, payload), or None once the socket closes."""
+    head = rfile.read(2)
+    if len(head) < 2:
+        return None
+    opcode = head[0] & 0x0F
+    masked = head[1] & 0x80
+    length = head[1] & 0x7F
+    if length == 126:
+        length = struct.unpack("!H", rfile.read(2))[0]
+    elif length == 127:
+        length = struct.unpack("!Q", rfile.read(8))[0]
+    mask = rfile.read(4) if masked else b"\0\0\0\0"
+    payload = bytearray(rfile.read(length))
+    for i in range(len(payload)):
+        payload[i] ^= mask[i % 4]
+    return opcode, bytes(payload)
+
+
+def push_event(event: str, data=None, only=None, teams=None):
+    """Send an event to every subscribed device (or just `only`, or those following any of `teams`),
+    stamped with sentAt in epoch ms."""
+    message = {"event": event, "sentAt": int(time.time() * 1000)}
+    if data is not None:
+        message["data"] = data
+    frame = ws_frame(0x1, json.dumps(message).encode())
+    with push_lock:
+        if only is not None:
+            targets = [only]
+        else:
+            targets = [client for client in push_clients if teams is None or client.teams & set(teams)]
+    for client in targets:
+        try:
+            client.send(frame)
+        except OSError:
+            with push_lock:
+                push_clients.discard(client)
+    return len(targets)
+
+
+def push_score():
+    data = {
+        "fixture": state["fixture_id"],
+        "date": iso(state["match_time"]),
+        "status": api_status(),
+        "home": state["home_goals"],
+        "away": state["away_goals"],
+    }
+    sent = push_event("score", data, teams=[team_id(state["favorite"]), team_id(state["opponent"])])
+    if sent:
+        print(f"Pushed score {data['home']}-{data['away']} ({data['status']}) to {sent} device(s)")
+
+
+class PushHandler(socketserver.StreamRequestHandler):
+    """Minimal RFC 6455 endpoint: handshake, subscribe, ping/pong and close."""
+
+    def send(self, frame: bytes):
+        with self.send_lock:
+            self.wfile.write(frame)
+
+    def handle(self):
+        self.send_lock = threading.Lock()
+        self.teams = set()
+        headers = {}
+        self.rfile.readline()  # GET / HTTP/1.1
+        while True:
+            line = self.rfile.readline().decode("latin-1").strip()
+            if not line:
+                break
+            name, _, value = line.partition(":")
+            headers[name.strip().lower()] = value.strip()
+
+        key = headers.get("sec-websocket-key")
+        if key is None:
+            self.wfile.write(b"HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n")
+            return
+        accept = base64.b64encode(hashlib.sha1((key + WS_GUID).encode()).digest()).decode()
+        self.wfile.write(
+            "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            f"Sec-WebSocket-Accept: {accept}\r\n\r\n".encode()
+        )
+        print(f"Push client connected: {self.client_address[0]}")
+
+        try:
+            while True:
+                frame = ws_read_frame(self.rfile)
+                if frame is None:
+                    break
+                opcode, payload = frame
+                if opcode == 0x8:  # close
+                    self.send(ws_frame(0x8, payload[:2]))
+                    break
+                if opcode == 0x9:  # ping
+                    self.send(ws_frame(0xA, payload))
+                elif opcode == 0x1:
+                    message = json.loads(payload or b"{}")
+                    if message.get("event") == "fixture:subscribe":
+                        self.teams = set((message.get("data") or {}).get("teams", []))
+                        with push_lock:
+                            push_clients.add(self)
+                        # Confirm the channel right away; the device polls at the live rate until then
+                        push_event("heartbeat", only=self)
+        except (OSError, ValueError):
+            pass
+        finally:
+            with push_lock:
+                push_clients.discard(self)
+            print(f"Push client disconnected: {self.client_address[0]}")
+
+
+def heartbeat_loop():
+    while True:
+        time.sleep(HEARTBEAT_INTERVAL)
+        push_event("heartbeat")
+
+
+def start_push_server():
+    server = socketserver.ThreadingTCPServer(("0.0.0.0", PUSH_PORT), PushHandler)
+    server.daemon_threads = True
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    threading.Thread(target=heartbeat_loop, daemon=True).start()
+
+
 @app.get("/")
 def index():
     home = state["favorite"]["name"] if state["home_is_favorite"] else state["opponent"]["name"]
@@ -208,7 +375,26 @@ def index():
 @app.get("/fixtures")
 def fixtures():
     # Mimic API-Football endpoint used by firmware: /fixtures?team=1595&next=1
-    return jsonify(build_fixture_response())
+    today = datetime.now(timezone.utc).date()
+    if quota["day"] != today:
+        quota.update(day=today, used=0)
+    quota["used"] += 1
+
+    response = jsonify(build_fixture_response())
+    response.headers["x-ratelimit-requests-limit"] = str(DAILY_LIMIT)
+    response.headers["x-ratelimit-requests-remaining"] = str(max(0, DAILY_LIMIT - quota["used"]))
+
+    # Lets the firmware exercise conditional requests: an unchanged fixture is a 304
+    response.add_etag()
+    return response.make_conditional(request)
+
+
+@app.get("/status")
+def status():
+    # Like API-Football's, not counted against the quota. The firmware asks for
+    # it before SNTP has synced, just for the response's Date header.
+    return jsonify({"get": "status", "errors": [], "results": 1, "response": {
+        "requests": {"current": quota["used"], "limit_day": DAILY_LIMIT}}})
 
 
 @app.post("/set_state")
@@ -216,6 +402,7 @@ def set_state():
     j = request.get_json(force=True)
     status = j.get("status", "NS")
     state["status"] = status
+    push_score()
     return jsonify({"status": state["status"]})
 
 
@@ -236,6 +423,7 @@ def goal():
         state["home_goals"] += 1
     else:
         state["away_goals"] += 1
+    push_score()
     return jsonify({"home_goals": state["home_goals"], "away_goals": state["away_goals"]})
 
 
@@ -243,6 +431,7 @@ def goal():
 def reset_scores():
     state["home_goals"] = 0
     state["away_goals"] = 0
+    push_score()
     return jsonify({"home_goals": 0, "away_goals": 0})
 @app.post("/set_team")
 def set_team():
@@ -277,5 +466,9 @@ if __name__ == "__main__":
     print("Test server running on http://0.0.0.0:5000 (listening on all interfaces)")
     print("Endpoints:")
     print("  GET  /fixtures        -> API-like response")
+    print("  GET  /status          -> API-like status, not counted against the quota")
     print("  GET  /               -> Control UI")
-    app.run(host="0.0.0.0", port=5000, debug=True)
+    print(f"  WS   :{PUSH_PORT}/          -> Score push channel (heartbeat every {HEARTBEAT_INTERVAL}s)")
+    start_push_server()
+    # The reloader would start a second process fighting over the push port
+    app.run(host="0.0.0.0", port=5000, debug=True, use_reloader=False)
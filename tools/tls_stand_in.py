@@ -0,0 +1,154 @@
+"""TLS stand-in for the test server, to check session resumption on the host.
+
+Terminates TLS 1.2 (the version the firmware speaks) in front of the plain
+test server and logs every handshake as full or resumed, with its time:
+
+    python tls_stand_in.py                  # https://<host>:5443 -> :5000, wss://<host>:5444 -> :5001
+    python tls_stand_in.py --check localhost:5443
+
+--check connects a few times, offering the previous session each time, and
+prints the handshake times with and without resumption. It works against any
+TLS server, so it also tells whether a production endpoint resumes sessions.
+"""
+
+import argparse
+import os
+import socket
+import ssl
+import subprocess
+import tempfile
+import threading
+import time
+
+DEFAULT_LISTEN = ["5443:5000", "5444:5001"]
+
+
+def self_signed_certificate(directory: str):
+    """A throwaway certificate; the firmware does not verify certificates."""
+    cert = os.path.join(directory, "cert.pem")
+    key = os.path.join(directory, "key.pem")
+    subprocess.run(
+        [
+            "openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "1",
+            "-subj", "/CN=tls-stand-in", "-keyout", key, "-out", cert,
+        ],
+        check=True,
+        capture_output=True,
+    )
+    return cert, key
+
+
+def pipe(source: socket.socket, target: socket.socket):
+    try:
+        while data := source.recv(16384):
+            target.sendall(data)
+    except OSError:
+        pass
+    finally:
+        for sock in (source, target):
+            try:
+                sock.shutdown(socket.SHUT_RDWR)
+            except OSError:
+                pass
+
+
+def close_tls(tls: ssl.SSLSocket):
+    """Closes with a close_notify: OpenSSL drops a session from its cache when
+    a connection ends without one, and it could not be resumed by ID."""
+    try:
+        tls.unwrap()
+    except (ssl.SSLError, OSError):
+        pass
+    tls.close()
+
+
+def handle(context: ssl.SSLContext, client: socket.socket, address, upstream_port: int):
+    tls = context.wrap_socket(client, server_side=True, do_handshake_on_connect=False)
+    started = time.perf_counter()
+    try:
+        tls.do_handshake()
+    except (ssl.SSLError, OSError) as error:
+        print(f"{address[0]}: handshake failed: {error}")
+        tls.close()
+        return
+    elapsed = (time.perf_counter() - started) * 1000
+    kind = "resumed" if tls.session_reused else "full"
+    print(f"{address[0]} -> :{upstream_port}: {kind} handshake in {elapsed:.1f}ms ({tls.cipher()[0]})")
+
+    try:
+        upstream = socket.create_connection(("127.0.0.1", upstream_port))
+    except OSError as error:
+        print(f"Upstream :{upstream_port} unavailable: {error}")
+        close_tls(tls)
+        return
+    threading.Thread(target=pipe, args=(upstream, tls), daemon=True).start()
+    pipe(tls, upstream)
+
+
+def serve(context: ssl.SSLContext, listen_port: int, upstream_port: int):
+    server = socket.create_server(("0.0.0.0", listen_port), reuse_port=False)
+    print(f"TLS :{listen_port} -> :{upstream_port}")
+    while True:
+        client, address = server.accept()
+        threading.Thread(target=handle, args=(context, client, address, upstream_port), daemon=True).start()
+
+
+def check(target: str, attempts: int):
+    host, _, port = target.rpartition(":")
+    context = ssl.create_default_context()
+    context.check_hostname = False
+    context.verify_mode = ssl.CERT_NONE
+    context.maximum_version = ssl.TLSVersion.TLSv1_2
+
+    session = None
+    times = {"full": [], "resumed": []}
+    for _ in range(attempts):
+        with socket.create_connection((host, int(port))) as raw:
+            started = time.perf_counter()
+            with context.wrap_socket(raw, server_hostname=host, session=session) as tls:
+                elapsed = (time.perf_counter() - started) * 1000
+                kind = "resumed" if tls.session_reused else "full"
+                times[kind].append(elapsed)
+                print(f"{kind:>7} handshake: {elapsed:.1f}ms")
+                session = tls.session
+
+    for kind, values in times.items():
+        if values:
+            print(f"{kind}: {len(values)}, {sum(values) / len(values):.1f}ms on average")
+    if not times["resumed"]:
+        print("The server never resumed a session")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        "--listen", action="append", metavar="PORT:UPSTREAM",
+        help="TLS port and the local plain port it forwards to (repeatable; default 5443:5000 and 5444:5001)",
+    )
+    parser.add_argument("--cert", help="PEM certificate (default: a fresh self-signed one)")
+    parser.add_argument("--key", help="PEM private key for --cert")
+    parser.add_argument("--no-tickets", action="store_true", help="resume by session ID only")
+    parser.add_argument("--check", metavar="HOST:PORT", help="measure handshakes against a TLS server and exit")
+    parser.add_argument("--attempts", type=int, default=5, help="connections made by --check")
+    args = parser.parse_args()
+
+    if args.check:
+        check(args.check, args.attempts)
+        return
+
+    with tempfile.TemporaryDirectory() as directory:
+        cert, key = (args.cert, args.key) if args.cert else self_signed_certificate(directory)
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.maximum_version = ssl.TLSVersion.TLSv1_2
+        context.load_cert_chain(cert, key)
+        if args.no_tickets:
+            context.options |= ssl.OP_NO_TICKET
+
+        listeners = [tuple(int(port) for port in spec.split(":")) for spec in args.listen or DEFAULT_LISTEN]
+        for listen_port, upstream_port in listeners[1:]:
+            threading.Thread(target=serve, args=(context, listen_port, upstream_port), daemon=True).start()
+        serve(context, *listeners[0])
+
+
+if __name__ == "__main__":
+    main()